@@ -0,0 +1,180 @@
+#ifndef STATICSTRING_BENCH_H
+#define STATICSTRING_BENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Command-line options shared by all benchmark groups
+struct BenchOptions
+{
+    double min_ms = 50.0;            // Minimum measuring time per result
+    std::string filter;              // Only run results whose "group/name" contains this
+    std::string json_path;           // Write all results to this file as JSON when set
+    double cycles_per_ns = 0.0;      // Clock rate used for bytes/cycle; measured when 0
+    uint32_t repetitions = 1;        // Samples per bench_run() result; the median is reported
+    int pin_cpu = -1;                // CPU to pin the process to, or -1 to leave scheduling alone
+};
+
+// One measured result, kept for the JSON report
+struct BenchResult
+{
+    std::string group;
+    std::string name;
+    double ns_per_op;            // Median of samples
+    uint64_t bytes_per_op;       // Bytes processed per operation, 0 when not meaningful
+    std::string note;
+    std::vector<double> samples; // ns/op of each repetition
+};
+
+inline BenchOptions &bench_options()
+{
+    static BenchOptions options;
+    return options;
+}
+
+inline std::vector<BenchResult> &bench_results()
+{
+    static std::vector<BenchResult> results;
+    return results;
+}
+
+// Prevents the compiler from optimizing away a value computed in a benchmark loop
+template <typename T>
+inline void bench_do_not_optimize(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void *sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief Measures the average time of one operation.
+ *
+ * Calls fn() repeatedly until at least min_ms milliseconds have elapsed
+ * (bench_options().min_ms when negative). Each call is assumed to perform
+ * ops_per_call operations.
+ *
+ * @return double Nanoseconds per operation.
+ */
+template <typename Fn>
+inline double bench_measure(Fn fn, uint64_t ops_per_call = 1, double min_ms = -1.0)
+{
+    typedef std::chrono::steady_clock clock;
+    if (min_ms < 0)
+    {
+        min_ms = bench_options().min_ms;
+    }
+    fn(); // warm-up
+
+    // Calls are batched so reading the clock does not dominate short operations
+    uint64_t calls = 0;
+    uint64_t batch = 1;
+    clock::time_point start = clock::now();
+    double elapsed_ns = 0.0;
+    do
+    {
+        for (uint64_t i = 0; i < batch; i++)
+        {
+            fn();
+        }
+        calls += batch;
+        if (batch < (1u << 16))
+        {
+            batch *= 2;
+        }
+        elapsed_ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+    } while (elapsed_ns < min_ms * 1e6);
+
+    return elapsed_ns / (double)(calls * ops_per_call);
+}
+
+// Whether a result passes the --filter option
+inline bool bench_selected(const char *group, const char *name)
+{
+    const std::string &filter = bench_options().filter;
+    return filter.empty() || (std::string(group) + "/" + name).find(filter) != std::string::npos;
+}
+
+// Whether any result of a group can pass the --filter option
+inline bool bench_group_selected(const char *group)
+{
+    const std::string &filter = bench_options().filter;
+    std::string prefix = std::string(group) + "/";
+    return filter.empty() || prefix.find(filter) != std::string::npos || filter.compare(0, prefix.size(), prefix) == 0;
+}
+
+/**
+ * @brief Clock cycles per nanosecond, used to convert ns/op into bytes/cycle.
+ *
+ * Uses --ghz when given; otherwise counts time-stamp counter ticks over a short
+ * interval on x86, which gives the nominal (not turbo) frequency.
+ */
+double bench_cycles_per_ns();
+
+inline double bench_median(std::vector<double> samples)
+{
+    std::sort(samples.begin(), samples.end());
+    size_t middle = samples.size() / 2;
+    return samples.size() % 2 != 0 ? samples[middle] : (samples[middle - 1] + samples[middle]) / 2.0;
+}
+
+// Prints one result row and records it, with all of its samples, for the JSON report
+inline void bench_report_samples(const char *group, const char *name, const std::vector<double> &samples, const char *note,
+                                 uint64_t bytes_per_op = 0)
+{
+    if (!bench_selected(group, name) || samples.empty())
+    {
+        return;
+    }
+    double ns_per_op = bench_median(samples);
+    if (bytes_per_op != 0 && ns_per_op > 0 && bench_cycles_per_ns() > 0)
+    {
+        double bytes_per_cycle = (double)bytes_per_op / (ns_per_op * bench_cycles_per_ns());
+        std::printf("%-10s %-40s %10.3f ns/op %8.2f B/cycle  %s\n", group, name, ns_per_op, bytes_per_cycle, note);
+    }
+    else
+    {
+        std::printf("%-10s %-40s %10.3f ns/op  %s\n", group, name, ns_per_op, note);
+    }
+    BenchResult result = {group, name, ns_per_op, bytes_per_op, note, samples};
+    bench_results().push_back(result);
+}
+
+// Measures fn() --repetitions times and reports the samples, skipping filtered-out results
+template <typename Fn>
+inline void bench_run(const char *group, const char *name, uint64_t bytes_per_op, Fn fn, const char *note = "", uint64_t ops_per_call = 1)
+{
+    if (!bench_selected(group, name))
+    {
+        return;
+    }
+    std::vector<double> samples;
+    for (uint32_t i = 0; i < bench_options().repetitions; i++)
+    {
+        samples.push_back(bench_measure(fn, ops_per_call));
+    }
+    bench_report_samples(group, name, samples, note, bytes_per_op);
+}
+
+// Writes bench_results() to bench_options().json_path; returns false on I/O errors
+bool bench_write_json();
+
+void run_layout_benchmarks();
+void run_kernel_benchmarks();
+void run_compare_benchmarks();
+void run_search_benchmarks();
+void run_hash_benchmarks();
+void run_map_benchmarks();
+void run_matcher_benchmarks();
+void run_split_benchmarks();
+void run_api_benchmarks();
+
+#endif
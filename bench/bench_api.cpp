@@ -0,0 +1,575 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "StaticString.h"
+#include "bench.h"
+
+/*
+ * Times every sstr_* function of the C API across string lengths, next to the
+ * closest std::string, std::string_view and libc equivalents. Results are
+ * named "function/distribution/length". Functions that mutate their input are
+ * paired with their inverse (e.g. append + pop) or reset by a copy, which the
+ * note column states.
+ */
+
+namespace
+{
+    const uint32_t kLengths[] = {0, 1, 7, 15, 31, 64, 127, 255, 4096};
+
+    static_assert(SSTR_MAX_LENGTH >= 4096, "the benchmark target must define SSTR_MAX_LENGTH >= 4096");
+
+    std::string label(const char *function, const char *distribution, uint32_t length)
+    {
+        char buffer[128];
+        snprintf(buffer, sizeof(buffer), "%s/%s/%u", function, distribution, length);
+        return buffer;
+    }
+
+    // Mixed-case letters without whitespace or the searched characters '#' and '!'
+    std::string make_letters(uint32_t length, uint32_t seed)
+    {
+        std::string text(length, 'a');
+        uint32_t state = seed;
+        for (uint32_t i = 0; i < length; i++)
+        {
+            state = state * 1664525u + 1013904223u;
+            uint32_t letter = (state >> 24) % 52;
+            text[i] = (char)(letter < 26 ? 'a' + letter : 'A' + letter - 26);
+        }
+        return text;
+    }
+
+    // Letters with up to 8 spaces on each side
+    std::string make_padded(uint32_t length)
+    {
+        std::string text = make_letters(length, 3);
+        uint32_t pad = length / 4 < 8 ? length / 4 : 8;
+        for (uint32_t i = 0; i < pad; i++)
+        {
+            text[i] = ' ';
+            text[length - 1 - i] = ' ';
+        }
+        return text;
+    }
+
+    // Letters with a quarter of the length in whitespace on each side
+    std::string make_indented(uint32_t length)
+    {
+        std::string text = make_letters(length, 3);
+        for (uint32_t i = 0; i < length / 4; i++)
+        {
+            text[i] = i % 8 == 7 ? '\t' : ' ';
+            text[length - 1 - i] = i % 8 == 7 ? '\n' : ' ';
+        }
+        return text;
+    }
+
+    // Letters with a space every fourth character
+    std::string make_spaced(uint32_t length)
+    {
+        std::string text = make_letters(length, 4);
+        for (uint32_t i = 3; i < length; i += 4)
+        {
+            text[i] = ' ';
+        }
+        return text;
+    }
+
+    // Comma-separated fields of 1 to 8 characters
+    std::string make_fields(uint32_t length)
+    {
+        std::string text = make_letters(length, 5);
+        uint32_t state = 9;
+        for (uint32_t i = 0; i < length;)
+        {
+            state = state * 1664525u + 1013904223u;
+            i += 1 + (state >> 24) % 8;
+            if (i < length)
+            {
+                text[i++] = ',';
+            }
+        }
+        return text;
+    }
+
+    // Lines of 15 letters ending in "\r\n"
+    std::string make_crlf(uint32_t length)
+    {
+        std::string text = make_letters(length, 6);
+        for (uint32_t i = 15; i + 1 < length; i += 17)
+        {
+            text[i] = '\r';
+            text[i + 1] = '\n';
+        }
+        return text;
+    }
+
+    StaticString make_sstr(const std::string &text)
+    {
+        StaticString sstr;
+        sstr_init(&sstr);
+        sstr_from_cstr(&sstr, text.c_str());
+        return sstr;
+    }
+
+    void run_build(uint32_t n, const std::string &text)
+    {
+        StaticString s = make_sstr(text);
+        StaticString t = make_sstr(text);
+        std::string str;
+        std::vector<char> buffer(n + 1);
+        const char *cstr = text.c_str();
+        uint32_t truncated = 0;
+
+        bench_run("api", label("sstr_init", "-", n).c_str(), 0, [&]() { bench_do_not_optimize(sstr_init(&t)); });
+        bench_run("api", label("sstr_clear", "-", n).c_str(), 0, [&]() { bench_do_not_optimize(sstr_clear(&t)); });
+        bench_run("api", label("sstr_secure_wipe", "-", n).c_str(), SSTR_MAX_LENGTH + 1, [&]() { bench_do_not_optimize(sstr_secure_wipe(&t)); });
+        bench_run("api", label("memset", "-", n).c_str(), SSTR_MAX_LENGTH + 1, [&]() {
+            memset(t.static_string, 0, SSTR_MAX_LENGTH + 1);
+            bench_do_not_optimize(t.static_string[0]);
+        });
+
+        bench_run("api", label("sstr_from_cstr", "letters", n).c_str(), n, [&]() { bench_do_not_optimize(sstr_from_cstr(&t, cstr)); });
+        bench_run("api", label("sstr_from_cstr_checked", "letters", n).c_str(), n,
+                  [&]() { bench_do_not_optimize(sstr_from_cstr_checked(&t, cstr, &truncated)); });
+        bench_run("api", label("sstr_from_cstr_lowercase", "letters", n).c_str(), n, [&]() { bench_do_not_optimize(sstr_from_cstr_lowercase(&t, cstr)); });
+        bench_run("api", label("sstr_from_cstr+sstr_to_lowercase", "letters", n).c_str(), n, [&]() {
+            sstr_from_cstr(&t, cstr);
+            bench_do_not_optimize(sstr_to_lowercase(&t));
+        });
+        bench_run("api", label("strlen+memcpy", "letters", n).c_str(), n, [&]() {
+            size_t length = strlen(cstr);
+            memcpy(buffer.data(), cstr, length + 1);
+            bench_do_not_optimize(buffer[0]);
+        });
+        bench_run("api", label("std::string assign", "letters", n).c_str(), n, [&]() {
+            str.assign(cstr);
+            bench_do_not_optimize(str.data());
+        });
+
+        bench_run("api", label("sstr_append_cstr", "letters", n).c_str(), n, [&]() {
+            sstr_truncate(&t, 0);
+            bench_do_not_optimize(sstr_append_cstr(&t, cstr));
+        }, "incl. truncate(0)");
+        bench_run("api", label("sstr_append_cstr_checked", "letters", n).c_str(), n, [&]() {
+            sstr_truncate(&t, 0);
+            bench_do_not_optimize(sstr_append_cstr_checked(&t, cstr, &truncated));
+        }, "incl. truncate(0)");
+        bench_run("api", label("strcat", "letters", n).c_str(), n, [&]() {
+            buffer[0] = '\0';
+            bench_do_not_optimize(strcat(buffer.data(), cstr));
+        }, "incl. reset");
+        bench_run("api", label("std::string append", "letters", n).c_str(), n, [&]() {
+            str.clear();
+            bench_do_not_optimize(str.append(cstr).data());
+        }, "incl. clear()");
+
+        bench_run("api", label("sstr_copy", "letters", n).c_str(), n, [&]() { bench_do_not_optimize(sstr_copy(&t, &s)); });
+        bench_run("api", label("memcpy", "letters", n).c_str(), n, [&]() {
+            memcpy(buffer.data(), s.static_string, n);
+            bench_do_not_optimize(buffer[0]);
+        });
+        std::string source = text;
+        bench_run("api", label("std::string copy", "letters", n).c_str(), n, [&]() {
+            str = source;
+            bench_do_not_optimize(str.data());
+        });
+
+        if (n > 0)
+        {
+            StaticString dest;
+            sstr_init(&dest);
+            StaticStringView view;
+            bench_run("api", label("sstr_substring", "letters", n).c_str(), n,
+                      [&]() { bench_do_not_optimize(sstr_substring(&s, &dest, 0, n - 1)); });
+            bench_run("api", label("sstr_substring_view", "letters", n).c_str(), n,
+                      [&]() { bench_do_not_optimize(sstr_substring_view(&s, 0, n - 1, &view)); });
+            bench_run("api", label("std::string substr", "letters", n).c_str(), n,
+                      [&]() { bench_do_not_optimize(source.substr(0, n).size()); });
+            bench_run("api", label("sstr_from_view", "letters", n).c_str(), n,
+                      [&]() { bench_do_not_optimize(sstr_from_view(&dest, sstr_view(&s))); });
+        }
+    }
+
+    void run_edit(uint32_t n, const std::string &text)
+    {
+        StaticString s = make_sstr(text);
+        StaticString reset = make_sstr(text);
+        std::string str = text;
+
+        if (n < SSTR_MAX_LENGTH)
+        {
+            bench_run("api", label("sstr_append+sstr_pop", "letters", n).c_str(), 0, [&]() {
+                sstr_append(&s, 'x');
+                bench_do_not_optimize(sstr_pop(&s));
+            }, "2 ops", 2);
+            bench_run("api", label("std::string push_back+pop_back", "letters", n).c_str(), 0, [&]() {
+                str.push_back('x');
+                str.pop_back();
+                bench_do_not_optimize(str.data());
+            }, "2 ops", 2);
+            bench_run("api", label("sstr_insert_char_at+sstr_remove_at", "front", n).c_str(), n, [&]() {
+                sstr_insert_char_at(&s, 0, 'x');
+                bench_do_not_optimize(sstr_remove_at(&s, 0));
+            }, "2 ops", 2);
+            bench_run("api", label("std::string insert+erase", "front", n).c_str(), n, [&]() {
+                str.insert(str.begin(), 'x');
+                str.erase(str.begin());
+                bench_do_not_optimize(str.data());
+            }, "2 ops", 2);
+            bench_run("api", label("sstr_insert_char_at+sstr_remove_at", "middle", n).c_str(), n, [&]() {
+                sstr_insert_char_at(&s, n / 2, 'x');
+                bench_do_not_optimize(sstr_remove_at(&s, n / 2));
+            }, "2 ops", 2);
+            StaticStringGapBuffer gap;
+            sstr_gap_init(&gap, &s);
+            sstr_gap_set_cursor(&gap, n / 2);
+            bench_run("api", label("sstr_gap_insert+sstr_gap_backspace", "middle", n).c_str(), 0, [&]() {
+                sstr_gap_insert(&gap, 'x');
+                bench_do_not_optimize(sstr_gap_backspace(&gap));
+            }, "2 ops", 2);
+            bench_run("api", label("sstr_gap_to_cstr", "middle", n).c_str(), n, [&]() {
+                sstr_gap_set_cursor(&gap, n / 2);
+                sstr_gap_insert(&gap, 'x');
+                sstr_gap_backspace(&gap);
+                bench_do_not_optimize(sstr_gap_to_cstr(&gap));
+            }, "incl. reopening the gap");
+        }
+        if (n == 0)
+        {
+            return;
+        }
+
+        bench_run("api", label("sstr_truncate+sstr_append", "letters", n).c_str(), 0, [&]() {
+            char last = s.static_string[n - 1];
+            sstr_truncate(&s, n - 1);
+            bench_do_not_optimize(sstr_append(&s, last));
+        }, "2 ops", 2);
+        bench_run("api", label("sstr_replace_char_from_index", "middle", n).c_str(), 0,
+                  [&]() { bench_do_not_optimize(sstr_replace_char_from_index(&s, n / 2, 'q')); });
+        bench_run("api", label("sstr_replace_all_chars", "letters", n).c_str(), n, [&]() {
+            sstr_replace_all_chars(&s, 'a', '#');
+            bench_do_not_optimize(sstr_replace_all_chars(&s, '#', 'a'));
+        }, "2 ops", 2);
+        bench_run("api", label("sstr_reverse", "letters", n).c_str(), n, [&]() { bench_do_not_optimize(sstr_reverse(&s)); });
+        bench_run("api", label("std::reverse", "letters", n).c_str(), n, [&]() {
+            std::reverse(str.begin(), str.end());
+            bench_do_not_optimize(str.data());
+        });
+        bench_run("api", label("sstr_to_uppercase+sstr_to_lowercase", "letters", n).c_str(), n, [&]() {
+            sstr_to_uppercase(&s);
+            bench_do_not_optimize(sstr_to_lowercase(&s));
+        }, "2 ops", 2);
+        bench_run("api", label("toupper+tolower loop", "letters", n).c_str(), n, [&]() {
+            for (size_t i = 0; i < str.size(); i++)
+            {
+                str[i] = (char)toupper((unsigned char)str[i]);
+            }
+            for (size_t i = 0; i < str.size(); i++)
+            {
+                str[i] = (char)tolower((unsigned char)str[i]);
+            }
+            bench_do_not_optimize(str.data());
+        }, "2 ops", 2);
+        bench_run("api", label("sstr_remove_range", "front-half", n).c_str(), n, [&]() {
+            sstr_copy(&s, &reset);
+            bench_do_not_optimize(sstr_remove_range(&s, 0, n / 2));
+        }, "incl. sstr_copy reset");
+        if (n + 8 <= SSTR_MAX_LENGTH)
+        {
+            bench_run("api", label("sstr_insert_cstr+sstr_remove_range", "front", n).c_str(), n, [&]() {
+                sstr_insert_cstr(&s, 0, "12345678");
+                bench_do_not_optimize(sstr_remove_range(&s, 0, 7));
+            }, "2 ops, 8 chars", 2);
+            bench_run("api", label("8x sstr_insert_char_at+sstr_remove_range", "front", n).c_str(), n, [&]() {
+                for (uint32_t i = 0; i < 8; i++)
+                {
+                    sstr_insert_char_at(&s, i, (char)('1' + i));
+                }
+                bench_do_not_optimize(sstr_remove_range(&s, 0, 7));
+            }, "9 ops, 8 chars", 9);
+            bench_run("api", label("std::string insert+erase", "front-8", n).c_str(), n, [&]() {
+                str.insert(0, "12345678");
+                str.erase(0, 8);
+                bench_do_not_optimize(str.data());
+            }, "2 ops, 8 chars", 2);
+            bench_run("api", label("sstr_replace_range_cstr", "grow+shrink", n).c_str(), n, [&]() {
+                sstr_replace_range_cstr(&s, 0, 0, "12345678");
+                bench_do_not_optimize(sstr_replace_range_cstr(&s, 0, 7, "a"));
+            }, "2 ops", 2);
+        }
+        if (n >= 255)
+        {
+            // Redact 16 evenly spaced 8-character fields as "***"
+            const uint32_t edits = 16;
+            uint32_t stride = n / edits;
+            StaticStringEdit storage[edits];
+            StaticStringEditScript script;
+            sstr_edit_script_init(&script, storage, edits);
+            for (uint32_t i = 0; i < edits; i++)
+            {
+                sstr_edit_script_replace_cstr(&script, i * stride, 8, "***");
+            }
+            bench_run("api", label("sstr_apply_edits", "16-redactions", n).c_str(), n, [&]() {
+                sstr_copy(&s, &reset);
+                bench_do_not_optimize(sstr_apply_edits(&s, &script));
+            }, "incl. sstr_copy reset");
+            bench_run("api", label("16x sstr_replace_range_cstr", "16-redactions", n).c_str(), n, [&]() {
+                sstr_copy(&s, &reset);
+                for (uint32_t i = edits; i > 0; i--)
+                {
+                    sstr_replace_range_cstr(&s, (i - 1) * stride, (i - 1) * stride + 7, "***");
+                }
+                bench_do_not_optimize(s.string_length);
+            }, "incl. sstr_copy reset");
+            sstr_copy(&s, &reset);
+        }
+
+        StaticString padded = make_sstr(make_padded(n));
+        StaticString spaced = make_sstr(make_spaced(n));
+        const struct
+        {
+            const char *name;
+            uint32_t (*fn)(StaticString *);
+        } trims[] = {
+            {"sstr_trim_leading", sstr_trim_leading},
+            {"sstr_trim_trailing", sstr_trim_trailing},
+            {"sstr_trim", sstr_trim},
+            {"sstr_strip_all_whitespace", sstr_strip_all_whitespace},
+        };
+        for (size_t i = 0; i < sizeof(trims) / sizeof(trims[0]); i++)
+        {
+            uint32_t (*fn)(StaticString *) = trims[i].fn;
+            const StaticString &input = fn == sstr_strip_all_whitespace ? spaced : padded;
+            bench_run("api", label(trims[i].name, "none", n).c_str(), n, [&]() { bench_do_not_optimize(fn(&s)); });
+            bench_run("api", label(trims[i].name, fn == sstr_strip_all_whitespace ? "spaced" : "padded", n).c_str(), n, [&]() {
+                sstr_copy(&s, &input);
+                bench_do_not_optimize(fn(&s));
+            }, "incl. sstr_copy reset");
+        }
+
+        StaticString indented = make_sstr(make_indented(n));
+        bench_run("api", label("sstr_trim", "indented", n).c_str(), n, [&]() {
+            sstr_copy(&s, &indented);
+            bench_do_not_optimize(sstr_trim(&s));
+        }, "incl. sstr_copy reset");
+        bench_run("api", label("sstr_trimmed_view", "padded", n).c_str(), n, [&]() { bench_do_not_optimize(sstr_trimmed_view(&padded).length); });
+        bench_run("api", label("sstr_trimmed_view", "indented", n).c_str(), n, [&]() { bench_do_not_optimize(sstr_trimmed_view(&indented).length); });
+
+        StaticString fields = make_sstr(make_fields(n));
+        StaticStringCharClass separators = sstr_char_class_make(",;");
+        bench_run("api", label("sstr_strip_class", "fields", n).c_str(), n, [&]() {
+            sstr_copy(&s, &fields);
+            bench_do_not_optimize(sstr_strip_class(&s, &separators));
+        }, "incl. sstr_copy reset");
+        bench_run("api", label("sstr_strip_chars", "fields", n).c_str(), n, [&]() {
+            sstr_copy(&s, &fields);
+            bench_do_not_optimize(sstr_strip_chars(&s, ",;"));
+        }, "incl. sstr_copy reset");
+
+        // Sanitizer chain: separators to spaces, then uppercase
+        StaticStringTranslation sanitize;
+        sstr_translation_init(&sanitize);
+        sstr_translation_map(&sanitize, ",;|", " ");
+        sstr_translation_uppercase(&sanitize);
+        bench_run("api", label("sstr_translate", "fields-sanitize", n).c_str(), n, [&]() {
+            sstr_copy(&s, &fields);
+            bench_do_not_optimize(sstr_translate(&s, &sanitize));
+        }, "incl. sstr_copy reset");
+        bench_run("api", label("3x sstr_replace_all_chars+sstr_to_uppercase", "fields-sanitize", n).c_str(), n, [&]() {
+            sstr_copy(&s, &fields);
+            sstr_replace_all_chars(&s, ',', ' ');
+            sstr_replace_all_chars(&s, ';', ' ');
+            sstr_replace_all_chars(&s, '|', ' ');
+            bench_do_not_optimize(sstr_to_uppercase(&s));
+        }, "incl. sstr_copy reset");
+
+        StaticString crlf = make_sstr(make_crlf(n));
+        std::string crlf_str = make_crlf(n);
+        bench_run("api", label("sstr_replace_all_cstr", "crlf-to-lf", n).c_str(), n, [&]() {
+            sstr_copy(&s, &crlf);
+            bench_do_not_optimize(sstr_replace_all_cstr(&s, "\r\n", "\n"));
+        }, "incl. sstr_copy reset");
+        bench_run("api", label("std::string find+replace loop", "crlf-to-lf", n).c_str(), n, [&]() {
+            str = crlf_str;
+            for (size_t at = str.find("\r\n"); at != std::string::npos; at = str.find("\r\n", at + 1))
+            {
+                str.replace(at, 2, "\n");
+            }
+            bench_do_not_optimize(str.data());
+        }, "incl. assignment reset");
+        bench_run("api", label("sstr_replace_all_copy", "crlf-to-lf", n).c_str(), n,
+                  [&]() { bench_do_not_optimize(sstr_replace_all_copy(&s, &crlf, "\r\n", "\n", NULL)); });
+        bench_run("api", label("sstr_replace_all_cstr", "crlf-to-crlf", n).c_str(), n, [&]() {
+            bench_do_not_optimize(sstr_replace_all_cstr(&crlf, "\r\n", "\r\n"));
+        }, "same length, no reset");
+        if (n + n / 8 <= SSTR_MAX_LENGTH)
+        {
+            StaticString lf = crlf;
+            sstr_replace_all_cstr(&lf, "\r\n", "\n");
+            bench_run("api", label("sstr_replace_all_cstr", "lf-to-crlf", n).c_str(), n, [&]() {
+                sstr_copy(&s, &lf);
+                bench_do_not_optimize(sstr_replace_all_cstr(&s, "\n", "\r\n"));
+            }, "incl. sstr_copy reset");
+        }
+        sstr_copy(&s, &reset);
+    }
+
+    void run_read(uint32_t n, const std::string &text)
+    {
+        StaticString a = make_sstr(text);
+        StaticString b = make_sstr(text);
+        StaticString c = make_sstr(text);
+        if (n > 0)
+        {
+            sstr_replace_char_from_index(&c, n - 1, '#');
+        }
+        std::string sa = text, sb = text, sc(c.static_string, n);
+        std::string_view va(sa), vb(sb);
+        const char *cstr = b.static_string;
+
+        bench_run("api", label("sstr_equals", "equal", n).c_str(), n, [&]() { bench_do_not_optimize(sstr_equals(&a, &b)); });
+        bench_run("api", label("sstr_equals", "last-differs", n).c_str(), n, [&]() { bench_do_not_optimize(sstr_equals(&a, &c)); });
+        bench_run("api", label("memcmp", "equal", n).c_str(), n,
+                  [&]() { bench_do_not_optimize(memcmp(a.static_string, b.static_string, n)); });
+        bench_run("api", label("std::string ==", "equal", n).c_str(), n, [&]() { bench_do_not_optimize(sa == sb); });
+        bench_run("api", label("std::string_view ==", "equal", n).c_str(), n, [&]() { bench_do_not_optimize(va == vb); });
+        bench_run("api", label("sstr_equals_cstr", "equal", n).c_str(), n, [&]() { bench_do_not_optimize(sstr_equals_cstr(&a, cstr)); });
+        bench_run("api", label("strcmp", "equal", n).c_str(), n, [&]() { bench_do_not_optimize(strcmp(a.static_string, cstr)); });
+        bench_run("api", label("sstr_compare", "last-differs", n).c_str(), n, [&]() { bench_do_not_optimize(sstr_compare(&a, &c)); });
+        bench_run("api", label("std::string compare", "last-differs", n).c_str(), n,
+                  [&]() { bench_do_not_optimize(sa.compare(sc)); });
+
+        bench_run("api", label("sstr_length", "-", n).c_str(), 0, [&]() { bench_do_not_optimize(sstr_length(&a)); });
+        bench_run("api", label("sstr_to_cstr", "-", n).c_str(), 0, [&]() { bench_do_not_optimize(sstr_to_cstr(&a)); });
+        bench_run("api", label("sstr_hash", "letters", n).c_str(), n, [&]() { bench_do_not_optimize(sstr_hash(&a)); });
+        bench_run("api", label("sstr_view_hash", "letters", n).c_str(), n,
+                  [&]() { bench_do_not_optimize(sstr_view_hash(sstr_view(&a))); });
+        bench_run("api", label("std::hash<string_view>", "letters", n).c_str(), n,
+                  [&]() { bench_do_not_optimize(std::hash<std::string_view>()(va)); });
+
+        // Character search: the character is absent, so the whole string is scanned
+        bench_run("api", label("sstr_contains", "absent", n).c_str(), n, [&]() { bench_do_not_optimize(sstr_contains(&a, '#')); });
+        bench_run("api", label("sstr_first_index_of", "absent", n).c_str(), n,
+                  [&]() { bench_do_not_optimize(sstr_first_index_of(&a, '#')); });
+        bench_run("api", label("memchr", "absent", n).c_str(), n, [&]() { bench_do_not_optimize(memchr(a.static_string, '#', n)); });
+        bench_run("api", label("std::string find(char)", "absent", n).c_str(), n, [&]() { bench_do_not_optimize(sa.find('#')); });
+
+        // Character-set search: none of the delimiters occurs, and every character is a letter
+        StaticStringCharClass delimiters = sstr_char_class_make(",;|\t:/");
+        StaticStringCharClass letters;
+        sstr_char_class_init(&letters, NULL);
+        sstr_char_class_add_range(&letters, 'a', 'z');
+        sstr_char_class_add_range(&letters, 'A', 'Z');
+        bench_run("api", label("sstr_find_first_of", "absent", n).c_str(), n,
+                  [&]() { bench_do_not_optimize(sstr_find_first_of(&a, &delimiters)); });
+        bench_run("api", label("strcspn", "absent", n).c_str(), n, [&]() { bench_do_not_optimize(strcspn(a.static_string, ",;|\t:/")); });
+        bench_run("api", label("std::string find_first_of", "absent", n).c_str(), n,
+                  [&]() { bench_do_not_optimize(sa.find_first_of(",;|\t:/")); });
+        bench_run("api", label("sstr_span", "letters", n).c_str(), n, [&]() { bench_do_not_optimize(sstr_span(&a, &letters)); });
+        bench_run("api", label("std::string find_first_not_of", "letters", n).c_str(), n,
+                  [&]() { bench_do_not_optimize(sa.find_first_not_of("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ")); });
+        if (n > 0)
+        {
+            // Only character 0 matches, so the reverse scan covers the whole string
+            StaticString d = a;
+            sstr_replace_char_from_index(&d, 0, '#');
+            std::string sd(d.static_string, n);
+            bench_run("api", label("sstr_last_index_of", "first-only", n).c_str(), n,
+                      [&]() { bench_do_not_optimize(sstr_last_index_of(&d, '#')); });
+            bench_run("api", label("std::string rfind(char)", "first-only", n).c_str(), n, [&]() { bench_do_not_optimize(sd.rfind('#')); });
+
+            // Every 16th character matches; each call resumes after the previous hit
+            StaticString e = a;
+            for (uint32_t i = 0; i < n; i += 16)
+            {
+                sstr_replace_char_from_index(&e, i, '#');
+            }
+            bench_run("api", label("sstr_index_of_from", "every-16th", n).c_str(), n, [&]() {
+                uint32_t count = 0;
+                int32_t pos = -1;
+                while ((pos = sstr_index_of_from(&e, '#', (uint32_t)(pos + 1))) >= 0)
+                {
+                    count++;
+                }
+                bench_do_not_optimize(count);
+            });
+        }
+
+        // Substring search with an absent needle
+        StaticString needle = make_sstr("xyz!");
+        std::string sneedle = "xyz!";
+        uint32_t positions[16];
+        bench_run("api", label("sstr_find", "absent", n).c_str(), n, [&]() { bench_do_not_optimize(sstr_find(&a, &needle)); });
+        bench_run("api", label("sstr_find_cstr", "absent", n).c_str(), n, [&]() { bench_do_not_optimize(sstr_find_cstr(&a, "xyz!")); });
+        bench_run("api", label("sstr_rfind", "absent", n).c_str(), n, [&]() { bench_do_not_optimize(sstr_rfind(&a, &needle)); });
+        bench_run("api", label("sstr_rfind_cstr", "absent", n).c_str(), n, [&]() { bench_do_not_optimize(sstr_rfind_cstr(&a, "xyz!")); });
+        bench_run("api", label("sstr_find_all", "absent", n).c_str(), n,
+                  [&]() { bench_do_not_optimize(sstr_find_all(&a, &needle, positions, 16)); });
+        bench_run("api", label("sstr_find_all_cstr", "absent", n).c_str(), n,
+                  [&]() { bench_do_not_optimize(sstr_find_all_cstr(&a, "xyz!", positions, 16)); });
+        bench_run("api", label("strstr", "absent", n).c_str(), n, [&]() { bench_do_not_optimize(strstr(a.static_string, "xyz!")); });
+        bench_run("api", label("std::string find", "absent", n).c_str(), n, [&]() { bench_do_not_optimize(sa.find(sneedle)); });
+        bench_run("api", label("std::string_view find", "absent", n).c_str(), n,
+                  [&]() { bench_do_not_optimize(va.find(std::string_view(sneedle))); });
+
+        StaticString fields = make_sstr(make_fields(n));
+        bench_run("api", label("sstr_split_next", "fields", n).c_str(), n, [&]() {
+            StaticStringSplit split;
+            StaticStringView token;
+            uint32_t count = 0;
+            sstr_split_init(&split, sstr_view(&fields), ',');
+            while (sstr_split_next(&split, &token))
+            {
+                count++;
+            }
+            bench_do_not_optimize(count);
+        });
+    }
+
+    // The same operations on BasicStaticString of different capacities
+    template <uint32_t N>
+    void run_capacity(uint32_t n, const std::string &text)
+    {
+        if (n > N)
+        {
+            return;
+        }
+        typedef BasicStaticString<N> S;
+        S a(text.c_str()), b(text.c_str()), t;
+        const char *cstr = text.c_str();
+        char function[64];
+
+        snprintf(function, sizeof(function), "BasicStaticString<%u> from_cstr", N);
+        bench_run("api", label(function, "letters", n).c_str(), n, [&]() { bench_do_not_optimize(t.from_cstr(cstr)); });
+        snprintf(function, sizeof(function), "BasicStaticString<%u> copy", N);
+        bench_run("api", label(function, "letters", n).c_str(), n, [&]() { bench_do_not_optimize(t.copy(a)); });
+        snprintf(function, sizeof(function), "BasicStaticString<%u> equals", N);
+        bench_run("api", label(function, "equal", n).c_str(), n, [&]() { bench_do_not_optimize(a.equals(b)); });
+        snprintf(function, sizeof(function), "BasicStaticString<%u> clear", N);
+        bench_run("api", label(function, "-", n).c_str(), 0, [&]() { bench_do_not_optimize(t.clear()); });
+        snprintf(function, sizeof(function), "BasicStaticString<%u> secure_wipe", N);
+        bench_run("api", label(function, "-", n).c_str(), N + 1, [&]() { bench_do_not_optimize(t.secure_wipe()); });
+    }
+}
+
+void run_api_benchmarks()
+{
+    for (size_t i = 0; i < sizeof(kLengths) / sizeof(kLengths[0]); i++)
+    {
+        uint32_t n = kLengths[i];
+        std::string text = make_letters(n, 1);
+        run_build(n, text);
+        run_edit(n, text);
+        run_read(n, text);
+        run_capacity<16>(n, text);
+        run_capacity<256>(n, text);
+        run_capacity<4096>(n, text);
+    }
+}
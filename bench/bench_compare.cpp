@@ -0,0 +1,70 @@
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+#include "StaticString.h"
+#include "bench.h"
+
+namespace
+{
+    const uint32_t kSizes[] = {8, 16, 64, 256, 1024};
+    const uint32_t kCapacity = 1024;
+
+    void run_size(uint32_t size)
+    {
+        // Equal strings force a full scan; the ordering case differs only in the last character
+        std::string text(size, 'x');
+        for (uint32_t i = 0; i < size; i++)
+        {
+            text[i] = (char)('a' + i % 26);
+        }
+        std::string greater = text;
+        greater[size - 1]++;
+        std::string upper = text;
+        for (uint32_t i = 0; i < size; i++)
+        {
+            upper[i] = (char)(upper[i] - 'a' + 'A');
+        }
+
+        BasicStaticString<kCapacity> a(text.c_str()), b(text.c_str()), c(greater.c_str()), u(upper.c_str()), scratch;
+        std::string sa = text, sb = text, sc = greater;
+        std::string_view va(sa), vb(sb), vc(sc);
+        char name[64];
+
+        snprintf(name, sizeof(name), "sstr equals/%u", size);
+        bench_run("compare", name, 0, [&]() { bench_do_not_optimize(a.equals(b)); });
+        snprintf(name, sizeof(name), "std::string ==/%u", size);
+        bench_run("compare", name, 0, [&]() { bench_do_not_optimize(sa == sb); });
+        snprintf(name, sizeof(name), "std::string_view ==/%u", size);
+        bench_run("compare", name, 0, [&]() { bench_do_not_optimize(va == vb); });
+
+        // Case-insensitive: every byte differs in case from the other string
+        snprintf(name, sizeof(name), "sstr iequals/%u", size);
+        bench_run("compare", name, 0, [&]() { bench_do_not_optimize(a.iequals(u)); });
+        snprintf(name, sizeof(name), "sstr iequals same case/%u", size);
+        bench_run("compare", name, 0, [&]() { bench_do_not_optimize(a.iequals(b)); });
+        snprintf(name, sizeof(name), "sstr copy+to_lowercase+equals/%u", size);
+        bench_run("compare", name, 0, [&]() {
+            scratch.copy(u);
+            scratch.to_lowercase();
+            bench_do_not_optimize(a.equals(scratch));
+        });
+
+        snprintf(name, sizeof(name), "sstr compare/%u", size);
+        bench_run("compare", name, 0, [&]() { bench_do_not_optimize(a.compare(c)); });
+        snprintf(name, sizeof(name), "sstr icompare/%u", size);
+        bench_run("compare", name, 0, [&]() { bench_do_not_optimize(u.icompare(c)); });
+        snprintf(name, sizeof(name), "std::string compare/%u", size);
+        bench_run("compare", name, 0, [&]() { bench_do_not_optimize(sa.compare(sc)); });
+        snprintf(name, sizeof(name), "std::string_view compare/%u", size);
+        bench_run("compare", name, 0, [&]() { bench_do_not_optimize(va.compare(vc)); });
+    }
+}
+
+void run_compare_benchmarks()
+{
+    for (size_t s = 0; s < sizeof(kSizes) / sizeof(kSizes[0]); s++)
+    {
+        run_size(kSizes[s]);
+    }
+}
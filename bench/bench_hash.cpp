@@ -0,0 +1,67 @@
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include "StaticString.h"
+#include "bench.h"
+
+namespace
+{
+    const uint32_t kSizes[] = {8, 16, 64, 256, 1024};
+    const uint32_t kCapacity = 1024;
+
+    typedef BasicStaticString<kCapacity> PlainString;
+    typedef BasicStaticString<kCapacity, uint16_t, SSTR_LAYOUT_HEADER_FIRST, true> HashedString;
+
+    void run_size(uint32_t size)
+    {
+        std::string text(size, 'x');
+        for (uint32_t i = 0; i < size; i++)
+        {
+            text[i] = (char)('a' + i % 26);
+        }
+        // Same length, different last character: a full scan is needed unless the hashes differ
+        std::string other = text;
+        other[size - 1]++;
+
+        PlainString plain(text.c_str()), plain_other(other.c_str());
+        HashedString hashed(text.c_str()), hashed_other(other.c_str());
+        std::string_view view(text);
+        char name[64];
+
+        snprintf(name, sizeof(name), "sstr hash/%u", size);
+        bench_run("hash", name, 0, [&]() { bench_do_not_optimize(plain.hash()); }, "computed");
+        snprintf(name, sizeof(name), "sstr cached hash/%u", size);
+        bench_run("hash", name, 0, [&]() { bench_do_not_optimize(hashed.hash()); }, "O(1)");
+        snprintf(name, sizeof(name), "sstr ihash/%u", size);
+        bench_run("hash", name, 0, [&]() { bench_do_not_optimize(plain.ihash()); }, "computed");
+        snprintf(name, sizeof(name), "std::hash<string_view>/%u", size);
+        bench_run("hash", name, 0, [&]() { bench_do_not_optimize(std::hash<std::string_view>()(view)); });
+
+        snprintf(name, sizeof(name), "sstr unequal/%u", size);
+        bench_run("hash", name, 0, [&]() { bench_do_not_optimize(plain.equals(plain_other)); });
+        snprintf(name, sizeof(name), "sstr cached unequal/%u", size);
+        bench_run("hash", name, 0, [&]() { bench_do_not_optimize(hashed.equals(hashed_other)); }, "hash reject");
+
+        // Maintenance cost on the hot mutators
+        snprintf(name, sizeof(name), "sstr append+pop/%u", size);
+        bench_run("hash", name, 0, [&]() {
+            plain.append('!');
+            bench_do_not_optimize(plain.pop());
+        });
+        snprintf(name, sizeof(name), "sstr cached append+pop/%u", size);
+        bench_run("hash", name, 0, [&]() {
+            hashed.append('!');
+            bench_do_not_optimize(hashed.pop());
+        });
+    }
+}
+
+void run_hash_benchmarks()
+{
+    for (size_t s = 0; s < sizeof(kSizes) / sizeof(kSizes[0]); s++)
+    {
+        run_size(kSizes[s]);
+    }
+}
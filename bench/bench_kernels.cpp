@@ -0,0 +1,95 @@
+#include <cstdio>
+#include <vector>
+
+#include "StaticString.h"
+#include "bench.h"
+
+namespace
+{
+    const char *kLevelNames[] = {"scalar", "sse2", "avx2", "avx512bw"};
+    const uint32_t kSizes[] = {16, 64, 256, 4096};
+
+    void run_level(int level)
+    {
+        const SStrKernels *kernels = sstr_kernels_for_level(level);
+        if (kernels->level != level)
+        {
+            return; // Not compiled into this build
+        }
+        const StaticStringCharClass delimiters = sstr_char_class_make(",;|\t:/"); // Absent from the test strings
+        StaticStringTranslation uppercase; // Changes 2 of the 16 table rows
+        sstr_translation_init(&uppercase);
+        sstr_translation_uppercase(&uppercase);
+        StaticStringTranslation rotate; // Changes every row
+        for (uint32_t c = 0; c < 256; c++)
+        {
+            rotate.map[c] = (uint8_t)(c + 1);
+        }
+        sstr_translation_update_rows(&rotate);
+#if SSTR_HAS_X86_KERNELS
+        const char *translate_note = kernels->translate == sstr_kernel_translate_avx512vbmi ? "avx512vbmi" : "";
+#else
+        const char *translate_note = "";
+#endif
+
+        for (size_t s = 0; s < sizeof(kSizes) / sizeof(kSizes[0]); s++)
+        {
+            uint32_t size = kSizes[s];
+            std::vector<char> a(size), b(size), c(size), cstr(size + 1), dest(size + 1);
+            for (uint32_t i = 0; i < size; i++)
+            {
+                a[i] = (char)('a' + i % 26);
+            }
+            b = a;
+            for (uint32_t i = 0; i < size; i++)
+            {
+                cstr[i] = a[i];
+            }
+            cstr[size] = '\0';
+            char name[64];
+
+            snprintf(name, sizeof(name), "%s equals/%u", kLevelNames[level], size);
+            bench_run("kernels", name, 0, [&]() { bench_do_not_optimize(kernels->equals(a.data(), b.data(), size)); });
+
+            snprintf(name, sizeof(name), "%s count_char/%u", kLevelNames[level], size);
+            bench_run("kernels", name, 0, [&]() { bench_do_not_optimize(kernels->count_char(a.data(), size, 'q')); });
+
+            snprintf(name, sizeof(name), "%s find_char/%u", kLevelNames[level], size);
+            bench_run("kernels", name, 0, [&]() { bench_do_not_optimize(kernels->find_char(a.data(), size, '#')); });
+
+            snprintf(name, sizeof(name), "%s find_char_reverse/%u", kLevelNames[level], size);
+            bench_run("kernels", name, 0, [&]() { bench_do_not_optimize(kernels->find_char_reverse(a.data(), size, '#')); });
+
+            snprintf(name, sizeof(name), "%s find_class/%u", kLevelNames[level], size);
+            bench_run("kernels", name, 0, [&]() { bench_do_not_optimize(kernels->find_class(a.data(), size, &delimiters)); });
+
+            snprintf(name, sizeof(name), "%s copy_cstr/%u", kLevelNames[level], size);
+            bench_run("kernels", name, 0, [&]() { bench_do_not_optimize(kernels->copy_cstr(dest.data(), cstr.data(), size)); });
+
+            snprintf(name, sizeof(name), "%s copy_cstr_flip_case/%u", kLevelNames[level], size);
+            bench_run("kernels", name, 0, [&]() { bench_do_not_optimize(kernels->copy_cstr_flip_case(dest.data(), cstr.data(), size, 'A')); });
+
+            c = a;
+            snprintf(name, sizeof(name), "%s translate uppercase/%u", kLevelNames[level], size);
+            bench_run("kernels", name, 0, [&]() { bench_do_not_optimize(kernels->translate(c.data(), size, &uppercase)); }, translate_note);
+
+            snprintf(name, sizeof(name), "%s translate all rows/%u", kLevelNames[level], size);
+            bench_run("kernels", name, 0, [&]() { bench_do_not_optimize(kernels->translate(c.data(), size, &rotate)); }, translate_note);
+
+            snprintf(name, sizeof(name), "%s flip_case/%u", kLevelNames[level], size);
+            bench_run("kernels", name, 0, [&]() {
+                c = a;
+                bench_do_not_optimize(kernels->flip_case(c.data(), size, 'a'));
+            });
+        }
+    }
+}
+
+void run_kernel_benchmarks()
+{
+    std::printf("active SIMD level: %s\n", kLevelNames[sstr_kernels()->level]);
+    for (int level = SSTR_SIMD_SCALAR; level <= SSTR_SIMD_AVX512BW; level++)
+    {
+        run_level(level);
+    }
+}
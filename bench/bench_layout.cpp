@@ -0,0 +1,116 @@
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "StaticString.h"
+#include "bench.h"
+
+namespace
+{
+    const uint32_t kCapacity = 120;  // Typical log-line capacity
+    const size_t kCount = 1 << 16;   // ~8 MB of strings, larger than L2
+    const uintptr_t kCacheLine = 64;
+
+    // Address of the length information for each layout
+    template <typename S>
+    const char *length_address(const S &sstr)
+    {
+        switch (S::layout)
+        {
+        case SSTR_LAYOUT_HEADER_FIRST:
+            return (const char *)&sstr;
+        case SSTR_LAYOUT_TRAILING:
+            return sstr.data() + kCapacity + 1;
+        default:
+            return sstr.data() + kCapacity;
+        }
+    }
+
+    // Number of cache lines covering the length and the characters [0, length]
+    template <typename S>
+    double average_lines_touched(const std::vector<S> &strings)
+    {
+        uint64_t total = 0;
+        for (size_t i = 0; i < strings.size(); i++)
+        {
+            std::set<uintptr_t> lines;
+            lines.insert((uintptr_t)length_address(strings[i]) / kCacheLine);
+            for (uint32_t j = 0; j <= strings[i].length(); j++)
+            {
+                lines.insert((uintptr_t)(strings[i].data() + j) / kCacheLine);
+            }
+            total += lines.size();
+        }
+        return (double)total / (double)strings.size();
+    }
+
+    template <int Layout>
+    void run_layout(const char *name, const std::vector<size_t> &order)
+    {
+        typedef BasicStaticString<kCapacity, uint8_t, Layout> S;
+        std::vector<S> a(kCount), b(kCount);
+        srand(42);
+        for (size_t i = 0; i < kCount; i++)
+        {
+            uint32_t length = 4 + (uint32_t)(rand() % 13);
+            for (uint32_t j = 0; j < length; j++)
+            {
+                a[i].append((char)('a' + rand() % 26));
+            }
+            b[i].copy(a[i]);
+        }
+
+        char note[64];
+        snprintf(note, sizeof(note), "sizeof=%u lines/op=%.2f", (unsigned)sizeof(S), average_lines_touched(a));
+
+        bench_run("layout", (std::string(name) + " length").c_str(), 0, [&]() {
+            uint64_t sum = 0;
+            for (size_t i = 0; i < kCount; i++)
+            {
+                sum += a[order[i]].length();
+            }
+            bench_do_not_optimize(sum);
+        }, note, kCount);
+
+        bench_run("layout", (std::string(name) + " equals").c_str(), 0, [&]() {
+            uint32_t equal = 0;
+            for (size_t i = 0; i < kCount; i++)
+            {
+                equal += a[order[i]].equals(b[order[i]]);
+            }
+            bench_do_not_optimize(equal);
+        }, note, kCount);
+
+        bench_run("layout", (std::string(name) + " append+pop").c_str(), 0, [&]() {
+            for (size_t i = 0; i < kCount; i++)
+            {
+                a[order[i]].append('x');
+                a[order[i]].pop();
+            }
+            bench_do_not_optimize(a[0]);
+        }, note, kCount);
+    }
+}
+
+void run_layout_benchmarks()
+{
+    // Random visiting order defeats the hardware prefetcher so every cache line counts
+    std::vector<size_t> order(kCount);
+    for (size_t i = 0; i < kCount; i++)
+    {
+        order[i] = i;
+    }
+    srand(7);
+    for (size_t i = kCount - 1; i > 0; i--)
+    {
+        size_t j = (size_t)rand() % (i + 1);
+        size_t tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+
+    run_layout<SSTR_LAYOUT_TRAILING>("trailing", order);
+    run_layout<SSTR_LAYOUT_HEADER_FIRST>("header-first", order);
+    run_layout<SSTR_LAYOUT_COMPACT>("compact", order);
+}
@@ -0,0 +1,98 @@
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "StaticStringMap.h"
+#include "bench.h"
+
+namespace
+{
+    const uint32_t kKeyCounts[] = {1000, 100000};
+
+    // Ticker/topic-like keys of 3 to 24 characters
+    std::vector<std::string> make_keys(uint32_t count, uint32_t seed)
+    {
+        std::vector<std::string> keys;
+        keys.reserve(count);
+        uint32_t state = seed;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            state = state * 1664525u + 1013904223u;
+            uint32_t length = 3 + (state >> 24) % 22;
+            std::string key = "t";
+            key += std::to_string(i);
+            while (key.size() < length)
+            {
+                state = state * 1664525u + 1013904223u;
+                key += (char)('a' + (state >> 27));
+            }
+            keys.push_back(key);
+        }
+        return keys;
+    }
+
+    void run_count(uint32_t count)
+    {
+        std::vector<std::string> keys = make_keys(count, 1);
+        std::vector<std::string> missing = make_keys(count, 2);
+        for (size_t i = 0; i < missing.size(); i++)
+        {
+            missing[i][0] = 'm'; // Never inserted
+        }
+
+        StaticStringMap<uint32_t, 31> map(count);
+        std::unordered_map<std::string, uint32_t> std_map;
+        std_map.reserve(count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            map.insert(keys[i].data(), (uint32_t)keys[i].size(), i);
+            std_map.emplace(keys[i], i);
+        }
+
+        char name[64];
+        size_t next = 0;
+
+        snprintf(name, sizeof(name), "StaticStringMap hit/%u", count);
+        bench_run("map", name, 0, [&]() {
+            const std::string &key = keys[next++ % count];
+            bench_do_not_optimize(map.find(key.data(), (uint32_t)key.size()));
+        });
+        snprintf(name, sizeof(name), "unordered_map<string> hit/%u", count);
+        bench_run("map", name, 0, [&]() {
+            bench_do_not_optimize(std_map.find(keys[next++ % count]));
+        });
+
+        snprintf(name, sizeof(name), "StaticStringMap miss/%u", count);
+        bench_run("map", name, 0, [&]() {
+            const std::string &key = missing[next++ % count];
+            bench_do_not_optimize(map.find(key.data(), (uint32_t)key.size()));
+        });
+        snprintf(name, sizeof(name), "unordered_map<string> miss/%u", count);
+        bench_run("map", name, 0, [&]() {
+            bench_do_not_optimize(std_map.find(missing[next++ % count]));
+        });
+
+        // Insert and erase a key that is not in the map, so the size stays constant
+        snprintf(name, sizeof(name), "StaticStringMap insert+erase/%u", count);
+        bench_run("map", name, 0, [&]() {
+            const std::string &key = missing[next++ % count];
+            map.insert(key.data(), (uint32_t)key.size(), 0);
+            bench_do_not_optimize(map.erase(key.data(), (uint32_t)key.size()));
+        });
+        snprintf(name, sizeof(name), "unordered_map<string> insert+erase/%u", count);
+        bench_run("map", name, 0, [&]() {
+            const std::string &key = missing[next++ % count];
+            std_map.emplace(key, 0);
+            bench_do_not_optimize(std_map.erase(key));
+        });
+    }
+}
+
+void run_map_benchmarks()
+{
+    for (size_t c = 0; c < sizeof(kKeyCounts) / sizeof(kKeyCounts[0]); c++)
+    {
+        run_count(kKeyCounts[c]);
+    }
+}
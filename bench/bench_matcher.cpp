@@ -0,0 +1,100 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "StaticStringMatcher.h"
+#include "bench.h"
+
+namespace
+{
+    const uint32_t kCapacity = 4096;
+    const uint32_t kKeywordCounts[] = {8, 32, 500};
+
+    // Identifier-like keywords of 4 to 12 characters; the first few occur in the log lines
+    std::vector<std::string> make_keywords(uint32_t count)
+    {
+        static const char *const common[] = {"timeout", "refused", "panic", "status=503"};
+        std::vector<std::string> keywords;
+        uint32_t state = 7;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (i < sizeof(common) / sizeof(common[0]))
+            {
+                keywords.push_back(common[i]);
+                continue;
+            }
+            state = state * 1664525u + 1013904223u;
+            uint32_t length = 4 + (state >> 24) % 9;
+            std::string keyword;
+            while (keyword.size() < length)
+            {
+                state = state * 1664525u + 1013904223u;
+                keyword += (char)('a' + (state >> 27) % 26);
+            }
+            keywords.push_back(keyword);
+        }
+        return keywords;
+    }
+
+    std::string make_log(uint32_t size)
+    {
+        static const char *const lines[] = {
+            "2024-01-01T00:00:00Z INFO request served path=/api/v1/items status=200 ",
+            "2024-01-01T00:00:01Z WARN upstream timeout after 3000ms host=10.0.0.7 ",
+            "2024-01-01T00:00:02Z INFO cache warmed entries=18234 elapsed=41ms ",
+            "2024-01-01T00:00:03Z ERROR connection refused by backend status=503 ",
+        };
+        std::string log;
+        for (uint32_t i = 0; log.size() < size; i++)
+        {
+            log += lines[i % 4];
+        }
+        log.resize(size);
+        return log;
+    }
+
+    void run_case(const char *label, const std::string &text, uint32_t keyword_count)
+    {
+        std::vector<std::string> keywords = make_keywords(keyword_count);
+        BasicStaticString<kCapacity> haystack(text.c_str());
+        std::vector<BasicStaticString<16>> needles;
+        StaticStringMatcher automatic, aho_corasick;
+        for (size_t i = 0; i < keywords.size(); i++)
+        {
+            needles.push_back(BasicStaticString<16>(keywords[i].c_str()));
+            automatic.add_cstr(keywords[i].c_str());
+            aho_corasick.add_cstr(keywords[i].c_str());
+        }
+        uint32_t engine = automatic.compile();
+        aho_corasick.compile(SSTR_MATCHER_AHO_CORASICK);
+
+        StaticStringMatch matches[64];
+        char name[64];
+        snprintf(name, sizeof(name), "find_all %u keywords/%s", keyword_count, label);
+        bench_run("matcher", name, haystack.length(), [&]() { bench_do_not_optimize(automatic.find_all(haystack, matches, 64)); },
+                  engine == SSTR_MATCHER_TEDDY ? "teddy" : "aho-corasick");
+        snprintf(name, sizeof(name), "find_all aho-corasick %u keywords/%s", keyword_count, label);
+        bench_run("matcher", name, haystack.length(), [&]() { bench_do_not_optimize(aho_corasick.find_all(haystack, matches, 64)); });
+        // What callers do without a matcher: one search per keyword, each rescanning the text
+        snprintf(name, sizeof(name), "find per keyword %u keywords/%s", keyword_count, label);
+        bench_run("matcher", name, haystack.length(), [&]() {
+            uint32_t found = 0;
+            for (size_t i = 0; i < needles.size(); i++)
+            {
+                found += haystack.find(needles[i]) != -1;
+            }
+            bench_do_not_optimize(found);
+        }, "first hit only");
+    }
+}
+
+void run_matcher_benchmarks()
+{
+    std::string line = make_log(200);
+    std::string page = make_log(kCapacity);
+    for (size_t i = 0; i < sizeof(kKeywordCounts) / sizeof(kKeywordCounts[0]); i++)
+    {
+        run_case("200B", line, kKeywordCounts[i]);
+        run_case("4K", page, kKeywordCounts[i]);
+    }
+}
@@ -0,0 +1,46 @@
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "StaticString.h"
+#include "bench.h"
+
+namespace
+{
+    const uint32_t kCapacity = 4096;
+
+    void run_case(const char *label, const std::string &haystack, const std::string &needle)
+    {
+        BasicStaticString<kCapacity> h(haystack.c_str()), n(needle.c_str());
+        char name[64];
+
+        snprintf(name, sizeof(name), "sstr find %s", label);
+        bench_run("search", name, 0, [&]() { bench_do_not_optimize(h.find(n)); });
+        snprintf(name, sizeof(name), "std::string find %s", label);
+        bench_run("search", name, 0, [&]() { bench_do_not_optimize(haystack.find(needle)); });
+        snprintf(name, sizeof(name), "strstr %s", label);
+        bench_run("search", name, 0, [&]() { bench_do_not_optimize(strstr(h.to_cstr(), n.to_cstr())); });
+        snprintf(name, sizeof(name), "sstr ifind %s", label);
+        bench_run("search", name, 0, [&]() { bench_do_not_optimize(h.ifind(n)); });
+        snprintf(name, sizeof(name), "sstr rfind %s", label);
+        bench_run("search", name, 0, [&]() { bench_do_not_optimize(h.rfind(n)); });
+    }
+}
+
+void run_search_benchmarks()
+{
+    // Log-like text with the needle at the very end
+    std::string log;
+    while (log.size() < kCapacity - 64)
+    {
+        log += "2024-01-01T00:00:00Z INFO request served path=/api/v1/items status=200 ";
+    }
+    log += "status=503";
+    run_case("log/4K", log, "status=503");
+
+    // Adversarial: many first/last byte candidates that fail in the middle
+    std::string adversarial(kCapacity, 'a');
+    std::string needle(64, 'a');
+    needle[32] = 'b';
+    run_case("aaa/4K", adversarial, needle);
+}
@@ -0,0 +1,122 @@
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+#include "StaticString.h"
+#include "bench.h"
+
+namespace
+{
+    const uint32_t kSizes[] = {64, 256, 1024};
+    const uint32_t kCapacity = 1024;
+
+    typedef BasicStaticString<kCapacity> Message;
+
+    // Fields of 1 to 12 characters separated by commas, like a FIX/CSV message
+    std::string make_message(uint32_t size)
+    {
+        std::string text;
+        uint32_t state = 12345;
+        while (text.size() < size)
+        {
+            state = state * 1664525u + 1013904223u;
+            uint32_t field = 1 + (state >> 24) % 12;
+            for (uint32_t i = 0; i < field && text.size() < size; i++)
+            {
+                text += (char)('a' + i);
+            }
+            if (text.size() < size)
+            {
+                text += ',';
+            }
+        }
+        return text;
+    }
+
+    void run_size(uint32_t size)
+    {
+        std::string text = make_message(size);
+        Message message(text.c_str());
+        std::string_view sv(text);
+        char name[64];
+
+        // The pattern this replaces: find, copy the field out, shift the rest left
+        snprintf(name, sizeof(name), "find+substring+remove/%u", size);
+        bench_run("split", name, 0, [&]() {
+            Message rest = message;
+            Message field;
+            uint32_t fields = 0;
+            int32_t comma;
+            while ((comma = rest.first_index_of(',')) >= 0)
+            {
+                if (comma > 0)
+                {
+                    rest.substring(field, 0, (uint32_t)comma - 1);
+                }
+                rest.remove_range(0, (uint32_t)comma);
+                fields++;
+            }
+            bench_do_not_optimize(fields);
+        });
+
+        snprintf(name, sizeof(name), "sstr_split_next/%u", size);
+        bench_run("split", name, 0, [&]() {
+            StaticStringSplit split;
+            StaticStringView token;
+            uint32_t fields = 0;
+            sstr_split_init(&split, message.view(), ',');
+            while (sstr_split_next(&split, &token))
+            {
+                fields += token.length;
+            }
+            bench_do_not_optimize(fields);
+        });
+
+        snprintf(name, sizeof(name), "sstr_split_any/%u", size);
+        bench_run("split", name, 0, [&]() {
+            uint32_t fields = 0;
+            for (StaticStringView token : message.split_any(",;|"))
+            {
+                fields += token.length;
+            }
+            bench_do_not_optimize(fields);
+        });
+
+        // More delimiters than SSTR_SPLIT_MAX_MASKED_SET, matched as a character class
+        snprintf(name, sizeof(name), "sstr_split_any 6 delimiters/%u", size);
+        bench_run("split", name, 0, [&]() {
+            uint32_t fields = 0;
+            for (StaticStringView token : message.split_any(",;|\t:/"))
+            {
+                fields += token.length;
+            }
+            bench_do_not_optimize(fields);
+        });
+
+        snprintf(name, sizeof(name), "string_view find loop/%u", size);
+        bench_run("split", name, 0, [&]() {
+            uint32_t fields = 0;
+            size_t start = 0;
+            for (;;)
+            {
+                size_t comma = sv.find(',', start);
+                if (comma == std::string_view::npos)
+                {
+                    fields += (uint32_t)(sv.size() - start);
+                    break;
+                }
+                fields += (uint32_t)(comma - start);
+                start = comma + 1;
+            }
+            bench_do_not_optimize(fields);
+        });
+    }
+}
+
+void run_split_benchmarks()
+{
+    for (size_t s = 0; s < sizeof(kSizes) / sizeof(kSizes[0]); s++)
+    {
+        run_size(kSizes[s]);
+    }
+}
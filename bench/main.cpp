@@ -0,0 +1,208 @@
+#include <cstdlib>
+#include <cstring>
+
+#include "StaticString.h"
+#include "bench.h"
+
+#if defined(__linux__)
+#include <sched.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+#if SSTR_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace
+{
+    void print_usage(const char *program)
+    {
+        std::printf("usage: %s [--filter TEXT] [--json FILE] [--min-ms MS] [--ghz GHZ] [--repetitions N] [--pin CPU]\n"
+                    "  --filter TEXT    only run results whose group/name contains TEXT\n"
+                    "  --json FILE      also write the results to FILE as JSON\n"
+                    "  --min-ms MS      minimum measuring time per sample (default %.0f)\n"
+                    "  --ghz GHZ        clock rate for bytes/cycle (default: measured TSC rate)\n"
+                    "  --repetitions N  samples per result; the median is printed (default 1)\n"
+                    "  --pin CPU        run on a single CPU to reduce scheduling noise\n",
+                    program, bench_options().min_ms);
+    }
+
+    bool pin_to_cpu(int cpu)
+    {
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return sched_setaffinity(0, sizeof(set), &set) == 0;
+#elif defined(_WIN32)
+        return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu) != 0;
+#else
+        (void)cpu;
+        return false;
+#endif
+    }
+
+    void write_json_string(FILE *file, const std::string &text)
+    {
+        std::fputc('"', file);
+        for (size_t i = 0; i < text.size(); i++)
+        {
+            unsigned char c = (unsigned char)text[i];
+            if (c == '"' || c == '\\')
+            {
+                std::fprintf(file, "\\%c", c);
+            }
+            else if (c < 0x20)
+            {
+                std::fprintf(file, "\\u%04x", c);
+            }
+            else
+            {
+                std::fputc(c, file);
+            }
+        }
+        std::fputc('"', file);
+    }
+
+    struct BenchGroup
+    {
+        const char *name;
+        void (*run)();
+    };
+}
+
+double bench_cycles_per_ns()
+{
+    BenchOptions &options = bench_options();
+    if (options.cycles_per_ns == 0.0)
+    {
+#if SSTR_X86
+        typedef std::chrono::steady_clock clock;
+        clock::time_point start = clock::now();
+        uint64_t ticks = __rdtsc();
+        while (clock::now() - start < std::chrono::milliseconds(20))
+        {
+        }
+        ticks = __rdtsc() - ticks;
+        double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+        options.cycles_per_ns = (double)ticks / ns;
+#else
+        options.cycles_per_ns = -1.0; // Unknown; bytes/cycle is not reported
+#endif
+    }
+    return options.cycles_per_ns;
+}
+
+bool bench_write_json()
+{
+    const BenchOptions &options = bench_options();
+    FILE *file = std::fopen(options.json_path.c_str(), "w");
+    if (file == NULL)
+    {
+        return false;
+    }
+    const char *levels[] = {"scalar", "sse2", "avx2", "avx512bw"};
+    std::fprintf(file, "{\n  \"context\": {\"simd_level\": \"%s\", \"cycles_per_ns\": %.4f, \"min_ms\": %.1f, \"repetitions\": %u, \"pin_cpu\": %d},\n",
+                 levels[sstr_kernels()->level], bench_cycles_per_ns(), options.min_ms, options.repetitions, options.pin_cpu);
+    std::fprintf(file, "  \"results\": [\n");
+    const std::vector<BenchResult> &results = bench_results();
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const BenchResult &r = results[i];
+        std::fprintf(file, "    {\"group\": ");
+        write_json_string(file, r.group);
+        std::fprintf(file, ", \"name\": ");
+        write_json_string(file, r.name);
+        std::fprintf(file, ", \"ns_per_op\": %.4f, \"bytes_per_op\": %llu", r.ns_per_op, (unsigned long long)r.bytes_per_op);
+        if (r.bytes_per_op != 0 && bench_cycles_per_ns() > 0)
+        {
+            std::fprintf(file, ", \"bytes_per_cycle\": %.4f", (double)r.bytes_per_op / (r.ns_per_op * bench_cycles_per_ns()));
+        }
+        std::fprintf(file, ", \"note\": ");
+        write_json_string(file, r.note);
+        std::fprintf(file, ", \"samples\": [");
+        for (size_t j = 0; j < r.samples.size(); j++)
+        {
+            std::fprintf(file, "%s%.4f", j > 0 ? ", " : "", r.samples[j]);
+        }
+        std::fprintf(file, "]}%s\n", i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+    return std::fclose(file) == 0;
+}
+
+int main(int argc, char **argv)
+{
+    BenchOptions &options = bench_options();
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (std::strcmp(arg, "--filter") == 0 && value != NULL)
+        {
+            options.filter = value;
+        }
+        else if (std::strcmp(arg, "--json") == 0 && value != NULL)
+        {
+            options.json_path = value;
+        }
+        else if (std::strcmp(arg, "--min-ms") == 0 && value != NULL)
+        {
+            options.min_ms = std::atof(value);
+        }
+        else if (std::strcmp(arg, "--ghz") == 0 && value != NULL)
+        {
+            options.cycles_per_ns = std::atof(value);
+        }
+        else if (std::strcmp(arg, "--repetitions") == 0 && value != NULL && std::atoi(value) > 0)
+        {
+            options.repetitions = (uint32_t)std::atoi(value);
+        }
+        else if (std::strcmp(arg, "--pin") == 0 && value != NULL)
+        {
+            options.pin_cpu = std::atoi(value);
+        }
+        else
+        {
+            print_usage(argv[0]);
+            return std::strcmp(arg, "--help") == 0 ? 0 : 2;
+        }
+        i++;
+    }
+
+    if (options.pin_cpu >= 0 && !pin_to_cpu(options.pin_cpu))
+    {
+        std::fprintf(stderr, "could not pin to CPU %d\n", options.pin_cpu);
+    }
+
+    const BenchGroup groups[] = {
+        {"layout", run_layout_benchmarks},
+        {"kernels", run_kernel_benchmarks},
+        {"compare", run_compare_benchmarks},
+        {"search", run_search_benchmarks},
+        {"hash", run_hash_benchmarks},
+        {"map", run_map_benchmarks},
+        {"matcher", run_matcher_benchmarks},
+        {"split", run_split_benchmarks},
+        {"api", run_api_benchmarks},
+    };
+    for (size_t g = 0; g < sizeof(groups) / sizeof(groups[0]); g++)
+    {
+        if (bench_group_selected(groups[g].name))
+        {
+            groups[g].run();
+        }
+    }
+
+    if (!options.json_path.empty() && !bench_write_json())
+    {
+        std::fprintf(stderr, "could not write %s\n", options.json_path.c_str());
+        return 1;
+    }
+    return 0;
+}
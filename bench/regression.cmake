@@ -0,0 +1,23 @@
+# Runs the benchmarks and compares them against the recorded baseline.
+# Invoked by the bench_regression ctest; see SSTR_BENCH_REGRESSION in CMakeLists.txt.
+
+if(NOT EXISTS "${BASELINE}")
+    message(FATAL_ERROR "No benchmark baseline at ${BASELINE}; build the bench_baseline target first")
+endif()
+
+execute_process(
+    COMMAND "${BENCH}" ${RUN_ARGS} --json "${CURRENT}"
+    OUTPUT_QUIET
+    RESULT_VARIABLE bench_result
+)
+if(NOT bench_result EQUAL 0)
+    message(FATAL_ERROR "Benchmark run failed: ${bench_result}")
+endif()
+
+execute_process(
+    COMMAND "${COMPARE}" "${BASELINE}" "${CURRENT}" --threshold ${THRESHOLD} --alpha ${ALPHA}
+    RESULT_VARIABLE compare_result
+)
+if(NOT compare_result EQUAL 0)
+    message(FATAL_ERROR "Benchmarks regressed against ${BASELINE}, or results were missing or undersampled")
+endif()
@@ -0,0 +1,500 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+/*
+ * Compares two JSON files written by StaticStringBench --json. For every
+ * result present in both, a one-sided Mann-Whitney U test checks whether the
+ * current samples are stochastically slower than the baseline samples. A
+ * result regresses when its median slowed down by more than --threshold and
+ * the test is significant at --alpha. With only a few samples on either side
+ * the test can never reach significance, so such results, and baseline results
+ * the current run did not produce, fail the comparison instead of passing
+ * silently. The exit code is 1 if any result regressed, was undersampled or is
+ * missing, so the tool can back a ctest.
+ */
+
+namespace
+{
+    struct Options
+    {
+        const char *baseline_path = NULL;
+        const char *current_path = NULL;
+        double threshold = 0.05;  // Relative slowdown of the median that counts as a regression
+        double alpha = 0.01;      // Significance level of the one-sided test
+        double min_ns = 0.5;      // Results faster than this in the baseline are too noisy to judge
+        uint32_t min_samples = 5; // Results with fewer samples on either side cannot be judged and fail
+        std::string filter;
+    };
+
+    struct Cell
+    {
+        std::vector<double> samples;
+    };
+
+    // Minimal reader for the subset of JSON the benchmark writes
+    class JsonReader
+    {
+    public:
+        explicit JsonReader(const std::string &text) : text(text), pos(0), failed(false) {}
+
+        bool ok() const { return !failed; }
+
+        // Reads the "results" array into cells keyed by "group/name"
+        void read_results(std::map<std::string, Cell> &cells)
+        {
+            expect('{');
+            while (!failed && !peek('}'))
+            {
+                std::string key = read_string();
+                expect(':');
+                if (key == "results")
+                {
+                    read_result_array(cells);
+                }
+                else
+                {
+                    skip_value();
+                }
+                if (!peek('}'))
+                {
+                    expect(',');
+                }
+            }
+            expect('}');
+        }
+
+    private:
+        void read_result_array(std::map<std::string, Cell> &cells)
+        {
+            expect('[');
+            while (!failed && !peek(']'))
+            {
+                std::string group, name;
+                Cell cell;
+                double median = 0.0;
+                expect('{');
+                while (!failed && !peek('}'))
+                {
+                    std::string key = read_string();
+                    expect(':');
+                    if (key == "group")
+                    {
+                        group = read_string();
+                    }
+                    else if (key == "name")
+                    {
+                        name = read_string();
+                    }
+                    else if (key == "ns_per_op")
+                    {
+                        median = read_number();
+                    }
+                    else if (key == "samples")
+                    {
+                        expect('[');
+                        while (!failed && !peek(']'))
+                        {
+                            cell.samples.push_back(read_number());
+                            if (!peek(']'))
+                            {
+                                expect(',');
+                            }
+                        }
+                        expect(']');
+                    }
+                    else
+                    {
+                        skip_value();
+                    }
+                    if (!peek('}'))
+                    {
+                        expect(',');
+                    }
+                }
+                expect('}');
+                if (cell.samples.empty())
+                {
+                    cell.samples.push_back(median); // Files from before repetitions were recorded
+                }
+                cells[group + "/" + name] = cell;
+                if (!peek(']'))
+                {
+                    expect(',');
+                }
+            }
+            expect(']');
+        }
+
+        void skip_space()
+        {
+            while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\n' || text[pos] == '\r' || text[pos] == '\t'))
+            {
+                pos++;
+            }
+        }
+
+        bool peek(char c)
+        {
+            skip_space();
+            return pos < text.size() && text[pos] == c;
+        }
+
+        void expect(char c)
+        {
+            if (peek(c))
+            {
+                pos++;
+            }
+            else
+            {
+                failed = true;
+            }
+        }
+
+        std::string read_string()
+        {
+            std::string out;
+            expect('"');
+            while (!failed && pos < text.size() && text[pos] != '"')
+            {
+                char c = text[pos++];
+                if (c == '\\' && pos < text.size())
+                {
+                    c = text[pos++];
+                    if (c == 'u' && pos + 4 <= text.size())
+                    {
+                        c = (char)strtol(text.substr(pos, 4).c_str(), NULL, 16);
+                        pos += 4;
+                    }
+                    else if (c == 'n')
+                    {
+                        c = '\n';
+                    }
+                    else if (c == 't')
+                    {
+                        c = '\t';
+                    }
+                }
+                out += c;
+            }
+            expect('"');
+            return out;
+        }
+
+        double read_number()
+        {
+            skip_space();
+            const char *start = text.c_str() + pos;
+            char *end = NULL;
+            double value = strtod(start, &end);
+            if (end == start)
+            {
+                failed = true;
+            }
+            pos += (size_t)(end - start);
+            return value;
+        }
+
+        void skip_value()
+        {
+            skip_space();
+            if (pos >= text.size())
+            {
+                failed = true;
+                return;
+            }
+            char c = text[pos];
+            if (c == '"')
+            {
+                read_string();
+            }
+            else if (c == '{' || c == '[')
+            {
+                char close = c == '{' ? '}' : ']';
+                pos++;
+                while (!failed && !peek(close))
+                {
+                    if (c == '{')
+                    {
+                        read_string();
+                        expect(':');
+                    }
+                    skip_value();
+                    if (!peek(close))
+                    {
+                        expect(',');
+                    }
+                }
+                expect(close);
+            }
+            else if (text.compare(pos, 4, "true") == 0 || text.compare(pos, 4, "null") == 0)
+            {
+                pos += 4;
+            }
+            else if (text.compare(pos, 5, "false") == 0)
+            {
+                pos += 5;
+            }
+            else
+            {
+                read_number();
+            }
+        }
+
+        const std::string &text;
+        size_t pos;
+        bool failed;
+    };
+
+    bool load(const char *path, std::map<std::string, Cell> &cells)
+    {
+        FILE *file = fopen(path, "rb");
+        if (file == NULL)
+        {
+            fprintf(stderr, "cannot open %s\n", path);
+            return false;
+        }
+        std::string text;
+        char buffer[4096];
+        size_t read;
+        while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        {
+            text.append(buffer, read);
+        }
+        fclose(file);
+
+        JsonReader reader(text);
+        reader.read_results(cells);
+        if (!reader.ok())
+        {
+            fprintf(stderr, "%s is not a StaticStringBench JSON file\n", path);
+            return false;
+        }
+        return true;
+    }
+
+    double median(std::vector<double> samples)
+    {
+        std::sort(samples.begin(), samples.end());
+        size_t middle = samples.size() / 2;
+        return samples.size() % 2 != 0 ? samples[middle] : (samples[middle - 1] + samples[middle]) / 2.0;
+    }
+
+    /**
+     * @brief One-sided Mann-Whitney U test.
+     *
+     * @return double Probability, under the hypothesis that both sample sets
+     *         come from the same distribution, of current exceeding baseline at
+     *         least as often as observed. Exact for small samples without ties,
+     *         otherwise from the tie-corrected normal approximation.
+     */
+    double mann_whitney_p(const std::vector<double> &baseline, const std::vector<double> &current)
+    {
+        const size_t m = baseline.size();
+        const size_t n = current.size();
+        double u = 0.0; // Pairs where the current sample is slower, ties counting half
+        bool ties = false;
+        for (size_t i = 0; i < m; i++)
+        {
+            for (size_t j = 0; j < n; j++)
+            {
+                if (current[j] > baseline[i])
+                {
+                    u += 1.0;
+                }
+                else if (current[j] == baseline[i])
+                {
+                    u += 0.5;
+                    ties = true;
+                }
+            }
+        }
+
+        if (!ties && m + n <= 40)
+        {
+            // counts[a][b][k]: orderings of a baseline and b current samples with U == k,
+            // built up by placing the largest remaining sample last
+            std::vector<std::vector<std::vector<double> > > counts(m + 1, std::vector<std::vector<double> >(n + 1));
+            for (size_t a = 0; a <= m; a++)
+            {
+                for (size_t b = 0; b <= n; b++)
+                {
+                    counts[a][b].assign(a * b + 1, 0.0);
+                    if (a == 0 || b == 0)
+                    {
+                        counts[a][b][0] = 1.0;
+                        continue;
+                    }
+                    for (size_t k = 0; k <= a * b; k++)
+                    {
+                        double largest_current = k >= a ? counts[a][b - 1][k - a] : 0.0; // Beats all a baseline samples
+                        double largest_baseline = k <= (a - 1) * b ? counts[a - 1][b][k] : 0.0;
+                        counts[a][b][k] = largest_current + largest_baseline;
+                    }
+                }
+            }
+            double total = 0.0, tail = 0.0;
+            for (size_t k = 0; k <= m * n; k++)
+            {
+                total += counts[m][n][k];
+                if ((double)k >= u)
+                {
+                    tail += counts[m][n][k];
+                }
+            }
+            return tail / total;
+        }
+
+        // Normal approximation with tie correction and continuity correction
+        std::vector<double> all(baseline);
+        all.insert(all.end(), current.begin(), current.end());
+        std::sort(all.begin(), all.end());
+        double tie_term = 0.0;
+        for (size_t i = 0; i < all.size();)
+        {
+            size_t j = i;
+            while (j < all.size() && all[j] == all[i])
+            {
+                j++;
+            }
+            double t = (double)(j - i);
+            tie_term += t * t * t - t;
+            i = j;
+        }
+        double total = (double)(m + n);
+        double mean = (double)m * (double)n / 2.0;
+        double variance = (double)m * (double)n / 12.0 * ((total + 1.0) - tie_term / (total * (total - 1.0)));
+        if (variance <= 0.0)
+        {
+            return 1.0;
+        }
+        double z = (u - mean - 0.5) / std::sqrt(variance);
+        return 0.5 * std::erfc(z / std::sqrt(2.0));
+    }
+
+    void print_usage(const char *program)
+    {
+        printf("usage: %s BASELINE.json CURRENT.json [--threshold FRACTION] [--alpha P] [--min-ns NS] [--min-samples N] [--filter TEXT]\n"
+               "  --threshold FRACTION  slowdown of the median that counts as a regression (default 0.05)\n"
+               "  --alpha P             significance level of the Mann-Whitney test (default 0.01)\n"
+               "  --min-ns NS           ignore results faster than NS in the baseline (default 0.5)\n"
+               "  --min-samples N       fail results with fewer than N samples in either run (default 5)\n"
+               "  --filter TEXT         only compare results whose group/name contains TEXT\n",
+               program);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Options options;
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(arg, "--threshold") == 0 && value != NULL)
+        {
+            options.threshold = atof(value);
+            i++;
+        }
+        else if (strcmp(arg, "--alpha") == 0 && value != NULL)
+        {
+            options.alpha = atof(value);
+            i++;
+        }
+        else if (strcmp(arg, "--min-ns") == 0 && value != NULL)
+        {
+            options.min_ns = atof(value);
+            i++;
+        }
+        else if (strcmp(arg, "--min-samples") == 0 && value != NULL && atoi(value) > 0)
+        {
+            options.min_samples = (uint32_t)atoi(value);
+            i++;
+        }
+        else if (strcmp(arg, "--filter") == 0 && value != NULL)
+        {
+            options.filter = value;
+            i++;
+        }
+        else if (arg[0] != '-' && options.baseline_path == NULL)
+        {
+            options.baseline_path = arg;
+        }
+        else if (arg[0] != '-' && options.current_path == NULL)
+        {
+            options.current_path = arg;
+        }
+        else
+        {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+    if (options.current_path == NULL)
+    {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    std::map<std::string, Cell> baseline, current;
+    if (!load(options.baseline_path, baseline) || !load(options.current_path, current))
+    {
+        return 2;
+    }
+
+    uint32_t compared = 0, regressed = 0, improved = 0, missing = 0, undersampled = 0;
+    for (std::map<std::string, Cell>::const_iterator it = baseline.begin(); it != baseline.end(); ++it)
+    {
+        if (!options.filter.empty() && it->first.find(options.filter) == std::string::npos)
+        {
+            continue;
+        }
+        std::map<std::string, Cell>::const_iterator other = current.find(it->first);
+        if (other == current.end())
+        {
+            printf("MISSING    %-60s not in the current run\n", it->first.c_str());
+            missing++;
+            continue;
+        }
+        double before = median(it->second.samples);
+        double after = median(other->second.samples);
+        if (before < options.min_ns)
+        {
+            continue;
+        }
+        if (it->second.samples.size() < options.min_samples || other->second.samples.size() < options.min_samples)
+        {
+            printf("TOO FEW    %-60s %u baseline and %u current samples, need %u (--repetitions)\n", it->first.c_str(),
+                   (unsigned)it->second.samples.size(), (unsigned)other->second.samples.size(), options.min_samples);
+            undersampled++;
+            continue;
+        }
+        compared++;
+        double change = after / before - 1.0;
+        if (change > options.threshold)
+        {
+            double p = mann_whitney_p(it->second.samples, other->second.samples);
+            if (p < options.alpha)
+            {
+                printf("REGRESSION %-60s %10.3f -> %10.3f ns/op  %+6.1f%%  p=%.4f\n", it->first.c_str(), before, after, change * 100.0, p);
+                regressed++;
+            }
+        }
+        else if (change < -options.threshold && mann_whitney_p(other->second.samples, it->second.samples) < options.alpha)
+        {
+            printf("improved   %-60s %10.3f -> %10.3f ns/op  %+6.1f%%\n", it->first.c_str(), before, after, change * 100.0);
+            improved++;
+        }
+    }
+
+    printf("%u results compared, %u regressed, %u improved, %u missing from the current run, %u with too few samples\n", compared, regressed,
+           improved, missing, undersampled);
+    return regressed > 0 || missing > 0 || undersampled > 0 ? 1 : 0;
+}
@@ -1,7 +1,9 @@
 #ifndef STATICSTRING_H
 #define STATICSTRING_H
 
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #ifndef SSTR_MAX_LENGTH
 #define SSTR_MAX_LENGTH ((uint32_t)(-1)) // Maximum length of a StaticString excluding the null terminator
@@ -9,805 +11,7809 @@
 
 #define IS_WHITESPACE(c) ((c) == ' ' || (c) == '\t' || (c) == '\n' || (c) == '\r')
 
+// Memory layouts of the length field relative to the character buffer
+#define SSTR_LAYOUT_TRAILING 0     // Length stored after the buffer (original layout)
+#define SSTR_LAYOUT_HEADER_FIRST 1 // Length stored before the buffer, on the same cache line as the first characters
+#define SSTR_LAYOUT_COMPACT 2      // No length field, remaining capacity stored in the last byte (C++ template only, N <= 255)
+
+#ifndef SSTR_LAYOUT
+#define SSTR_LAYOUT SSTR_LAYOUT_TRAILING // Layout of the StaticString struct
+#endif
+
+#ifndef SSTR_CACHED_HASH
+#define SSTR_CACHED_HASH 0 // Set to 1 to keep a hash of the characters in every StaticString, updated by each mutation
+#endif
+
+#if SSTR_LAYOUT == SSTR_LAYOUT_HEADER_FIRST
+typedef struct
+{
+#if SSTR_CACHED_HASH
+    uint64_t string_hash;                    // Polynomial hash state of the characters, see sstr_hash()
+#endif
+    uint32_t string_length;                  // Number of characters in the string (excluding the null terminator)
+    char static_string[SSTR_MAX_LENGTH + 1]; // char array + null terminator
+} StaticString;
+#elif SSTR_LAYOUT == SSTR_LAYOUT_TRAILING
 typedef struct
 {
     char static_string[SSTR_MAX_LENGTH + 1]; // char array + null terminator
     uint32_t string_length;                  // Number of characters in the string (excluding the null terminator)
+#if SSTR_CACHED_HASH
+    uint64_t string_hash;                    // Polynomial hash state of the characters, see sstr_hash()
+#endif
 } StaticString;
+#else
+#error "SSTR_LAYOUT must be SSTR_LAYOUT_TRAILING or SSTR_LAYOUT_HEADER_FIRST for the StaticString struct"
+#endif
 
-/**
- * @brief Initializes a StaticString structure.
- *
- * Sets the string length to 0 and null-terminates the internal character buffer.
+/*
+ * ---------------------------------------------------------------------------
+ * SIMD kernel layer
  *
- * @param sstr Pointer to the StaticString to initialize.
+ * The hot loops of the core are implemented once per instruction set and
+ * selected at first use through CPUID. Defining SSTR_SIMD_LEVEL before
+ * including this header fixes the kernel set at compile time instead (e.g.
+ * SSTR_SIMD_SCALAR for embedded builds); non-x86 targets always use the
+ * scalar kernels.
+ * ---------------------------------------------------------------------------
+ */
+
+#define SSTR_SIMD_SCALAR 0
+#define SSTR_SIMD_SSE2 1
+#define SSTR_SIMD_AVX2 2
+#define SSTR_SIMD_AVX512BW 3
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SSTR_X86 1
+#else
+#define SSTR_X86 0
+#endif
+
+#if !SSTR_X86 && !defined(SSTR_SIMD_LEVEL)
+#define SSTR_SIMD_LEVEL SSTR_SIMD_SCALAR
+#endif
+
+#if SSTR_X86 && (!defined(SSTR_SIMD_LEVEL) || SSTR_SIMD_LEVEL > SSTR_SIMD_SCALAR)
+#define SSTR_HAS_X86_KERNELS 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#else
+#define SSTR_HAS_X86_KERNELS 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SSTR_TARGET(isa) __attribute__((target(isa)))
+#else
+#define SSTR_TARGET(isa)
+#endif
+
+// Kernels that read whole vectors past a C string terminator (never across a page) opt out of ASan
+#if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 8)
+#define SSTR_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#else
+#define SSTR_NO_SANITIZE_ADDRESS
+#endif
+
+// Variables defined in the header: every translation unit emits one and the linker keeps a single copy
+#if defined(_MSC_VER)
+#define SSTR_SELECTANY __declspec(selectany)
+#else
+#define SSTR_SELECTANY __attribute__((weak))
+#endif
+
+#define SSTR_PAGE_SIZE 4096u // Smallest page size; aligned reads within one page never fault
+
+/*
+ * ---------------------------------------------------------------------------
+ * Character classes
  *
- * @warning This function does not clear the internal character buffer.
+ * A set of byte values, stored both as a 256-bit table for scalar code and as
+ * two 16-byte nibble tables for SIMD code: a vector of bytes is classified
+ * with byte shuffles (pshufb) indexed by each byte's low and high nibble.
+ * Classes are built once and passed by pointer.
+ * ---------------------------------------------------------------------------
+ */
+
+#define SSTR_WHITESPACE_CHARS " \t\n\r" // The characters matched by IS_WHITESPACE
+
+typedef struct
+{
+    uint32_t bits[8];           // Bit (c & 31) of bits[c >> 5] is set if byte c is in the class
+    uint8_t nibble_rows[2][16]; // Bit ((c >> 4) & 7) of nibble_rows[c >> 7][c & 15] is set if byte c is in the class
+} StaticStringCharClass;
+
+/**
+ * @brief Adds a character to a character class.
  *
- * @return uint32_t 1 if the StaticString was successfully initialized, 0 otherwise.
+ * @param cls Pointer to the class.
+ * @param ch The character to add.
  */
-inline uint32_t sstr_init(StaticString *sstr)
+inline void sstr_char_class_add(StaticStringCharClass *cls, char ch)
 {
-    if (sstr == NULL)
-    {
-        return 0;
-    }
-    else
-    {
-        sstr->string_length = 0;
-        sstr->static_string[0] = '\0';
-    }
-    return 1;
+    uint8_t c = (uint8_t)ch;
+    cls->bits[c >> 5] |= 1u << (c & 31);
+    cls->nibble_rows[c >> 7][c & 15] |= (uint8_t)(1u << ((c >> 4) & 7));
 }
 
 /**
- * @brief Initializes a StaticString from a null-terminated C string.
- *
- * Copies characters from the given C string into the StaticString's internal buffer,
- * truncating if necessary to fit within the maximum allowed length.
- *
- * @param sstr Pointer to the StaticString to initialize.
- * @param cstr Null-terminated C string to copy from.
+ * @brief Adds an inclusive range of byte values to a character class.
  *
- * @return uint32_t 1 if the StaticString was successfully initialized, 0 otherwise.
+ * @param cls Pointer to the class.
+ * @param first First character of the range, compared as unsigned.
+ * @param last Last character of the range, compared as unsigned.
  */
-inline uint32_t sstr_from_cstr(StaticString *sstr, const char *cstr)
+inline void sstr_char_class_add_range(StaticStringCharClass *cls, char first, char last)
 {
-    if (cstr == NULL || sstr == NULL)
-    {
-        return 0;
-    }
-    uint32_t i;
-    for (i = 0; i < SSTR_MAX_LENGTH && cstr[i] != '\0'; i++)
+    for (uint32_t c = (uint8_t)first; c <= (uint8_t)last; c++)
     {
-        sstr->static_string[i] = cstr[i];
+        sstr_char_class_add(cls, (char)c);
     }
-    sstr->static_string[i] = '\0';
-    sstr->string_length = i;
-    return 1;
 }
 
 /**
- * @brief Clears the contents of a StaticString.
+ * @brief Initializes a character class with the characters of a C string.
  *
- * Sets all characters in the internal buffer to null and resets the string length to 0.
+ * @param cls Pointer to the class to initialize.
+ * @param chars Null-terminated list of characters; may be NULL for an empty class.
  *
- * @param sstr Pointer to the StaticString to clear.
- *
- * @return uint32_t 1 if the StaticString was successfully cleared, 0 otherwise.
+ * @return uint32_t 1 on success, 0 if cls is NULL.
  */
-inline uint32_t sstr_clear(StaticString *sstr)
+inline uint32_t sstr_char_class_init(StaticStringCharClass *cls, const char *chars)
 {
-    if (sstr == NULL)
+    if (cls == NULL)
     {
         return 0;
     }
-    for (uint32_t i = 0; i <= SSTR_MAX_LENGTH; i++)
+    memset(cls, 0, sizeof(*cls));
+    for (; chars != NULL && *chars != '\0'; chars++)
     {
-        sstr->static_string[i] = '\0';
+        sstr_char_class_add(cls, *chars);
     }
-    sstr->string_length = 0;
     return 1;
 }
 
+// Same as sstr_char_class_init(), returning the class by value for static initialization
+inline StaticStringCharClass sstr_char_class_make(const char *chars)
+{
+    StaticStringCharClass cls;
+    sstr_char_class_init(&cls, chars);
+    return cls;
+}
+
 /**
- * @brief Appends a single character to the end of a StaticString.
- *
- * Adds the given character to the end of the string, null-terminates the result,
- * and updates the string length. If the string is already full, the character is not added.
+ * @brief Checks whether a character belongs to a character class.
  *
- * @param sstr Pointer to the StaticString to modify.
- * @param character The character to append.
+ * @param cls Pointer to the class.
+ * @param ch The character to test.
  *
- * @return uint32_t 1 if the character was appended, 0 if the string was full.
+ * @return uint32_t 1 if ch is in the class, 0 otherwise.
  */
-inline uint32_t sstr_append(StaticString *sstr, const char character)
+inline uint32_t sstr_char_class_contains(const StaticStringCharClass *cls, char ch)
 {
-    if (sstr == NULL)
-    {
-        return 0;
-    }
-    if (sstr->string_length < SSTR_MAX_LENGTH)
-    {
-        sstr->static_string[sstr->string_length] = character;
-        sstr->static_string[sstr->string_length + 1] = '\0';
-        sstr->string_length++;
-        return 1;
-    }
-    return 0;
+    uint8_t c = (uint8_t)ch;
+    return (cls->bits[c >> 5] >> (c & 31)) & 1;
 }
 
-/**
- * @brief Appends a null-terminated C string to a StaticString.
- *
- * Safely appends characters from the given C string to the end of the StaticString,
- * truncating if necessary to prevent buffer overflow. If the input string is NULL
- * or the StaticString is already full, the operation is skipped.
- *
- * @param sstr Pointer to the StaticString to modify.
- * @param cstr Null-terminated C string to append.
+// The class of SSTR_WHITESPACE_CHARS, spelled out so it is a constant in C as well as C++
+inline const StaticStringCharClass *sstr_char_class_whitespace(void)
+{
+    static const StaticStringCharClass whitespace = {
+        {0x00002600u, 0x00000001u, 0, 0, 0, 0, 0, 0},                       // '\t' '\n' '\r' in word 0, ' ' in word 1
+        {{0x04, 0, 0, 0, 0, 0, 0, 0, 0, 0x01, 0x01, 0, 0, 0x01, 0, 0}, {0}}, // High nibble 2 for ' ', 0 for the others
+    };
+    return &whitespace;
+}
+
+/*
+ * ---------------------------------------------------------------------------
+ * Translation tables
  *
- * @return uint32_t The number of characters appended.
+ * A mapping of every byte value to a replacement byte, applied to a string in
+ * one pass by sstr_translate(). Steps such as "replace ',' by ';'" and
+ * "uppercase" compose into a single table, so a chain of them costs the same
+ * as one. Each 16-entry row of the table (the bytes sharing a high nibble) is
+ * also a pshufb lookup table; SIMD kernels only visit the rows that differ
+ * from the identity.
+ * ---------------------------------------------------------------------------
  */
-inline uint32_t sstr_append_cstr(StaticString *sstr, const char *cstr)
+
+typedef struct
 {
-    if (cstr == NULL || sstr->string_length >= SSTR_MAX_LENGTH)
-    {
-        return 0;
-    }
+    uint8_t map[256];     // Byte c is replaced by map[c]
+    uint32_t active_rows; // Bit h is set if map[16 * h .. 16 * h + 15] is not the identity
+} StaticStringTranslation;
 
-    uint32_t i = 0;
-    for (i = 0; i < (SSTR_MAX_LENGTH - sstr->string_length) && cstr[i] != '\0'; i++)
+// Recomputes active_rows after map was changed
+inline void sstr_translation_update_rows(StaticStringTranslation *table)
+{
+    table->active_rows = 0;
+    for (uint32_t c = 0; c < 256; c++)
     {
-        sstr->static_string[sstr->string_length + i] = cstr[i];
+        if (table->map[c] != c)
+        {
+            table->active_rows |= 1u << (c >> 4);
+        }
     }
-    sstr->static_string[sstr->string_length + i] = '\0';
-    sstr->string_length += i;
-    return i;
 }
 
 /**
- * @brief Replaces a character in a StaticString at a given index.
- *
- * If the index is within the bounds of the current string length, replaces
- * the character at that index with the given character.
+ * @brief Initializes a translation table to the identity mapping.
  *
- * @param sstr Pointer to the StaticString to modify.
- * @param index Zero-based index of the character to replace.
- * @param character The new character to write at the specified index.
- *
- * @warning This function does not allow null characters.
+ * @param table Pointer to the table to initialize.
  *
- * @return uint32_t 1 if the replacement was successful, 0 if otherwise.
+ * @return uint32_t 1 on success, 0 if table is NULL.
  */
-inline uint32_t sstr_replace_char_from_index(StaticString *sstr, uint32_t index, char character)
+inline uint32_t sstr_translation_init(StaticStringTranslation *table)
 {
-    if (sstr == NULL)
+    if (table == NULL)
     {
         return 0;
     }
-    if (index >= sstr->string_length || index >= SSTR_MAX_LENGTH || character == '\0')
+    for (uint32_t c = 0; c < 256; c++)
     {
-        return 0;
+        table->map[c] = (uint8_t)c;
     }
-
-    sstr->static_string[index] = character;
+    table->active_rows = 0;
     return 1;
 }
 
 /**
- * @brief Replaces all occurrences of a character in a StaticString.
+ * @brief Appends a tr-style character mapping to a translation table.
  *
- * Iterates through the StaticString and replaces every instance of the specified
- * old character with the new character.
+ * After the existing mapping, the i-th character of from becomes the i-th
+ * character of to; if to is shorter, the remaining characters of from become
+ * its last character, as with tr. The first occurrence of a character in
+ * from wins.
  *
- * @param sstr Pointer to the StaticString to modify.
- * @param old_char The character to search for.
- * @param new_char The character to replace with.
+ * @param table Pointer to the table.
+ * @param from Null-terminated characters to replace.
+ * @param to Null-terminated replacements; must not be empty unless from is.
  *
- * @return uint32_t The number of characters replaced.
+ * @return uint32_t 1 on success, 0 if a pointer is NULL or to is empty while from is not.
  */
-inline uint32_t sstr_replace_all_chars(StaticString *sstr, char old_char, char new_char)
+inline uint32_t sstr_translation_map(StaticStringTranslation *table, const char *from, const char *to)
 {
-    if (sstr == NULL)
+    if (table == NULL || from == NULL || to == NULL || (*to == '\0' && *from != '\0'))
     {
         return 0;
     }
-    uint32_t count = 0;
-    for (uint32_t i = 0; i < sstr->string_length; i++)
+    uint8_t step[256];
+    uint8_t seen[256] = {0};
+    for (uint32_t c = 0; c < 256; c++)
     {
-        if (sstr->static_string[i] == old_char)
+        step[c] = (uint8_t)c;
+    }
+    for (; *from != '\0'; from++)
+    {
+        uint8_t c = (uint8_t)*from;
+        if (!seen[c])
         {
-            sstr->static_string[i] = new_char;
-            count++;
+            seen[c] = 1;
+            step[c] = (uint8_t)*to;
+        }
+        if (to[1] != '\0')
+        {
+            to++;
         }
     }
-    return count;
+    for (uint32_t c = 0; c < 256; c++)
+    {
+        table->map[c] = step[table->map[c]];
+    }
+    sstr_translation_update_rows(table);
+    return 1;
 }
 
 /**
- * @brief Inserts a single character into a StaticString at a given index.
+ * @brief Appends another translation table to a translation table.
  *
- * Shifts all characters at and after the given index to the right by one position
- * and inserts the given character at the specified index. If the index is greater
- * than the current string length, the character is not inserted.
+ * The result maps every byte as table followed by next.
  *
- * @param sstr Pointer to the StaticString to modify.
- * @param index Zero-based index where the character should be inserted.
- * @param character The character to insert.
+ * @param table Pointer to the table to extend.
+ * @param next Pointer to the table applied second; may be table itself.
  *
- * @return uint32_t The new length of the string, or 0 if the index was out of bounds.
+ * @return uint32_t 1 on success, 0 if a pointer is NULL.
  */
-inline uint32_t sstr_insert_char_at(StaticString *sstr, uint32_t index, char character)
+inline uint32_t sstr_translation_compose(StaticStringTranslation *table, const StaticStringTranslation *next)
 {
-    if (sstr == NULL)
+    if (table == NULL || next == NULL)
     {
         return 0;
     }
-    if (index > sstr->string_length || sstr->string_length >= SSTR_MAX_LENGTH)
+    uint8_t step[256];
+    memcpy(step, next->map, sizeof(step));
+    for (uint32_t c = 0; c < 256; c++)
     {
-        return 0;
+        table->map[c] = step[table->map[c]];
     }
+    sstr_translation_update_rows(table);
+    return 1;
+}
 
-    for (uint32_t i = sstr->string_length; i > index; --i)
-    {
-        sstr->static_string[i] = sstr->static_string[i - 1];
-    }
+// Appends ASCII uppercasing to a translation table; returns 0 if table is NULL
+inline uint32_t sstr_translation_uppercase(StaticStringTranslation *table)
+{
+    return sstr_translation_map(table, "abcdefghijklmnopqrstuvwxyz", "ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+}
 
-    sstr->static_string[index] = character;
-    sstr->string_length++;
-    sstr->static_string[sstr->string_length] = '\0';
+// Appends ASCII lowercasing to a translation table; returns 0 if table is NULL
+inline uint32_t sstr_translation_lowercase(StaticStringTranslation *table)
+{
+    return sstr_translation_map(table, "ABCDEFGHIJKLMNOPQRSTUVWXYZ", "abcdefghijklmnopqrstuvwxyz");
+}
 
-    return sstr->string_length;
+// Same as sstr_translation_init() followed by sstr_translation_map(), returning the table by value
+inline StaticStringTranslation sstr_translation_make(const char *from, const char *to)
+{
+    StaticStringTranslation table;
+    sstr_translation_init(&table);
+    sstr_translation_map(&table, from, to);
+    return table;
 }
 
 /**
- * @brief Removes a single character from a StaticString at a given index.
- *
- * Shifts all characters at and after the given index to the left by one position
- * and removes the character at the specified index. If the index is greater
- * than the current string length, the function does not modify the string.
- *
- * @param sstr Pointer to the StaticString to modify.
- * @param index Zero-based index of the character to remove.
+ * @brief Table of kernel functions for one instruction set.
  *
- * @return uint32_t The new length of the string.
+ * Kernels take the string length explicitly and never read past it, except
+ * copy_cstr, which may read beyond the source terminator within the same page.
  */
-inline uint32_t sstr_remove_at(StaticString *sstr, uint32_t index)
+typedef struct
 {
-    if (sstr == NULL)
-    {
-        return 0;
-    }
-    if (index >= sstr->string_length)
-    {
-        return sstr->string_length;
-    }
+    int level;                                                             // SSTR_SIMD_* level of this table
+    uint32_t (*equals)(const char *data1, const char *data2, uint32_t length); // 1 if the first length bytes match
+    uint32_t (*count_char)(const char *data, uint32_t length, char ch);    // Number of occurrences of ch
+    uint32_t (*find_char)(const char *data, uint32_t length, char ch);     // Index of the first ch, or length
+    uint32_t (*find_char_reverse)(const char *data, uint32_t length, char ch); // Index of the last ch, or length
+    uint32_t (*flip_case)(char *data, uint32_t length, char first);        // XOR 0x20 on [first, first + 25], returns count
+    uint32_t (*copy_cstr)(char *dest, const char *src, uint32_t limit);   // Copies src up to its terminator or limit chars, returns count
+    uint32_t (*mismatch)(const char *data1, const char *data2, uint32_t length); // Index of the first differing byte, or length
+    uint32_t (*find_pair)(const char *data, uint32_t length, char first, char last, uint32_t distance); // First i with data[i] == first and data[i + distance] == last, or length
+    uint32_t (*find_pair_reverse)(const char *data, uint32_t length, char first, char last, uint32_t distance); // Last such i, or length
+    uint64_t (*char_mask)(const char *data, uint32_t length, char ch);    // Bit i set if data[i] == ch, for i < min(length, 64)
+    uint32_t (*compact_class)(char *data, uint32_t length, const StaticStringCharClass *cls); // Removes bytes in cls in place, returns the new length
+    uint32_t (*span_class)(const char *data, uint32_t length, const StaticStringCharClass *cls); // Number of leading bytes in cls
+    uint32_t (*span_class_reverse)(const char *data, uint32_t length, const StaticStringCharClass *cls); // Number of trailing bytes in cls
+    uint32_t (*copy_cstr_flip_case)(char *dest, const char *src, uint32_t limit, char first); // copy_cstr with flip_case applied on the way
+    uint32_t (*imismatch)(const char *data1, const char *data2, uint32_t length); // mismatch ignoring ASCII case
+    uint32_t (*ifind_pair)(const char *data, uint32_t length, char first, char last, uint32_t distance); // find_pair ignoring ASCII case; first and last are lowercase
+    uint32_t (*find_class)(const char *data, uint32_t length, const StaticStringCharClass *cls); // Index of the first byte in cls, or length
+    uint64_t (*class_mask)(const char *data, uint32_t length, const StaticStringCharClass *cls); // Bit i set if data[i] is in cls, for i < min(length, 64)
+    uint32_t (*translate)(char *data, uint32_t length, const StaticStringTranslation *table); // Maps every byte through table, returns the number changed
+} SStrKernels;
 
-    for (int i = index; i < sstr->string_length - 1; i++)
-    {
-        sstr->static_string[i] = sstr->static_string[i + 1];
-    }
-    sstr->static_string[sstr->string_length - 1] = '\0';
-    sstr->string_length--;
-    return sstr->string_length;
+inline uint32_t sstr_popcount64(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_popcountll(value);
+#else
+    value = value - ((value >> 1) & 0x5555555555555555ULL);
+    value = (value & 0x3333333333333333ULL) + ((value >> 2) & 0x3333333333333333ULL);
+    value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (uint32_t)((value * 0x0101010101010101ULL) >> 56);
+#endif
 }
 
-/**
- * @brief Removes a range of characters from a StaticString.
- *
- * Shifts all characters at and after the given start index to the left by the
- * given range length and removes the characters at the specified range.
- * If the start index is greater than the current string length, the function
- * does not modify the string.
- *
- * @param sstr Pointer to the StaticString to modify.
- * @param start Zero-based index of the first character to remove.
- * @param end Zero-based index of the last character to remove.
- *
- * @return uint32_t The new length of the string.
- */
-inline uint32_t sstr_remove_range(StaticString *sstr, uint32_t start, uint32_t end)
+// Index of the lowest set bit; value must be non-zero
+inline uint32_t sstr_ctz64(uint64_t value)
 {
-    if (sstr == NULL)
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_ctzll(value);
+#else
+    uint32_t index = 0;
+    while ((value & 1) == 0)
     {
-        return 0;
-    }
-    if (start >= sstr->string_length || end >= sstr->string_length || start > end)
-    {
-        return sstr->string_length;
+        value >>= 1;
+        index++;
     }
+    return index;
+#endif
+}
 
-    for (uint32_t i = end + 1; i < sstr->string_length; i++)
+// Index of the highest set bit; value must be non-zero
+inline uint32_t sstr_bsr64(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - (uint32_t)__builtin_clzll(value);
+#else
+    uint32_t index = 63;
+    while ((value >> index) == 0)
     {
-        sstr->static_string[i - (end - start + 1)] = sstr->static_string[i];
+        index--;
     }
+    return index;
+#endif
+}
 
-    sstr->string_length = sstr->string_length - (end - start + 1);
-    sstr->static_string[sstr->string_length] = '\0';
+// Unaligned 64-bit load; compiles to a single mov on targets that allow it
+inline uint64_t sstr_load64(const char *data)
+{
+    uint64_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
 
-    return sstr->string_length;
+inline void sstr_store64(char *data, uint64_t value)
+{
+    memcpy(data, &value, sizeof(value));
+}
+
+inline uint32_t sstr_load32(const char *data)
+{
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
 }
 
 /**
- * @brief Copies a substring from one StaticString to another.
+ * @brief Compares up to 16 bytes without a loop.
  *
- * Copies a range of characters from the source StaticString to the destination
- * StaticString. The range is specified by the start and end indices, which
- * are zero-based and inclusive. The function returns 1 if the operation is
- * successful, or 0 if the start index is greater than the current string
- * length, the end index is greater than the current string length, or the
- * start index is greater than the end index.
- *
- * @param sstr_source Pointer to the source StaticString.
- * @param sstr_dest Pointer to the destination StaticString.
- * @param start Zero-based index of the first character to copy.
- * @param end Zero-based index of the last character to copy.
+ * Uses two overlapping word loads per string (first and last 8 or 4 bytes),
+ * or the first, middle and last byte for lengths below 4.
  *
- * @return uint32_t 1 if the operation is successful, 0 if the indices are invalid.
+ * @return uint32_t 1 if the first length bytes match, 0 otherwise.
  */
-inline uint32_t sstr_substring(const StaticString *sstr_source, StaticString *sstr_dest, uint32_t start, uint32_t end)
+inline uint32_t sstr_equals_small(const char *data1, const char *data2, uint32_t length)
 {
-    if (sstr_source == NULL || sstr_dest == NULL)
+    if (length >= 8)
     {
-        return 0;
+        uint64_t head = sstr_load64(data1) ^ sstr_load64(data2);
+        uint64_t tail = sstr_load64(data1 + length - 8) ^ sstr_load64(data2 + length - 8);
+        return (head | tail) == 0;
     }
-    if (start >= sstr_source->string_length || end >= sstr_source->string_length || start > end)
+    if (length >= 4)
     {
-        return 0;
+        uint32_t head = sstr_load32(data1) ^ sstr_load32(data2);
+        uint32_t tail = sstr_load32(data1 + length - 4) ^ sstr_load32(data2 + length - 4);
+        return (head | tail) == 0;
     }
-
-    sstr_dest->string_length = end - start + 1;
-    for (uint32_t i = 0; i < sstr_dest->string_length; i++)
+    if (length > 0)
     {
-        sstr_dest->static_string[i] = sstr_source->static_string[start + i];
+        return data1[0] == data2[0] && data1[length >> 1] == data2[length >> 1] && data1[length - 1] == data2[length - 1];
     }
-    sstr_dest->static_string[sstr_dest->string_length] = '\0';
     return 1;
 }
 
-/**
- * @brief Trims trailing whitespace characters from a StaticString.
- *
- * Removes whitespace characters (as defined by IS_WHITESPACE) from the end of the
- * string, updating the string length and null-terminator accordingly.
- *
- * @param sstr Pointer to the StaticString to modify.
- *
- * @return uint32_t The number of characters trimmed from the end.
- */
-inline uint32_t sstr_trim_trailing(StaticString *sstr)
+inline uint32_t sstr_kernel_equals_scalar(const char *data1, const char *data2, uint32_t length)
 {
-    if (sstr == NULL)
+    if (length <= 16)
     {
-        return 0;
+        return sstr_equals_small(data1, data2, length);
     }
-    uint32_t count = 0;
-    while (sstr->string_length > 0 && IS_WHITESPACE(sstr->static_string[sstr->string_length - 1]))
+    uint32_t i = 0;
+    for (; i + 8 <= length; i += 8)
     {
-        sstr->string_length--;
-        count++;
+        if (sstr_load64(data1 + i) != sstr_load64(data2 + i))
+        {
+            return 0;
+        }
     }
-    sstr->static_string[sstr->string_length] = '\0';
-    return count;
+    return sstr_load64(data1 + length - 8) == sstr_load64(data2 + length - 8);
 }
 
-/**
- * @brief Trims leading whitespace characters from a StaticString.
- *
- * Efficiently removes leading whitespace characters by finding the first
- * non-whitespace character and shifting the remainder of the string forward.
- *
- * @param sstr Pointer to the StaticString to modify.
- *
- * @return uint32_t The number of characters removed from the beginning.
- */
-inline uint32_t sstr_trim_leading(StaticString *sstr)
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || defined(_MSC_VER)
+#define SSTR_LITTLE_ENDIAN 1
+#else
+#define SSTR_LITTLE_ENDIAN 0
+#endif
+
+inline uint32_t sstr_kernel_mismatch_scalar(const char *data1, const char *data2, uint32_t length)
 {
-    if (sstr == NULL)
+    uint32_t i = 0;
+    for (; i + 8 <= length; i += 8)
     {
-        return 0;
+        uint64_t diff = sstr_load64(data1 + i) ^ sstr_load64(data2 + i);
+        if (diff != 0)
+        {
+#if SSTR_LITTLE_ENDIAN
+            return i + (sstr_ctz64(diff) >> 3); // Lowest differing byte is the first in memory
+#else
+            break;
+#endif
+        }
     }
-
-    uint32_t offset = 0;
-    while (offset < sstr->string_length && IS_WHITESPACE(sstr->static_string[offset]))
+    for (; i < length; i++)
     {
-        offset++;
+        if (data1[i] != data2[i])
+        {
+            return i;
+        }
     }
+    return length;
+}
 
-    if (offset > 0)
+/*
+ * find_pair kernels are the substring search prefilter: they locate positions
+ * whose first and last needle bytes both match, leaving the middle to be
+ * verified by the caller. Only positions i with i + distance < length are
+ * considered. The reverse variants return the last such position, for rfind.
+ */
+
+inline uint32_t sstr_kernel_find_pair_scalar(const char *data, uint32_t length, char first, char last, uint32_t distance)
+{
+    if (distance >= length)
     {
-        for (uint32_t i = 0; i <= sstr->string_length - offset; i++)
+        return length;
+    }
+    uint32_t positions = length - distance;
+    for (uint32_t i = 0; i < positions; i++)
+    {
+        if (data[i] == first && data[i + distance] == last)
         {
-            sstr->static_string[i] = sstr->static_string[i + offset];
+            return i;
         }
-        sstr->string_length -= offset;
     }
-
-    return offset;
+    return length;
 }
 
-/**
- * @brief Trims both leading and trailing whitespace characters from a StaticString.
- *
- * Calls sstr_trim_leading() and sstr_trim_trailing() to remove whitespace characters
- * from both ends of the string, updating its length and content in-place.
- *
- * @param sstr Pointer to the StaticString to modify.
- *
- * @return uint32_t The total number of characters removed.
- */
-inline uint32_t sstr_trim(StaticString *sstr)
+inline uint32_t sstr_kernel_find_pair_reverse_scalar(const char *data, uint32_t length, char first, char last, uint32_t distance)
 {
-    if (sstr == NULL)
+    if (distance >= length)
     {
-        return 0;
+        return length;
     }
-    uint32_t count = 0;
-    count += sstr_trim_leading(sstr);
-    count += sstr_trim_trailing(sstr);
-    return count;
+    for (uint32_t i = length - distance; i > 0;)
+    {
+        i--;
+        if (data[i] == first && data[i + distance] == last)
+        {
+            return i;
+        }
+    }
+    return length;
 }
 
-/**
- * @brief Removes all whitespace characters from a StaticString (optimized version).
- *
- * Uses a single pass with a write index to compact non-whitespace characters.
- *
- * @param sstr Pointer to the StaticString to modify.
- *
- * @return uint32_t The number of characters removed.
- */
-inline uint32_t sstr_strip_all_whitespace(StaticString *sstr)
+// High bit of each byte of word set exactly where the byte equals the byte repeated in pattern
+inline uint64_t sstr_byte_hits64(uint64_t word, uint64_t pattern)
 {
-    uint32_t write = 0;
-    for (uint32_t read = 0; read < sstr->string_length; read++)
+    const uint64_t low7 = 0x7F7F7F7F7F7F7F7FULL;
+    uint64_t x = word ^ pattern;
+    // Unlike the classic haszero test this has no false positives, so the hits can be counted
+    return ~(((x & low7) + low7) | x) & ~low7;
+}
+
+// Sum of the eight bytes of value
+inline uint32_t sstr_hsum_bytes64(uint64_t value)
+{
+    const uint64_t even = 0x00FF00FF00FF00FFULL;
+    uint64_t pairs = (value & even) + ((value >> 8) & even);
+    return (uint32_t)((pairs * 0x0001000100010001ULL) >> 48);
+}
+
+inline uint32_t sstr_kernel_count_char_scalar(const char *data, uint32_t length, char ch)
+{
+    const uint64_t pattern = 0x0101010101010101ULL * (uint8_t)ch;
+    // Hits are accumulated as per-byte counters and flushed before they overflow,
+    // which avoids a popcount per word (a library call without a popcnt target)
+    uint64_t acc = 0;
+    uint32_t pending = 0;
+    uint32_t count = 0;
+    uint32_t i = 0;
+    for (; i + 8 <= length; i += 8)
     {
-        if (!IS_WHITESPACE(sstr->static_string[read]))
+        acc += sstr_byte_hits64(sstr_load64(data + i), pattern) >> 7;
+        if (++pending == 255)
         {
-            sstr->static_string[write++] = sstr->static_string[read];
+            count += sstr_hsum_bytes64(acc);
+            acc = 0;
+            pending = 0;
         }
     }
-    sstr->static_string[write] = '\0';
-    uint32_t removed = sstr->string_length - write;
-    sstr->string_length = write;
-    return removed;
+    count += sstr_hsum_bytes64(acc);
+    for (; i < length; i++)
+    {
+        count += data[i] == ch;
+    }
+    return count;
 }
 
-/**
- * @brief Compares two StaticString instances for equality.
- *
- * Checks whether both strings have the same length and identical characters.
- *
- * @param sstr1 Pointer to the first StaticString.
- * @param sstr2 Pointer to the second StaticString.
- *
- * @return uint32_t 1 if the strings are equal, 0 otherwise.
- */
-inline uint32_t sstr_equals(const StaticString *sstr1, const StaticString *sstr2)
+inline uint32_t sstr_kernel_find_char_scalar(const char *data, uint32_t length, char ch)
 {
-    if (sstr1 == NULL || sstr2 == NULL)
+    uint32_t i = 0;
+#if SSTR_LITTLE_ENDIAN
+    const uint64_t pattern = 0x0101010101010101ULL * (uint8_t)ch;
+    for (; i + 8 <= length; i += 8)
     {
-        return 0;
+        uint64_t hits = sstr_byte_hits64(sstr_load64(data + i), pattern);
+        if (hits != 0)
+        {
+            return i + (sstr_ctz64(hits) >> 3);
+        }
     }
-    if (sstr1->string_length != sstr2->string_length)
+#endif
+    for (; i < length; i++)
     {
-        return 0;
+        if (data[i] == ch)
+        {
+            return i;
+        }
     }
+    return length;
+}
 
-    for (uint32_t i = 0; i < sstr1->string_length; i++)
+inline uint32_t sstr_kernel_find_char_reverse_scalar(const char *data, uint32_t length, char ch)
+{
+    uint32_t end = length;
+#if SSTR_LITTLE_ENDIAN
+    const uint64_t pattern = 0x0101010101010101ULL * (uint8_t)ch;
+    for (; end >= 8; end -= 8)
     {
-        if (sstr1->static_string[i] != sstr2->static_string[i])
+        uint64_t hits = sstr_byte_hits64(sstr_load64(data + end - 8), pattern);
+        if (hits != 0)
         {
-            return 0;
+            return end - 8 + (sstr_bsr64(hits) >> 3); // Highest hit is the last in memory
+        }
+    }
+#endif
+    while (end > 0)
+    {
+        end--;
+        if (data[end] == ch)
+        {
+            return end;
         }
     }
+    return length;
+}
 
-    return 1;
+// 0x20 in each byte of x within [first, first + 25], 0 elsewhere; first is 'a' or 'A'
+inline uint64_t sstr_case_flips64(uint64_t x, char first)
+{
+    const uint64_t ones = 0x0101010101010101ULL;
+    const uint64_t low7 = 0x7F7F7F7F7F7F7F7FULL;
+    // With the high bit cleared no byte carries into its neighbour, and the
+    // high bit of each sum tells whether the byte reached the bound
+    uint64_t ascii = x & low7;
+    uint64_t at_least_first = ascii + ones * (uint8_t)(0x80 - first);
+    uint64_t past_last = ascii + ones * (uint8_t)(0x80 - first - 26);
+    return ((at_least_first & ~past_last & ~x) >> 2) & (ones * 0x20);
 }
 
-/**
- * @brief Compares a StaticString with a null-terminated C string for equality.
- *
- * Checks whether the StaticString and the C string contain the same characters
- * and have the same length. If the C string is NULL, the function returns 0.
- *
- * @param sstr Pointer to the StaticString.
- * @param cstr Pointer to the null-terminated C string.
- *
- * @return uint32_t 1 if the strings are equal, 0 otherwise.
- */
-inline uint32_t sstr_equals_cstr(const StaticString *sstr, const char *cstr)
+inline uint32_t sstr_kernel_flip_case_scalar(char *data, uint32_t length, char first)
 {
-    if (cstr == NULL)
+    uint32_t count = 0;
+    uint32_t i = 0;
+    for (; i + 8 <= length; i += 8)
     {
-        return 0;
+        uint64_t x = sstr_load64(data + i);
+        uint64_t flips = sstr_case_flips64(x, first);
+        sstr_store64(data + i, x ^ flips);
+        count += sstr_popcount64(flips);
+    }
+    for (; i < length; i++)
+    {
+        uint32_t flip = (uint8_t)(data[i] - first) < 26;
+        data[i] ^= (char)(flip << 5);
+        count += flip;
     }
+    return count;
+}
 
-    uint32_t i = 0;
+/*
+ * Case-insensitive kernels compare characters folded to lowercase. imismatch
+ * folds only words or vectors that already differ, so strings that match
+ * exactly cost the same as with mismatch. ifind_pair receives lowercase
+ * needle bytes and ORs 0x20 into the haystack where the needle byte is a
+ * letter, since exactly the two cases of a letter map to it that way.
+ */
 
-    while (i < sstr->string_length && cstr[i] != '\0')
+inline char sstr_fold_lower(char ch)
+{
+    return (char)(ch ^ (((uint8_t)(ch - 'A') < 26) << 5));
+}
+
+// 0x20 if ch is an ASCII letter, which makes ch | result match both of its cases
+inline uint8_t sstr_letter_bit(char ch)
+{
+    return (uint8_t)((uint8_t)(((uint8_t)ch | 0x20) - 'a') < 26) << 5;
+}
+
+inline uint32_t sstr_kernel_imismatch_scalar(const char *data1, const char *data2, uint32_t length)
+{
+    uint32_t i = 0;
+    for (; i + 8 <= length; i += 8)
     {
-        if (sstr->static_string[i] != cstr[i])
+        uint64_t a = sstr_load64(data1 + i);
+        uint64_t b = sstr_load64(data2 + i);
+        if (a != b)
         {
-            return 0;
+            uint64_t diff = (a ^ sstr_case_flips64(a, 'A')) ^ (b ^ sstr_case_flips64(b, 'A'));
+            if (diff != 0)
+            {
+#if SSTR_LITTLE_ENDIAN
+                return i + (sstr_ctz64(diff) >> 3);
+#else
+                break;
+#endif
+            }
+        }
+    }
+    for (; i < length; i++)
+    {
+        if (sstr_fold_lower(data1[i]) != sstr_fold_lower(data2[i]))
+        {
+            return i;
         }
-        i++;
     }
-    return (i == sstr->string_length && cstr[i] == '\0');
+    return length;
 }
 
-/**
- * @brief Returns a pointer to the internal null-terminated C string.
- *
- * Provides read-only access to the internal character array of the StaticString.
- * The returned string is guaranteed to be null-terminated.
- *
- * @param sstr Pointer to the StaticString.
- *
- * @return const char* Pointer to the null-terminated C string.
- */
-inline const char *sstr_to_cstr(const StaticString *sstr)
+inline uint32_t sstr_kernel_ifind_pair_scalar(const char *data, uint32_t length, char first, char last, uint32_t distance)
 {
-    if (sstr == NULL)
+    if (distance >= length)
     {
-        return NULL;
+        return length;
     }
-    return sstr->static_string;
+    const char first_bit = (char)sstr_letter_bit(first);
+    const char last_bit = (char)sstr_letter_bit(last);
+    uint32_t positions = length - distance;
+    for (uint32_t i = 0; i < positions; i++)
+    {
+        if ((data[i] | first_bit) == first && (data[i + distance] | last_bit) == last)
+        {
+            return i;
+        }
+    }
+    return length;
 }
 
-/**
- * @brief Removes and returns the last character from the StaticString.
- *
- * If the StaticString is not empty, this function removes the last character,
- * updates the string length, and returns the removed character.
- * If the string is empty, it returns 0.
- *
- * @param sstr Pointer to the StaticString.
- *
- * @return char The last character if available, otherwise 0.
- */
-inline char sstr_pop(StaticString *sstr)
+inline uint64_t sstr_kernel_char_mask_scalar(const char *data, uint32_t length, char ch)
 {
-    if (sstr == NULL)
+    const uint64_t pattern = 0x0101010101010101ULL * (uint8_t)ch;
+    uint32_t limit = length < 64 ? length : 64;
+    uint64_t mask = 0;
+    uint32_t i = 0;
+#if SSTR_LITTLE_ENDIAN
+    for (; i + 8 <= limit; i += 8)
     {
-        return 0;
+        uint64_t hits = sstr_byte_hits64(sstr_load64(data + i), pattern);
+        // Gather the eight high bits into one byte, first character lowest
+        mask |= (((hits >> 7) * 0x0102040810204080ULL) >> 56) << i;
     }
-
-    char return_char = 0;
-    if (sstr->string_length > 0)
+#else
+    (void)pattern;
+#endif
+    for (; i < limit; i++)
     {
-        return_char = sstr->static_string[sstr->string_length - 1];
-        sstr->static_string[sstr->string_length - 1] = '\0';
-        sstr->string_length--;
+        mask |= (uint64_t)(data[i] == ch) << i;
     }
-    return return_char;
+    return mask;
 }
 
-/**
- * @brief Truncates the StaticString to the specified length.
- *
- * Shortens the StaticString to the given length if the new length is less than
- * or equal to the current length. Ensures the string remains null-terminated.
- *
- * @param sstr Pointer to the StaticString to truncate.
- * @param new_length The desired new length of the string.
- *
- * @return uint32_t 1 if the truncation was successful, 0 if new_length is greater than current length.
+/*
+ * copy_cstr kernels fuse the bounded strlen with the copy. They may write
+ * garbage to dest[count..limit] but never past dest[limit]; the caller writes
+ * the terminator at dest[count].
  */
-inline uint32_t sstr_truncate(StaticString *sstr, uint32_t new_length)
+
+inline uint32_t sstr_kernel_copy_cstr_scalar(char *dest, const char *src, uint32_t limit)
 {
-    if (sstr == NULL)
+    uint32_t i;
+    for (i = 0; i < limit && src[i] != '\0'; i++)
     {
-        return 0;
+        dest[i] = src[i];
     }
+    return i;
+}
 
-    if (new_length > sstr->string_length || new_length > SSTR_MAX_LENGTH)
+inline uint32_t sstr_kernel_copy_cstr_flip_case_scalar(char *dest, const char *src, uint32_t limit, char first)
+{
+    uint32_t i;
+    for (i = 0; i < limit && src[i] != '\0'; i++)
     {
-        return 0;
+        dest[i] = (char)(src[i] ^ (((uint8_t)(src[i] - first) < 26) << 5));
     }
+    return i;
+}
 
-    sstr->string_length = new_length;
-    sstr->static_string[sstr->string_length] = '\0';
-    return 1;
+// Compacts data[read, length) to data[write, ...); every byte is written back and the write
+// position advances only past kept bytes, so the loop has no branch
+inline uint32_t sstr_compact_class_tail(char *data, uint32_t read, uint32_t write, uint32_t length, const StaticStringCharClass *cls)
+{
+    for (; read < length; read++)
+    {
+        uint8_t c = (uint8_t)data[read];
+        data[write] = (char)c;
+        write += ((cls->bits[c >> 5] >> (c & 31)) & 1) ^ 1;
+    }
+    return write;
 }
 
-/**
- * @brief Returns the current length of the StaticString.
- *
- * This function provides access to the length of the string,
- * excluding the null terminator.
- *
- * @param sstr Pointer to the StaticString.
- *
- * @return uint32_t The number of characters in the string.
- */
-inline uint32_t sstr_length(const StaticString *sstr)
+inline uint32_t sstr_kernel_compact_class_scalar(char *data, uint32_t length, const StaticStringCharClass *cls)
 {
-    return sstr->string_length;
+    return sstr_compact_class_tail(data, 0, 0, length, cls);
 }
 
-/**
- * @brief Reverses the contents of the StaticString in place.
- *
- * Reverses the characters of the StaticString without allocating
- * additional memory. The operation is done in-place.
- *
- * @param sstr Pointer to the StaticString to be reversed.
- *
- * @return uint32_t 1 if the string was successfully reversed, 0 otherwise.
- */
-inline uint32_t sstr_reverse(StaticString *sstr)
+inline uint32_t sstr_kernel_span_class_scalar(const char *data, uint32_t length, const StaticStringCharClass *cls)
 {
-    if (sstr == NULL)
+    uint32_t i = 0;
+    while (i < length && sstr_char_class_contains(cls, data[i]))
     {
-        return 0;
+        i++;
     }
-    if (sstr->string_length == 0)
+    return i;
+}
+
+inline uint32_t sstr_kernel_span_class_reverse_scalar(const char *data, uint32_t length, const StaticStringCharClass *cls)
+{
+    uint32_t end = length;
+    while (end > 0 && sstr_char_class_contains(cls, data[end - 1]))
     {
-        return 0;
+        end--;
     }
-    uint32_t i = 0, j = sstr->string_length - 1;
-    while (i < j)
+    return length - end;
+}
+
+inline uint32_t sstr_kernel_find_class_scalar(const char *data, uint32_t length, const StaticStringCharClass *cls)
+{
+    uint32_t i = 0;
+    // Four independent lookups per branch
+    for (; i + 4 <= length; i += 4)
+    {
+        if (sstr_char_class_contains(cls, data[i]) | sstr_char_class_contains(cls, data[i + 1]) |
+            sstr_char_class_contains(cls, data[i + 2]) | sstr_char_class_contains(cls, data[i + 3]))
+        {
+            break;
+        }
+    }
+    while (i < length && !sstr_char_class_contains(cls, data[i]))
     {
-        char temp = sstr->static_string[i];
-        sstr->static_string[i] = sstr->static_string[j];
-        sstr->static_string[j] = temp;
         i++;
-        j--;
     }
-    return 1;
+    return i;
 }
 
-/**
- * @brief Copies the contents of one StaticString to another.
- *
- * Performs a deep copy of the contents and string length from the source
- * StaticString (`sstr2`) to the destination StaticString (`sstr1`), including
- * null-termination. Returns void if the source StaticString (`sstr2`) is too long.
- *
- * @param sstr1 Pointer to the destination StaticString.
- * @param sstr2 Pointer to the source StaticString.
- *
- * @return uint32_t 1 if the copy was successful, 0 if the source StaticString is too long.
+inline uint64_t sstr_kernel_class_mask_scalar(const char *data, uint32_t length, const StaticStringCharClass *cls)
+{
+    uint32_t limit = length < 64 ? length : 64;
+    uint64_t mask = 0;
+    for (uint32_t i = 0; i < limit; i++)
+    {
+        mask |= (uint64_t)sstr_char_class_contains(cls, data[i]) << i;
+    }
+    return mask;
+}
+
+inline uint32_t sstr_kernel_translate_scalar(char *data, uint32_t length, const StaticStringTranslation *table)
+{
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < length; i++)
+    {
+        uint8_t c = (uint8_t)data[i];
+        uint8_t mapped = table->map[c];
+        count += mapped != c;
+        data[i] = (char)mapped;
+    }
+    return count;
+}
+
+#if SSTR_HAS_X86_KERNELS
+
+/*
+ * SSE2 and AVX2 kernels process full vectors and finish with one overlapping
+ * vector ending at the last character, so no scalar tail loop is needed once
+ * the string is at least one vector long. Case conversion tolerates the
+ * overlap because already-converted characters no longer match the range.
  */
-inline uint32_t sstr_copy(StaticString *sstr1, const StaticString *sstr2)
+
+// Sums the 16 byte counters of acc into a scalar
+SSTR_TARGET("sse2")
+inline uint32_t sstr_hsum_epu8_sse2(__m128i acc)
 {
-    if (sstr1 == NULL || sstr2 == NULL)
+    __m128i sums = _mm_sad_epu8(acc, _mm_setzero_si128());
+    return (uint32_t)_mm_cvtsi128_si32(sums) + (uint32_t)_mm_extract_epi16(sums, 4);
+}
+
+SSTR_TARGET("sse2")
+inline uint32_t sstr_kernel_equals_sse2(const char *data1, const char *data2, uint32_t length)
+{
+    if (length <= 16)
     {
-        return 0;
+        return sstr_equals_small(data1, data2, length);
     }
-    if (sstr2->string_length > SSTR_MAX_LENGTH)
+    uint32_t i = 0;
+    for (; i + 16 <= length; i += 16)
     {
-        return 0;
+        __m128i a = _mm_loadu_si128((const __m128i *)(data1 + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(data2 + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) != 0xFFFF)
+        {
+            return 0;
+        }
     }
-    sstr1->string_length = sstr2->string_length;
-    for (uint32_t i = 0; i < sstr1->string_length; i++)
+    if (i < length)
     {
-        sstr1->static_string[i] = sstr2->static_string[i];
+        __m128i a = _mm_loadu_si128((const __m128i *)(data1 + length - 16));
+        __m128i b = _mm_loadu_si128((const __m128i *)(data2 + length - 16));
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) == 0xFFFF;
     }
-    sstr1->static_string[sstr1->string_length] = '\0';
     return 1;
 }
 
-/**
- * @brief Converts all lowercase letters in the StaticString to uppercase.
- *
- * Iterates through the StaticString and converts each ASCII lowercase
- * character ('a' to 'z') to its uppercase equivalent ('A' to 'Z').
- *
- * @param sstr Pointer to the StaticString to modify.
- *
- * @return uint32_t The number of characters that were converted.
- */
-inline uint32_t sstr_to_uppercase(StaticString *sstr)
+SSTR_TARGET("sse2")
+inline uint32_t sstr_kernel_count_char_sse2(const char *data, uint32_t length, char ch)
 {
-    if (sstr == NULL)
+    if (length < 16)
     {
-        return 0;
+        return sstr_kernel_count_char_scalar(data, length, ch);
     }
+    // Matches are accumulated as per-byte counters (cmpeq yields -1) and flushed before they overflow
+    const __m128i needle = _mm_set1_epi8(ch);
+    __m128i acc = _mm_setzero_si128();
+    uint32_t pending = 0;
     uint32_t count = 0;
-    for (uint32_t i = 0; i < sstr->string_length; i++)
+    uint32_t i = 0;
+    for (; i + 16 <= length; i += 16)
     {
-        if (sstr->static_string[i] >= 'a' && sstr->static_string[i] <= 'z')
+        __m128i v = _mm_loadu_si128((const __m128i *)(data + i));
+        acc = _mm_sub_epi8(acc, _mm_cmpeq_epi8(v, needle));
+        if (++pending == 255)
         {
-            sstr->static_string[i] -= 'a' - 'A';
-            count++;
+            count += sstr_hsum_epu8_sse2(acc);
+            acc = _mm_setzero_si128();
+            pending = 0;
         }
     }
+    count += sstr_hsum_epu8_sse2(acc);
+    if (i < length)
+    {
+        // Skip the lanes already counted by the last full vector
+        __m128i v = _mm_loadu_si128((const __m128i *)(data + length - 16));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle));
+        count += sstr_popcount64(mask >> (16 - (length - i)));
+    }
     return count;
 }
 
-/**
- * @brief Converts all uppercase letters in the StaticString to lowercase.
- *
- * Iterates through the StaticString and converts each ASCII uppercase
- * character ('A' to 'Z') to its lowercase equivalent ('a' to 'z').
- *
- * @param sstr Pointer to the StaticString to modify.
- *
- * @return uint32_t The number of characters that were converted.
- */
-inline uint32_t sstr_to_lowercase(StaticString *sstr)
+SSTR_TARGET("sse2")
+inline uint32_t sstr_kernel_find_char_sse2(const char *data, uint32_t length, char ch)
 {
-    if (sstr == NULL)
+    if (length < 16)
     {
-        return 0;
+        return sstr_kernel_find_char_scalar(data, length, ch);
+    }
+    const __m128i needle = _mm_set1_epi8(ch);
+    uint32_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(data + i));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle));
+        if (mask != 0)
+        {
+            return i + sstr_ctz64(mask);
+        }
+    }
+    if (i < length)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(data + length - 16));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle));
+        if (mask != 0)
+        {
+            return length - 16 + sstr_ctz64(mask);
+        }
+    }
+    return length;
+}
+
+SSTR_TARGET("sse2")
+inline uint32_t sstr_kernel_find_char_reverse_sse2(const char *data, uint32_t length, char ch)
+{
+    if (length < 16)
+    {
+        return sstr_kernel_find_char_reverse_scalar(data, length, ch);
+    }
+    const __m128i needle = _mm_set1_epi8(ch);
+    uint32_t end = length;
+    for (; end >= 16; end -= 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(data + end - 16));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle));
+        if (mask != 0)
+        {
+            return end - 16 + sstr_bsr64(mask);
+        }
+    }
+    if (end > 0)
+    {
+        // Only the first end lanes of the head vector are new
+        __m128i v = _mm_loadu_si128((const __m128i *)data);
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle)) & ((1u << end) - 1);
+        if (mask != 0)
+        {
+            return sstr_bsr64(mask);
+        }
+    }
+    return length;
+}
+
+SSTR_TARGET("sse2")
+inline uint64_t sstr_kernel_char_mask_sse2(const char *data, uint32_t length, char ch)
+{
+    if (length < 16)
+    {
+        return sstr_kernel_char_mask_scalar(data, length, ch);
+    }
+    const __m128i needle = _mm_set1_epi8(ch);
+    uint32_t limit = length < 64 ? length : 64;
+    uint64_t mask = 0;
+    uint32_t i = 0;
+    for (; i + 16 <= limit; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(data + i));
+        mask |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle)) << i;
+    }
+    if (i < limit)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(data + limit - 16));
+        mask |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle)) << (limit - 16);
+    }
+    return mask;
+}
+
+SSTR_TARGET("sse2")
+inline uint32_t sstr_kernel_flip_case_sse2(char *data, uint32_t length, char first)
+{
+    if (length < 16)
+    {
+        return sstr_kernel_flip_case_scalar(data, length, first);
     }
+    // Shifting the range start to -128 turns the unsigned range check into one signed compare
+    const __m128i shift = _mm_set1_epi8((char)(0x80 - (uint8_t)first));
+    const __m128i bound = _mm_set1_epi8((char)(-128 + 26));
+    const __m128i flip = _mm_set1_epi8(0x20);
+    __m128i acc = _mm_setzero_si128();
+    uint32_t pending = 0;
     uint32_t count = 0;
-    for (uint32_t i = 0; i < sstr->string_length; i++)
+    uint32_t i = 0;
+    for (;; i += 16)
     {
-        if (sstr->static_string[i] >= 'A' && sstr->static_string[i] <= 'Z')
+        if (i + 16 > length)
         {
-            sstr->static_string[i] += 'a' - 'A';
-            count++;
+            i = length - 16;
+        }
+        __m128i v = _mm_loadu_si128((const __m128i *)(data + i));
+        __m128i in_range = _mm_cmplt_epi8(_mm_add_epi8(v, shift), bound);
+        _mm_storeu_si128((__m128i *)(data + i), _mm_xor_si128(v, _mm_and_si128(in_range, flip)));
+        acc = _mm_sub_epi8(acc, in_range);
+        if (++pending == 255)
+        {
+            count += sstr_hsum_epu8_sse2(acc);
+            acc = _mm_setzero_si128();
+            pending = 0;
+        }
+        if (i + 16 == length)
+        {
+            break;
+        }
+    }
+    return count + sstr_hsum_epu8_sse2(acc);
+}
+
+SSTR_TARGET("avx2,popcnt")
+inline uint32_t sstr_kernel_equals_avx2(const char *data1, const char *data2, uint32_t length)
+{
+    if (length < 32)
+    {
+        return sstr_kernel_equals_sse2(data1, data2, length);
+    }
+    uint32_t i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(data1 + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(data2 + i));
+        if ((uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)) != 0xFFFFFFFFu)
+        {
+            return 0;
         }
     }
+    if (i < length)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(data1 + length - 32));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(data2 + length - 32));
+        return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)) == 0xFFFFFFFFu;
+    }
+    return 1;
+}
+
+SSTR_TARGET("avx2,popcnt")
+inline uint32_t sstr_kernel_count_char_avx2(const char *data, uint32_t length, char ch)
+{
+    if (length < 32)
+    {
+        return sstr_kernel_count_char_sse2(data, length, ch);
+    }
+    const __m256i needle = _mm256_set1_epi8(ch);
+    uint32_t count = 0;
+    uint32_t i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(data + i));
+        count += sstr_popcount64((uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, needle)));
+    }
+    if (i < length)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(data + length - 32));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, needle));
+        count += sstr_popcount64(mask >> (32 - (length - i)));
+    }
     return count;
 }
 
-/**
- * @brief Returns the number of times a character appears in a StaticString.
- *
- * Iterates through the StaticString and counts the number of occurrences of
- * the specified character.
- *
- * @param sstr Pointer to the StaticString.
- * @param ch The character to search for.
- *
- * @return uint32_t The number of times the character appears in the string.
- */
-inline uint32_t sstr_contains(const StaticString *sstr, char ch)
+SSTR_TARGET("avx2,popcnt")
+inline uint32_t sstr_kernel_find_char_avx2(const char *data, uint32_t length, char ch)
 {
-    if (sstr == NULL)
+    if (length < 32)
     {
-        return 0;
+        return sstr_kernel_find_char_sse2(data, length, ch);
+    }
+    const __m256i needle = _mm256_set1_epi8(ch);
+    uint32_t i = 0;
+    for (; i + 64 <= length; i += 64)
+    {
+        // One branch per 64 bytes; the hit is located only once one is seen
+        __m256i lo = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + i)), needle);
+        __m256i hi = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + i + 32)), needle);
+        if (_mm256_movemask_epi8(_mm256_or_si256(lo, hi)) != 0)
+        {
+            uint64_t mask = (uint32_t)_mm256_movemask_epi8(lo) | ((uint64_t)(uint32_t)_mm256_movemask_epi8(hi) << 32);
+            return i + sstr_ctz64(mask);
+        }
+    }
+    for (; i + 32 <= length; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(data + i));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, needle));
+        if (mask != 0)
+        {
+            return i + sstr_ctz64(mask);
+        }
+    }
+    if (i < length)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(data + length - 32));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, needle));
+        if (mask != 0)
+        {
+            return length - 32 + sstr_ctz64(mask);
+        }
+    }
+    return length;
+}
+
+SSTR_TARGET("avx2,popcnt")
+inline uint32_t sstr_kernel_find_char_reverse_avx2(const char *data, uint32_t length, char ch)
+{
+    if (length < 32)
+    {
+        return sstr_kernel_find_char_reverse_sse2(data, length, ch);
+    }
+    const __m256i needle = _mm256_set1_epi8(ch);
+    uint32_t end = length;
+    for (; end >= 64; end -= 64)
+    {
+        __m256i lo = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + end - 64)), needle);
+        __m256i hi = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + end - 32)), needle);
+        if (_mm256_movemask_epi8(_mm256_or_si256(lo, hi)) != 0)
+        {
+            uint64_t mask = (uint32_t)_mm256_movemask_epi8(lo) | ((uint64_t)(uint32_t)_mm256_movemask_epi8(hi) << 32);
+            return end - 64 + sstr_bsr64(mask);
+        }
+    }
+    for (; end >= 32; end -= 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(data + end - 32));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, needle));
+        if (mask != 0)
+        {
+            return end - 32 + sstr_bsr64(mask);
+        }
+    }
+    if (end > 0)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i *)data);
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, needle)) & ((1u << end) - 1);
+        if (mask != 0)
+        {
+            return sstr_bsr64(mask);
+        }
+    }
+    return length;
+}
+
+SSTR_TARGET("avx2,popcnt")
+inline uint64_t sstr_kernel_char_mask_avx2(const char *data, uint32_t length, char ch)
+{
+    if (length < 32)
+    {
+        return sstr_kernel_char_mask_sse2(data, length, ch);
+    }
+    const __m256i needle = _mm256_set1_epi8(ch);
+    __m256i low = _mm256_loadu_si256((const __m256i *)data);
+    uint64_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, needle));
+    if (length > 32)
+    {
+        // Second vector ends at min(length, 64) and may overlap the first
+        uint32_t offset = (length < 64 ? length : 64) - 32;
+        __m256i high = _mm256_loadu_si256((const __m256i *)(data + offset));
+        mask |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, needle)) << offset;
+    }
+    return mask;
+}
+
+SSTR_TARGET("avx2,popcnt")
+inline uint32_t sstr_kernel_flip_case_avx2(char *data, uint32_t length, char first)
+{
+    if (length < 32)
+    {
+        return sstr_kernel_flip_case_sse2(data, length, first);
     }
+    const __m256i shift = _mm256_set1_epi8((char)(0x80 - (uint8_t)first));
+    const __m256i bound = _mm256_set1_epi8((char)(-128 + 26));
+    const __m256i flip = _mm256_set1_epi8(0x20);
     uint32_t count = 0;
-    for (uint32_t i = 0; i < sstr->string_length; i++)
+    uint32_t i = 0;
+    for (;; i += 32)
     {
-        if (sstr->static_string[i] == ch)
+        if (i + 32 > length)
         {
-            count++;
+            i = length - 32;
+        }
+        __m256i v = _mm256_loadu_si256((const __m256i *)(data + i));
+        __m256i in_range = _mm256_cmpgt_epi8(bound, _mm256_add_epi8(v, shift));
+        _mm256_storeu_si256((__m256i *)(data + i), _mm256_xor_si256(v, _mm256_and_si256(in_range, flip)));
+        count += sstr_popcount64((uint32_t)_mm256_movemask_epi8(in_range));
+        if (i + 32 == length)
+        {
+            break;
         }
     }
     return count;
 }
 
-/**
- * @brief Finds the first occurrence of a character in a StaticString.
- *
- * Searches the StaticString for the specified character and returns the
- * zero-based index of its first occurrence. If the character is not found,
- * the function returns -1.
- *
- * @param sstr Pointer to the StaticString to search.
- * @param ch The character to find.
- *
- * @return int32_t The index of the first occurrence of the character, or -1 if not found.
- */
-inline int32_t sstr_first_index_of(const StaticString *sstr, char ch)
+SSTR_TARGET("sse2")
+inline uint32_t sstr_kernel_mismatch_sse2(const char *data1, const char *data2, uint32_t length)
 {
-    if (sstr == NULL)
+    if (length < 16)
     {
-        return -1;
+        return sstr_kernel_mismatch_scalar(data1, data2, length);
     }
-    for (uint32_t i = 0; i < sstr->string_length; i++)
+    for (uint32_t i = 0;; i += 16)
     {
-        if (sstr->static_string[i] == ch)
+        if (i + 16 > length)
+        {
+            i = length - 16;
+        }
+        __m128i a = _mm_loadu_si128((const __m128i *)(data1 + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(data2 + i));
+        uint32_t diff = ~(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) & 0xFFFFu;
+        if (diff != 0)
+        {
+            return i + sstr_ctz64(diff);
+        }
+        if (i + 16 == length)
         {
-            return (int32_t)i;
+            return length;
         }
     }
-    return -1;
 }
 
-/**
- * @brief Finds the last occurrence of a character in a StaticString.
- *
- * Searches the StaticString in reverse order for the specified character
- * and returns the zero-based index of its last occurrence. If the character
- * is not found, the function returns -1.
- *
- * @param sstr Pointer to the StaticString to search.
- * @param ch The character to find.
- *
- * @return int32_t The index of the last occurrence of the character, or -1 if not found.
- */
-inline int32_t sstr_last_index_of(const StaticString *sstr, char ch)
+SSTR_TARGET("avx2,popcnt")
+inline uint32_t sstr_kernel_mismatch_avx2(const char *data1, const char *data2, uint32_t length)
 {
-    if (sstr == NULL)
+    if (length < 32)
     {
-        return -1;
+        return sstr_kernel_mismatch_sse2(data1, data2, length);
     }
-    for (uint32_t i = sstr->string_length - 1; i >= 0; i--)
+    for (uint32_t i = 0;; i += 32)
     {
-        if (sstr->static_string[i] == ch)
+        if (i + 32 > length)
+        {
+            i = length - 32;
+        }
+        __m256i a = _mm256_loadu_si256((const __m256i *)(data1 + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(data2 + i));
+        uint32_t diff = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b));
+        if (diff != 0)
+        {
+            return i + sstr_ctz64(diff);
+        }
+        if (i + 32 == length)
         {
-            return (int32_t)i;
+            return length;
+        }
+    }
+}
+
+SSTR_TARGET("sse2")
+inline uint32_t sstr_kernel_find_pair_sse2(const char *data, uint32_t length, char first, char last, uint32_t distance)
+{
+    if (distance >= length || length - distance < 16)
+    {
+        return sstr_kernel_find_pair_scalar(data, length, first, last, distance);
+    }
+    const __m128i first_v = _mm_set1_epi8(first);
+    const __m128i last_v = _mm_set1_epi8(last);
+    uint32_t positions = length - distance;
+    for (uint32_t i = 0;; i += 16)
+    {
+        if (i + 16 > positions)
+        {
+            i = positions - 16;
+        }
+        __m128i head = _mm_loadu_si128((const __m128i *)(data + i));
+        __m128i tail = _mm_loadu_si128((const __m128i *)(data + i + distance));
+        __m128i both = _mm_and_si128(_mm_cmpeq_epi8(head, first_v), _mm_cmpeq_epi8(tail, last_v));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(both);
+        if (mask != 0)
+        {
+            return i + sstr_ctz64(mask);
+        }
+        if (i + 16 == positions)
+        {
+            return length;
+        }
+    }
+}
+
+SSTR_TARGET("sse2")
+inline uint32_t sstr_kernel_find_pair_reverse_sse2(const char *data, uint32_t length, char first, char last, uint32_t distance)
+{
+    if (distance >= length || length - distance < 16)
+    {
+        return sstr_kernel_find_pair_reverse_scalar(data, length, first, last, distance);
+    }
+    const __m128i first_v = _mm_set1_epi8(first);
+    const __m128i last_v = _mm_set1_epi8(last);
+    for (uint32_t end = length - distance;; end -= 16)
+    {
+        if (end < 16)
+        {
+            end = 16; // Lanes at or above the previous end were already checked and had no hit
+        }
+        __m128i head = _mm_loadu_si128((const __m128i *)(data + end - 16));
+        __m128i tail = _mm_loadu_si128((const __m128i *)(data + end - 16 + distance));
+        __m128i both = _mm_and_si128(_mm_cmpeq_epi8(head, first_v), _mm_cmpeq_epi8(tail, last_v));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(both);
+        if (mask != 0)
+        {
+            return end - 16 + sstr_bsr64(mask);
+        }
+        if (end == 16)
+        {
+            return length;
         }
     }
-    return -1;
 }
 
-#endif
\ No newline at end of file
+SSTR_TARGET("avx2,popcnt")
+inline uint32_t sstr_kernel_find_pair_avx2(const char *data, uint32_t length, char first, char last, uint32_t distance)
+{
+    if (distance >= length || length - distance < 32)
+    {
+        return sstr_kernel_find_pair_sse2(data, length, first, last, distance);
+    }
+    const __m256i first_v = _mm256_set1_epi8(first);
+    const __m256i last_v = _mm256_set1_epi8(last);
+    uint32_t positions = length - distance;
+    for (uint32_t i = 0;; i += 32)
+    {
+        if (i + 32 > positions)
+        {
+            i = positions - 32;
+        }
+        __m256i head = _mm256_loadu_si256((const __m256i *)(data + i));
+        __m256i tail = _mm256_loadu_si256((const __m256i *)(data + i + distance));
+        __m256i both = _mm256_and_si256(_mm256_cmpeq_epi8(head, first_v), _mm256_cmpeq_epi8(tail, last_v));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(both);
+        if (mask != 0)
+        {
+            return i + sstr_ctz64(mask);
+        }
+        if (i + 32 == positions)
+        {
+            return length;
+        }
+    }
+}
+
+SSTR_TARGET("avx2,popcnt")
+inline uint32_t sstr_kernel_find_pair_reverse_avx2(const char *data, uint32_t length, char first, char last, uint32_t distance)
+{
+    if (distance >= length || length - distance < 32)
+    {
+        return sstr_kernel_find_pair_reverse_sse2(data, length, first, last, distance);
+    }
+    const __m256i first_v = _mm256_set1_epi8(first);
+    const __m256i last_v = _mm256_set1_epi8(last);
+    for (uint32_t end = length - distance;; end -= 32)
+    {
+        if (end < 32)
+        {
+            end = 32;
+        }
+        __m256i head = _mm256_loadu_si256((const __m256i *)(data + end - 32));
+        __m256i tail = _mm256_loadu_si256((const __m256i *)(data + end - 32 + distance));
+        __m256i both = _mm256_and_si256(_mm256_cmpeq_epi8(head, first_v), _mm256_cmpeq_epi8(tail, last_v));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(both);
+        if (mask != 0)
+        {
+            return end - 32 + sstr_bsr64(mask);
+        }
+        if (end == 32)
+        {
+            return length;
+        }
+    }
+}
+
+SSTR_TARGET("sse2")
+inline __m128i sstr_fold_lower_sse2(__m128i v)
+{
+    __m128i upper = _mm_cmplt_epi8(_mm_add_epi8(v, _mm_set1_epi8((char)(0x80 - 'A'))), _mm_set1_epi8((char)(-128 + 26)));
+    return _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+
+SSTR_TARGET("sse2")
+inline uint32_t sstr_kernel_imismatch_sse2(const char *data1, const char *data2, uint32_t length)
+{
+    if (length < 16)
+    {
+        return sstr_kernel_imismatch_scalar(data1, data2, length);
+    }
+    for (uint32_t i = 0;; i += 16)
+    {
+        if (i + 16 > length)
+        {
+            i = length - 16;
+        }
+        __m128i a = _mm_loadu_si128((const __m128i *)(data1 + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(data2 + i));
+        uint32_t diff = ~(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) & 0xFFFFu;
+        if (diff != 0)
+        {
+            diff = ~(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(sstr_fold_lower_sse2(a), sstr_fold_lower_sse2(b))) & 0xFFFFu;
+            if (diff != 0)
+            {
+                return i + sstr_ctz64(diff);
+            }
+        }
+        if (i + 16 == length)
+        {
+            return length;
+        }
+    }
+}
+
+SSTR_TARGET("sse2")
+inline uint32_t sstr_kernel_ifind_pair_sse2(const char *data, uint32_t length, char first, char last, uint32_t distance)
+{
+    if (distance >= length || length - distance < 16)
+    {
+        return sstr_kernel_ifind_pair_scalar(data, length, first, last, distance);
+    }
+    const __m128i first_v = _mm_set1_epi8(first);
+    const __m128i last_v = _mm_set1_epi8(last);
+    const __m128i first_bit = _mm_set1_epi8((char)sstr_letter_bit(first));
+    const __m128i last_bit = _mm_set1_epi8((char)sstr_letter_bit(last));
+    uint32_t positions = length - distance;
+    for (uint32_t i = 0;; i += 16)
+    {
+        if (i + 16 > positions)
+        {
+            i = positions - 16;
+        }
+        __m128i head = _mm_or_si128(_mm_loadu_si128((const __m128i *)(data + i)), first_bit);
+        __m128i tail = _mm_or_si128(_mm_loadu_si128((const __m128i *)(data + i + distance)), last_bit);
+        __m128i both = _mm_and_si128(_mm_cmpeq_epi8(head, first_v), _mm_cmpeq_epi8(tail, last_v));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(both);
+        if (mask != 0)
+        {
+            return i + sstr_ctz64(mask);
+        }
+        if (i + 16 == positions)
+        {
+            return length;
+        }
+    }
+}
+
+SSTR_TARGET("avx2,popcnt")
+inline __m256i sstr_fold_lower_avx2(__m256i v)
+{
+    __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(-128 + 26)), _mm256_add_epi8(v, _mm256_set1_epi8((char)(0x80 - 'A'))));
+    return _mm256_or_si256(v, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+}
+
+SSTR_TARGET("avx2,popcnt")
+inline uint32_t sstr_kernel_imismatch_avx2(const char *data1, const char *data2, uint32_t length)
+{
+    if (length < 32)
+    {
+        return sstr_kernel_imismatch_sse2(data1, data2, length);
+    }
+    for (uint32_t i = 0;; i += 32)
+    {
+        if (i + 32 > length)
+        {
+            i = length - 32;
+        }
+        __m256i a = _mm256_loadu_si256((const __m256i *)(data1 + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(data2 + i));
+        uint32_t diff = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b));
+        if (diff != 0)
+        {
+            diff = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(sstr_fold_lower_avx2(a), sstr_fold_lower_avx2(b)));
+            if (diff != 0)
+            {
+                return i + sstr_ctz64(diff);
+            }
+        }
+        if (i + 32 == length)
+        {
+            return length;
+        }
+    }
+}
+
+SSTR_TARGET("avx2,popcnt")
+inline uint32_t sstr_kernel_ifind_pair_avx2(const char *data, uint32_t length, char first, char last, uint32_t distance)
+{
+    if (distance >= length || length - distance < 32)
+    {
+        return sstr_kernel_ifind_pair_sse2(data, length, first, last, distance);
+    }
+    const __m256i first_v = _mm256_set1_epi8(first);
+    const __m256i last_v = _mm256_set1_epi8(last);
+    const __m256i first_bit = _mm256_set1_epi8((char)sstr_letter_bit(first));
+    const __m256i last_bit = _mm256_set1_epi8((char)sstr_letter_bit(last));
+    uint32_t positions = length - distance;
+    for (uint32_t i = 0;; i += 32)
+    {
+        if (i + 32 > positions)
+        {
+            i = positions - 32;
+        }
+        __m256i head = _mm256_or_si256(_mm256_loadu_si256((const __m256i *)(data + i)), first_bit);
+        __m256i tail = _mm256_or_si256(_mm256_loadu_si256((const __m256i *)(data + i + distance)), last_bit);
+        __m256i both = _mm256_and_si256(_mm256_cmpeq_epi8(head, first_v), _mm256_cmpeq_epi8(tail, last_v));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(both);
+        if (mask != 0)
+        {
+            return i + sstr_ctz64(mask);
+        }
+        if (i + 32 == positions)
+        {
+            return length;
+        }
+    }
+}
+
+// Bytes left before src crosses into the next page
+inline uint32_t sstr_page_remaining(const char *src)
+{
+    return SSTR_PAGE_SIZE - (uint32_t)((uintptr_t)src & (SSTR_PAGE_SIZE - 1));
+}
+
+// Returns p unchanged, but the optimizer no longer knows which object it points into
+inline const char *sstr_opaque_ptr(const char *p)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __asm__("" : "+r"(p));
+#endif
+    return p;
+}
+
+/*
+ * Vector copy_cstr kernels load a full vector only when it stays within the
+ * current page, so reading past the terminator cannot fault. Near a page end
+ * they step byte by byte until the boundary is crossed. Inlined with a string
+ * literal, GCC would flag those reads as out of bounds, so the SSE2 and AVX2
+ * kernels take src through sstr_opaque_ptr().
+ */
+
+SSTR_NO_SANITIZE_ADDRESS SSTR_TARGET("sse2")
+inline uint32_t sstr_kernel_copy_cstr_sse2(char *dest, const char *src, uint32_t limit)
+{
+    src = sstr_opaque_ptr(src);
+    const __m128i zero = _mm_setzero_si128();
+    uint32_t i = 0;
+    while (i < limit)
+    {
+        if (limit - i >= 16 && sstr_page_remaining(src + i) >= 16)
+        {
+            __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+            _mm_storeu_si128((__m128i *)(dest + i), v);
+            uint32_t terminators = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero));
+            if (terminators != 0)
+            {
+                return i + sstr_ctz64(terminators);
+            }
+            i += 16;
+        }
+        else
+        {
+            if (src[i] == '\0')
+            {
+                return i;
+            }
+            dest[i] = src[i];
+            i++;
+        }
+    }
+    return i;
+}
+
+SSTR_NO_SANITIZE_ADDRESS SSTR_TARGET("avx2,popcnt")
+inline uint32_t sstr_kernel_copy_cstr_avx2(char *dest, const char *src, uint32_t limit)
+{
+    src = sstr_opaque_ptr(src);
+    const __m256i zero = _mm256_setzero_si256();
+    uint32_t i = 0;
+    while (i < limit)
+    {
+        if (limit - i >= 32 && sstr_page_remaining(src + i) >= 32)
+        {
+            __m256i v = _mm256_loadu_si256((const __m256i *)(src + i));
+            _mm256_storeu_si256((__m256i *)(dest + i), v);
+            uint32_t terminators = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, zero));
+            if (terminators != 0)
+            {
+                return i + sstr_ctz64(terminators);
+            }
+            i += 32;
+        }
+        else
+        {
+            if (src[i] == '\0')
+            {
+                return i;
+            }
+            dest[i] = src[i];
+            i++;
+        }
+    }
+    return i;
+}
+
+SSTR_NO_SANITIZE_ADDRESS SSTR_TARGET("sse2")
+inline uint32_t sstr_kernel_copy_cstr_flip_case_sse2(char *dest, const char *src, uint32_t limit, char first)
+{
+    src = sstr_opaque_ptr(src);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i shift = _mm_set1_epi8((char)(0x80 - (uint8_t)first));
+    const __m128i bound = _mm_set1_epi8((char)(-128 + 26));
+    const __m128i flip = _mm_set1_epi8(0x20);
+    uint32_t i = 0;
+    while (i < limit)
+    {
+        if (limit - i >= 16 && sstr_page_remaining(src + i) >= 16)
+        {
+            __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+            __m128i in_range = _mm_cmplt_epi8(_mm_add_epi8(v, shift), bound);
+            _mm_storeu_si128((__m128i *)(dest + i), _mm_xor_si128(v, _mm_and_si128(in_range, flip)));
+            uint32_t terminators = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero));
+            if (terminators != 0)
+            {
+                return i + sstr_ctz64(terminators);
+            }
+            i += 16;
+        }
+        else
+        {
+            if (src[i] == '\0')
+            {
+                return i;
+            }
+            dest[i] = (char)(src[i] ^ (((uint8_t)(src[i] - first) < 26) << 5));
+            i++;
+        }
+    }
+    return i;
+}
+
+SSTR_NO_SANITIZE_ADDRESS SSTR_TARGET("avx2,popcnt")
+inline uint32_t sstr_kernel_copy_cstr_flip_case_avx2(char *dest, const char *src, uint32_t limit, char first)
+{
+    src = sstr_opaque_ptr(src);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i shift = _mm256_set1_epi8((char)(0x80 - (uint8_t)first));
+    const __m256i bound = _mm256_set1_epi8((char)(-128 + 26));
+    const __m256i flip = _mm256_set1_epi8(0x20);
+    uint32_t i = 0;
+    while (i < limit)
+    {
+        if (limit - i >= 32 && sstr_page_remaining(src + i) >= 32)
+        {
+            __m256i v = _mm256_loadu_si256((const __m256i *)(src + i));
+            __m256i in_range = _mm256_cmpgt_epi8(bound, _mm256_add_epi8(v, shift));
+            _mm256_storeu_si256((__m256i *)(dest + i), _mm256_xor_si256(v, _mm256_and_si256(in_range, flip)));
+            uint32_t terminators = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, zero));
+            if (terminators != 0)
+            {
+                return i + sstr_ctz64(terminators);
+            }
+            i += 32;
+        }
+        else
+        {
+            if (src[i] == '\0')
+            {
+                return i;
+            }
+            dest[i] = (char)(src[i] ^ (((uint8_t)(src[i] - first) < 26) << 5));
+            i++;
+        }
+    }
+    return i;
+}
+
+/*
+ * AVX-512BW kernels use masked loads and stores for the tail, which never
+ * fault on the bytes outside the mask.
+ */
+
+// Mask selecting the first `remaining` lanes of a 64-byte vector
+inline uint64_t sstr_lane_mask64(uint32_t remaining)
+{
+    return remaining >= 64 ? ~0ULL : ((1ULL << remaining) - 1);
+}
+
+SSTR_TARGET("avx512bw,popcnt")
+inline uint32_t sstr_kernel_equals_avx512bw(const char *data1, const char *data2, uint32_t length)
+{
+    for (uint32_t i = 0; i < length; i += 64)
+    {
+        __mmask64 lanes = sstr_lane_mask64(length - i);
+        __m512i a = _mm512_maskz_loadu_epi8(lanes, data1 + i);
+        __m512i b = _mm512_maskz_loadu_epi8(lanes, data2 + i);
+        if (_mm512_cmpneq_epi8_mask(a, b) != 0)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+SSTR_TARGET("avx512bw,popcnt")
+inline uint32_t sstr_kernel_count_char_avx512bw(const char *data, uint32_t length, char ch)
+{
+    const __m512i needle = _mm512_set1_epi8(ch);
+    uint32_t count = 0;
+    uint32_t i = 0;
+    for (; i + 64 <= length; i += 64)
+    {
+        __m512i v = _mm512_loadu_si512((const void *)(data + i));
+        count += sstr_popcount64(_mm512_cmpeq_epi8_mask(v, needle));
+    }
+    if (i < length)
+    {
+        __mmask64 lanes = sstr_lane_mask64(length - i);
+        __m512i v = _mm512_maskz_loadu_epi8(lanes, data + i);
+        count += sstr_popcount64(_mm512_mask_cmpeq_epi8_mask(lanes, v, needle));
+    }
+    return count;
+}
+
+SSTR_TARGET("avx512bw,popcnt")
+inline uint32_t sstr_kernel_find_char_avx512bw(const char *data, uint32_t length, char ch)
+{
+    const __m512i needle = _mm512_set1_epi8(ch);
+    uint32_t i = 0;
+    for (; i + 64 <= length; i += 64)
+    {
+        __m512i v = _mm512_loadu_si512((const void *)(data + i));
+        uint64_t mask = _mm512_cmpeq_epi8_mask(v, needle);
+        if (mask != 0)
+        {
+            return i + sstr_ctz64(mask);
+        }
+    }
+    if (i < length)
+    {
+        __mmask64 lanes = sstr_lane_mask64(length - i);
+        __m512i v = _mm512_maskz_loadu_epi8(lanes, data + i);
+        uint64_t mask = _mm512_mask_cmpeq_epi8_mask(lanes, v, needle);
+        if (mask != 0)
+        {
+            return i + sstr_ctz64(mask);
+        }
+    }
+    return length;
+}
+
+SSTR_TARGET("avx512bw,popcnt")
+inline uint32_t sstr_kernel_find_char_reverse_avx512bw(const char *data, uint32_t length, char ch)
+{
+    const __m512i needle = _mm512_set1_epi8(ch);
+    uint32_t end = length;
+    for (; end >= 64; end -= 64)
+    {
+        __m512i v = _mm512_loadu_si512((const void *)(data + end - 64));
+        uint64_t mask = _mm512_cmpeq_epi8_mask(v, needle);
+        if (mask != 0)
+        {
+            return end - 64 + sstr_bsr64(mask);
+        }
+    }
+    if (end > 0)
+    {
+        __mmask64 lanes = sstr_lane_mask64(end);
+        __m512i v = _mm512_maskz_loadu_epi8(lanes, data);
+        uint64_t mask = _mm512_mask_cmpeq_epi8_mask(lanes, v, needle);
+        if (mask != 0)
+        {
+            return sstr_bsr64(mask);
+        }
+    }
+    return length;
+}
+
+SSTR_TARGET("avx512bw,popcnt")
+inline uint64_t sstr_kernel_char_mask_avx512bw(const char *data, uint32_t length, char ch)
+{
+    __mmask64 lanes = sstr_lane_mask64(length);
+    __m512i v = _mm512_maskz_loadu_epi8(lanes, data);
+    return _mm512_mask_cmpeq_epi8_mask(lanes, v, _mm512_set1_epi8(ch));
+}
+
+SSTR_TARGET("avx512bw,popcnt")
+inline uint32_t sstr_kernel_flip_case_avx512bw(char *data, uint32_t length, char first)
+{
+    const __m512i shift = _mm512_set1_epi8((char)(0x80 - (uint8_t)first));
+    const __m512i bound = _mm512_set1_epi8((char)(-128 + 26));
+    const __m512i flip = _mm512_set1_epi8(0x20);
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < length; i += 64)
+    {
+        __mmask64 lanes = sstr_lane_mask64(length - i);
+        __m512i v = _mm512_maskz_loadu_epi8(lanes, data + i);
+        __mmask64 in_range = _mm512_mask_cmplt_epi8_mask(lanes, _mm512_add_epi8(v, shift), bound);
+        _mm512_mask_storeu_epi8(data + i, in_range, _mm512_xor_si512(v, flip));
+        count += sstr_popcount64(in_range);
+    }
+    return count;
+}
+
+SSTR_NO_SANITIZE_ADDRESS SSTR_TARGET("avx512bw,popcnt")
+inline uint32_t sstr_kernel_copy_cstr_avx512bw(char *dest, const char *src, uint32_t limit)
+{
+    // Lanes are clipped to the current page so masked loads never touch the next one
+    const __m512i zero = _mm512_setzero_si512();
+    uint32_t i = 0;
+    while (i < limit)
+    {
+        uint32_t lanes_count = limit - i;
+        uint32_t page_left = sstr_page_remaining(src + i);
+        if (page_left < lanes_count)
+        {
+            lanes_count = page_left;
+        }
+        __mmask64 lanes = sstr_lane_mask64(lanes_count);
+        __m512i v = _mm512_maskz_loadu_epi8(lanes, src + i);
+        uint64_t terminators = _mm512_mask_cmpeq_epi8_mask(lanes, v, zero);
+        if (terminators != 0)
+        {
+            uint32_t count = sstr_ctz64(terminators);
+            _mm512_mask_storeu_epi8(dest + i, sstr_lane_mask64(count), v);
+            return i + count;
+        }
+        _mm512_mask_storeu_epi8(dest + i, lanes, v);
+        i += lanes_count < 64 ? lanes_count : 64;
+    }
+    return i;
+}
+
+SSTR_NO_SANITIZE_ADDRESS SSTR_TARGET("avx512bw,popcnt")
+inline uint32_t sstr_kernel_copy_cstr_flip_case_avx512bw(char *dest, const char *src, uint32_t limit, char first)
+{
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i shift = _mm512_set1_epi8((char)(0x80 - (uint8_t)first));
+    const __m512i bound = _mm512_set1_epi8((char)(-128 + 26));
+    const __m512i flip = _mm512_set1_epi8(0x20);
+    uint32_t i = 0;
+    while (i < limit)
+    {
+        uint32_t lanes_count = limit - i;
+        uint32_t page_left = sstr_page_remaining(src + i);
+        if (page_left < lanes_count)
+        {
+            lanes_count = page_left;
+        }
+        __mmask64 lanes = sstr_lane_mask64(lanes_count);
+        __m512i v = _mm512_maskz_loadu_epi8(lanes, src + i);
+        __mmask64 in_range = _mm512_cmplt_epi8_mask(_mm512_add_epi8(v, shift), bound);
+        __m512i folded = _mm512_mask_mov_epi8(v, in_range, _mm512_xor_si512(v, flip));
+        uint64_t terminators = _mm512_mask_cmpeq_epi8_mask(lanes, v, zero);
+        if (terminators != 0)
+        {
+            uint32_t count = sstr_ctz64(terminators);
+            _mm512_mask_storeu_epi8(dest + i, sstr_lane_mask64(count), folded);
+            return i + count;
+        }
+        _mm512_mask_storeu_epi8(dest + i, lanes, folded);
+        i += lanes_count < 64 ? lanes_count : 64;
+    }
+    return i;
+}
+
+SSTR_TARGET("avx512bw,popcnt")
+inline uint32_t sstr_kernel_mismatch_avx512bw(const char *data1, const char *data2, uint32_t length)
+{
+    for (uint32_t i = 0; i < length; i += 64)
+    {
+        __mmask64 lanes = sstr_lane_mask64(length - i);
+        __m512i a = _mm512_maskz_loadu_epi8(lanes, data1 + i);
+        __m512i b = _mm512_maskz_loadu_epi8(lanes, data2 + i);
+        uint64_t diff = _mm512_cmpneq_epi8_mask(a, b);
+        if (diff != 0)
+        {
+            return i + sstr_ctz64(diff);
+        }
+    }
+    return length;
+}
+
+SSTR_TARGET("avx512bw,popcnt")
+inline uint32_t sstr_kernel_find_pair_avx512bw(const char *data, uint32_t length, char first, char last, uint32_t distance)
+{
+    if (distance >= length)
+    {
+        return length;
+    }
+    const __m512i first_v = _mm512_set1_epi8(first);
+    const __m512i last_v = _mm512_set1_epi8(last);
+    uint32_t positions = length - distance;
+    for (uint32_t i = 0; i < positions; i += 64)
+    {
+        __mmask64 lanes = sstr_lane_mask64(positions - i);
+        __m512i head = _mm512_maskz_loadu_epi8(lanes, data + i);
+        __m512i tail = _mm512_maskz_loadu_epi8(lanes, data + i + distance);
+        uint64_t mask = _mm512_mask_cmpeq_epi8_mask(_mm512_mask_cmpeq_epi8_mask(lanes, head, first_v), tail, last_v);
+        if (mask != 0)
+        {
+            return i + sstr_ctz64(mask);
+        }
+    }
+    return length;
+}
+
+SSTR_TARGET("avx512bw,popcnt")
+inline uint32_t sstr_kernel_find_pair_reverse_avx512bw(const char *data, uint32_t length, char first, char last, uint32_t distance)
+{
+    if (distance >= length)
+    {
+        return length;
+    }
+    const __m512i first_v = _mm512_set1_epi8(first);
+    const __m512i last_v = _mm512_set1_epi8(last);
+    uint32_t end = length - distance;
+    for (; end >= 64; end -= 64)
+    {
+        __m512i head = _mm512_loadu_si512((const void *)(data + end - 64));
+        __m512i tail = _mm512_loadu_si512((const void *)(data + end - 64 + distance));
+        uint64_t mask = _mm512_mask_cmpeq_epi8_mask(_mm512_cmpeq_epi8_mask(head, first_v), tail, last_v);
+        if (mask != 0)
+        {
+            return end - 64 + sstr_bsr64(mask);
+        }
+    }
+    if (end > 0)
+    {
+        __mmask64 lanes = sstr_lane_mask64(end);
+        __m512i head = _mm512_maskz_loadu_epi8(lanes, data);
+        __m512i tail = _mm512_maskz_loadu_epi8(lanes, data + distance);
+        uint64_t mask = _mm512_mask_cmpeq_epi8_mask(_mm512_mask_cmpeq_epi8_mask(lanes, head, first_v), tail, last_v);
+        if (mask != 0)
+        {
+            return sstr_bsr64(mask);
+        }
+    }
+    return length;
+}
+
+SSTR_TARGET("avx512bw,popcnt")
+inline __m512i sstr_fold_lower_avx512bw(__m512i v)
+{
+    __mmask64 upper = _mm512_cmplt_epi8_mask(_mm512_add_epi8(v, _mm512_set1_epi8((char)(0x80 - 'A'))), _mm512_set1_epi8((char)(-128 + 26)));
+    return _mm512_mask_mov_epi8(v, upper, _mm512_or_si512(v, _mm512_set1_epi8(0x20)));
+}
+
+SSTR_TARGET("avx512bw,popcnt")
+inline uint32_t sstr_kernel_imismatch_avx512bw(const char *data1, const char *data2, uint32_t length)
+{
+    for (uint32_t i = 0; i < length; i += 64)
+    {
+        __mmask64 lanes = sstr_lane_mask64(length - i);
+        __m512i a = _mm512_maskz_loadu_epi8(lanes, data1 + i);
+        __m512i b = _mm512_maskz_loadu_epi8(lanes, data2 + i);
+        uint64_t diff = _mm512_cmpneq_epi8_mask(a, b);
+        if (diff != 0)
+        {
+            diff = _mm512_cmpneq_epi8_mask(sstr_fold_lower_avx512bw(a), sstr_fold_lower_avx512bw(b));
+            if (diff != 0)
+            {
+                return i + sstr_ctz64(diff);
+            }
+        }
+    }
+    return length;
+}
+
+SSTR_TARGET("avx512bw,popcnt")
+inline uint32_t sstr_kernel_ifind_pair_avx512bw(const char *data, uint32_t length, char first, char last, uint32_t distance)
+{
+    if (distance >= length)
+    {
+        return length;
+    }
+    const __m512i first_v = _mm512_set1_epi8(first);
+    const __m512i last_v = _mm512_set1_epi8(last);
+    const __m512i first_bit = _mm512_set1_epi8((char)sstr_letter_bit(first));
+    const __m512i last_bit = _mm512_set1_epi8((char)sstr_letter_bit(last));
+    uint32_t positions = length - distance;
+    for (uint32_t i = 0; i < positions; i += 64)
+    {
+        __mmask64 lanes = sstr_lane_mask64(positions - i);
+        __m512i head = _mm512_or_si512(_mm512_maskz_loadu_epi8(lanes, data + i), first_bit);
+        __m512i tail = _mm512_or_si512(_mm512_maskz_loadu_epi8(lanes, data + i + distance), last_bit);
+        uint64_t mask = _mm512_mask_cmpeq_epi8_mask(_mm512_mask_cmpeq_epi8_mask(lanes, head, first_v), tail, last_v);
+        if (mask != 0)
+        {
+            return i + sstr_ctz64(mask);
+        }
+    }
+    return length;
+}
+
+inline void sstr_cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4])
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuidex(info, (int)leaf, (int)subleaf);
+    for (int i = 0; i < 4; i++)
+    {
+        regs[i] = (uint32_t)info[i];
+    }
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// Register state enabled by the OS (XCR0)
+inline uint64_t sstr_xgetbv0(void)
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    uint32_t eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((uint64_t)edx << 32) | eax;
+#endif
+}
+
+/*
+ * Character-class compaction classifies a whole vector through the nibble
+ * tables of the class, then left-packs the kept bytes 8 at a time with one
+ * pshufb whose control comes from a 256-entry table indexed by the keep mask
+ * of the group. Each group is stored as 8 bytes at the write position, which
+ * never passes the part of the vector being packed, so compaction is in place.
+ * SSE2 has no byte shuffle; its table uses the scalar kernel.
+ */
+
+// Byte i of entry mask holds the position of the i-th set bit of mask, for i < popcount(mask)
+inline const uint64_t *sstr_pack_indices(void)
+{
+    static const uint64_t indices[256] = {
+        0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000001ULL, 0x0000000000000100ULL,
+        0x0000000000000002ULL, 0x0000000000000200ULL, 0x0000000000000201ULL, 0x0000000000020100ULL,
+        0x0000000000000003ULL, 0x0000000000000300ULL, 0x0000000000000301ULL, 0x0000000000030100ULL,
+        0x0000000000000302ULL, 0x0000000000030200ULL, 0x0000000000030201ULL, 0x0000000003020100ULL,
+        0x0000000000000004ULL, 0x0000000000000400ULL, 0x0000000000000401ULL, 0x0000000000040100ULL,
+        0x0000000000000402ULL, 0x0000000000040200ULL, 0x0000000000040201ULL, 0x0000000004020100ULL,
+        0x0000000000000403ULL, 0x0000000000040300ULL, 0x0000000000040301ULL, 0x0000000004030100ULL,
+        0x0000000000040302ULL, 0x0000000004030200ULL, 0x0000000004030201ULL, 0x0000000403020100ULL,
+        0x0000000000000005ULL, 0x0000000000000500ULL, 0x0000000000000501ULL, 0x0000000000050100ULL,
+        0x0000000000000502ULL, 0x0000000000050200ULL, 0x0000000000050201ULL, 0x0000000005020100ULL,
+        0x0000000000000503ULL, 0x0000000000050300ULL, 0x0000000000050301ULL, 0x0000000005030100ULL,
+        0x0000000000050302ULL, 0x0000000005030200ULL, 0x0000000005030201ULL, 0x0000000503020100ULL,
+        0x0000000000000504ULL, 0x0000000000050400ULL, 0x0000000000050401ULL, 0x0000000005040100ULL,
+        0x0000000000050402ULL, 0x0000000005040200ULL, 0x0000000005040201ULL, 0x0000000504020100ULL,
+        0x0000000000050403ULL, 0x0000000005040300ULL, 0x0000000005040301ULL, 0x0000000504030100ULL,
+        0x0000000005040302ULL, 0x0000000504030200ULL, 0x0000000504030201ULL, 0x0000050403020100ULL,
+        0x0000000000000006ULL, 0x0000000000000600ULL, 0x0000000000000601ULL, 0x0000000000060100ULL,
+        0x0000000000000602ULL, 0x0000000000060200ULL, 0x0000000000060201ULL, 0x0000000006020100ULL,
+        0x0000000000000603ULL, 0x0000000000060300ULL, 0x0000000000060301ULL, 0x0000000006030100ULL,
+        0x0000000000060302ULL, 0x0000000006030200ULL, 0x0000000006030201ULL, 0x0000000603020100ULL,
+        0x0000000000000604ULL, 0x0000000000060400ULL, 0x0000000000060401ULL, 0x0000000006040100ULL,
+        0x0000000000060402ULL, 0x0000000006040200ULL, 0x0000000006040201ULL, 0x0000000604020100ULL,
+        0x0000000000060403ULL, 0x0000000006040300ULL, 0x0000000006040301ULL, 0x0000000604030100ULL,
+        0x0000000006040302ULL, 0x0000000604030200ULL, 0x0000000604030201ULL, 0x0000060403020100ULL,
+        0x0000000000000605ULL, 0x0000000000060500ULL, 0x0000000000060501ULL, 0x0000000006050100ULL,
+        0x0000000000060502ULL, 0x0000000006050200ULL, 0x0000000006050201ULL, 0x0000000605020100ULL,
+        0x0000000000060503ULL, 0x0000000006050300ULL, 0x0000000006050301ULL, 0x0000000605030100ULL,
+        0x0000000006050302ULL, 0x0000000605030200ULL, 0x0000000605030201ULL, 0x0000060503020100ULL,
+        0x0000000000060504ULL, 0x0000000006050400ULL, 0x0000000006050401ULL, 0x0000000605040100ULL,
+        0x0000000006050402ULL, 0x0000000605040200ULL, 0x0000000605040201ULL, 0x0000060504020100ULL,
+        0x0000000006050403ULL, 0x0000000605040300ULL, 0x0000000605040301ULL, 0x0000060504030100ULL,
+        0x0000000605040302ULL, 0x0000060504030200ULL, 0x0000060504030201ULL, 0x0006050403020100ULL,
+        0x0000000000000007ULL, 0x0000000000000700ULL, 0x0000000000000701ULL, 0x0000000000070100ULL,
+        0x0000000000000702ULL, 0x0000000000070200ULL, 0x0000000000070201ULL, 0x0000000007020100ULL,
+        0x0000000000000703ULL, 0x0000000000070300ULL, 0x0000000000070301ULL, 0x0000000007030100ULL,
+        0x0000000000070302ULL, 0x0000000007030200ULL, 0x0000000007030201ULL, 0x0000000703020100ULL,
+        0x0000000000000704ULL, 0x0000000000070400ULL, 0x0000000000070401ULL, 0x0000000007040100ULL,
+        0x0000000000070402ULL, 0x0000000007040200ULL, 0x0000000007040201ULL, 0x0000000704020100ULL,
+        0x0000000000070403ULL, 0x0000000007040300ULL, 0x0000000007040301ULL, 0x0000000704030100ULL,
+        0x0000000007040302ULL, 0x0000000704030200ULL, 0x0000000704030201ULL, 0x0000070403020100ULL,
+        0x0000000000000705ULL, 0x0000000000070500ULL, 0x0000000000070501ULL, 0x0000000007050100ULL,
+        0x0000000000070502ULL, 0x0000000007050200ULL, 0x0000000007050201ULL, 0x0000000705020100ULL,
+        0x0000000000070503ULL, 0x0000000007050300ULL, 0x0000000007050301ULL, 0x0000000705030100ULL,
+        0x0000000007050302ULL, 0x0000000705030200ULL, 0x0000000705030201ULL, 0x0000070503020100ULL,
+        0x0000000000070504ULL, 0x0000000007050400ULL, 0x0000000007050401ULL, 0x0000000705040100ULL,
+        0x0000000007050402ULL, 0x0000000705040200ULL, 0x0000000705040201ULL, 0x0000070504020100ULL,
+        0x0000000007050403ULL, 0x0000000705040300ULL, 0x0000000705040301ULL, 0x0000070504030100ULL,
+        0x0000000705040302ULL, 0x0000070504030200ULL, 0x0000070504030201ULL, 0x0007050403020100ULL,
+        0x0000000000000706ULL, 0x0000000000070600ULL, 0x0000000000070601ULL, 0x0000000007060100ULL,
+        0x0000000000070602ULL, 0x0000000007060200ULL, 0x0000000007060201ULL, 0x0000000706020100ULL,
+        0x0000000000070603ULL, 0x0000000007060300ULL, 0x0000000007060301ULL, 0x0000000706030100ULL,
+        0x0000000007060302ULL, 0x0000000706030200ULL, 0x0000000706030201ULL, 0x0000070603020100ULL,
+        0x0000000000070604ULL, 0x0000000007060400ULL, 0x0000000007060401ULL, 0x0000000706040100ULL,
+        0x0000000007060402ULL, 0x0000000706040200ULL, 0x0000000706040201ULL, 0x0000070604020100ULL,
+        0x0000000007060403ULL, 0x0000000706040300ULL, 0x0000000706040301ULL, 0x0000070604030100ULL,
+        0x0000000706040302ULL, 0x0000070604030200ULL, 0x0000070604030201ULL, 0x0007060403020100ULL,
+        0x0000000000070605ULL, 0x0000000007060500ULL, 0x0000000007060501ULL, 0x0000000706050100ULL,
+        0x0000000007060502ULL, 0x0000000706050200ULL, 0x0000000706050201ULL, 0x0000070605020100ULL,
+        0x0000000007060503ULL, 0x0000000706050300ULL, 0x0000000706050301ULL, 0x0000070605030100ULL,
+        0x0000000706050302ULL, 0x0000070605030200ULL, 0x0000070605030201ULL, 0x0007060503020100ULL,
+        0x0000000007060504ULL, 0x0000000706050400ULL, 0x0000000706050401ULL, 0x0000070605040100ULL,
+        0x0000000706050402ULL, 0x0000070605040200ULL, 0x0000070605040201ULL, 0x0007060504020100ULL,
+        0x0000000706050403ULL, 0x0000070605040300ULL, 0x0000070605040301ULL, 0x0007060504030100ULL,
+        0x0000070605040302ULL, 0x0007060504030200ULL, 0x0007060504030201ULL, 0x0706050403020100ULL
+    };
+    return indices;
+}
+
+// Packs the bytes of lane whose bits are set in keep to out; returns the number of bytes kept
+SSTR_TARGET("avx2,popcnt")
+inline uint32_t sstr_pack_lane_avx2(char *out, __m128i lane, uint32_t keep, const uint64_t *indices)
+{
+    uint64_t low = indices[keep & 0xFF];
+    uint64_t high = indices[keep >> 8] + 0x0808080808080808ULL; // Positions within the upper half of the lane
+    uint32_t low_count = sstr_popcount64(keep & 0xFF);
+    _mm_storel_epi64((__m128i *)out, _mm_shuffle_epi8(lane, _mm_loadl_epi64((const __m128i *)&low)));
+    _mm_storel_epi64((__m128i *)(out + low_count), _mm_shuffle_epi8(lane, _mm_loadl_epi64((const __m128i *)&high)));
+    return low_count + sstr_popcount64(keep >> 8);
+}
+
+// Returns a mask with the bits of the bytes of v outside the class set
+SSTR_TARGET("avx2,popcnt")
+inline uint32_t sstr_class_keep_avx2(__m256i v, __m256i row0, __m256i row1)
+{
+    const __m256i high_bits = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                               1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    __m256i low = _mm256_and_si256(v, nibble);
+    __m256i high = _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble);
+    __m256i row = _mm256_blendv_epi8(_mm256_shuffle_epi8(row0, low), _mm256_shuffle_epi8(row1, low), v);
+    __m256i bit = _mm256_shuffle_epi8(high_bits, high);
+    return ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit));
+}
+
+SSTR_TARGET("avx2,popcnt")
+inline uint32_t sstr_kernel_compact_class_avx2(char *data, uint32_t length, const StaticStringCharClass *cls)
+{
+    const uint64_t *indices = sstr_pack_indices();
+    const __m256i row0 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)cls->nibble_rows[0]));
+    const __m256i row1 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)cls->nibble_rows[1]));
+    uint32_t read = 0, write = 0;
+    for (; read + 32 <= length; read += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(data + read));
+        uint32_t keep = sstr_class_keep_avx2(v, row0, row1);
+        if (keep == 0xFFFFFFFFu)
+        {
+            if (write != read)
+            {
+                _mm256_storeu_si256((__m256i *)(data + write), v);
+            }
+            write += 32;
+            continue;
+        }
+        write += sstr_pack_lane_avx2(data + write, _mm256_castsi256_si128(v), keep & 0xFFFF, indices);
+        write += sstr_pack_lane_avx2(data + write, _mm256_extracti128_si256(v, 1), keep >> 16, indices);
+    }
+    uint32_t remaining = length - read;
+    if (remaining < 8)
+    {
+        return sstr_compact_class_tail(data, read, write, length, cls);
+    }
+
+    // Packs the tail through a local block, since the 8-byte stores may pass the end of the string
+    char block[32] = {0};
+    char packed[32 + 8];
+    memcpy(block, data + read, remaining);
+    __m256i v = _mm256_loadu_si256((const __m256i *)block);
+    uint32_t keep = sstr_class_keep_avx2(v, row0, row1) & ((1u << remaining) - 1);
+    uint32_t count = sstr_pack_lane_avx2(packed, _mm256_castsi256_si128(v), keep & 0xFFFF, indices);
+    count += sstr_pack_lane_avx2(packed + count, _mm256_extracti128_si256(v, 1), keep >> 16, indices);
+    memcpy(data + write, packed, count);
+    return write + count;
+}
+
+// Copies a 16-byte table to all four lanes. The all-ones zero mask compiles to a plain vbroadcasti32x4;
+// the unmasked _mm512_broadcast_i32x4 trips GCC's -Wuninitialized on its undefined pass-through operand.
+SSTR_TARGET("avx512bw")
+inline __m512i sstr_broadcast128_avx512bw(__m128i table)
+{
+    return _mm512_maskz_broadcast_i32x4((__mmask16)0xFFFF, table);
+}
+
+SSTR_TARGET("avx512bw,popcnt")
+inline uint64_t sstr_class_keep_avx512bw(__m512i v, __m512i row0, __m512i row1)
+{
+    const __m512i high_bits = sstr_broadcast128_avx512bw(_mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128));
+    const __m512i nibble = _mm512_set1_epi8(0x0F);
+    __m512i low = _mm512_and_si512(v, nibble);
+    __m512i high = _mm512_and_si512(_mm512_srli_epi16(v, 4), nibble);
+    __m512i row = _mm512_mask_blend_epi8(_mm512_movepi8_mask(v), _mm512_shuffle_epi8(row0, low), _mm512_shuffle_epi8(row1, low));
+    return ~(uint64_t)_mm512_test_epi8_mask(row, _mm512_shuffle_epi8(high_bits, high));
+}
+
+SSTR_TARGET("avx512bw,popcnt")
+inline uint32_t sstr_pack_vector_avx512bw(char *out, __m512i v, uint64_t keep, const uint64_t *indices)
+{
+    // Zero-masked extracts with an all-ones mask, for the same -Wuninitialized reason as sstr_broadcast128_avx512bw()
+    const __mmask8 all = 0xFF;
+    uint32_t count = sstr_pack_lane_avx2(out, _mm512_maskz_extracti32x4_epi32(all, v, 0), (uint32_t)keep & 0xFFFF, indices);
+    count += sstr_pack_lane_avx2(out + count, _mm512_maskz_extracti32x4_epi32(all, v, 1), (uint32_t)(keep >> 16) & 0xFFFF, indices);
+    count += sstr_pack_lane_avx2(out + count, _mm512_maskz_extracti32x4_epi32(all, v, 2), (uint32_t)(keep >> 32) & 0xFFFF, indices);
+    count += sstr_pack_lane_avx2(out + count, _mm512_maskz_extracti32x4_epi32(all, v, 3), (uint32_t)(keep >> 48), indices);
+    return count;
+}
+
+SSTR_TARGET("avx512bw,popcnt")
+inline uint32_t sstr_kernel_compact_class_avx512bw(char *data, uint32_t length, const StaticStringCharClass *cls)
+{
+    const uint64_t *indices = sstr_pack_indices();
+    const __m512i row0 = sstr_broadcast128_avx512bw(_mm_loadu_si128((const __m128i *)cls->nibble_rows[0]));
+    const __m512i row1 = sstr_broadcast128_avx512bw(_mm_loadu_si128((const __m128i *)cls->nibble_rows[1]));
+    uint32_t read = 0, write = 0;
+    for (; read + 64 <= length; read += 64)
+    {
+        __m512i v = _mm512_loadu_si512((const void *)(data + read));
+        uint64_t keep = sstr_class_keep_avx512bw(v, row0, row1);
+        if (keep == ~0ULL)
+        {
+            if (write != read)
+            {
+                _mm512_storeu_si512((void *)(data + write), v);
+            }
+            write += 64;
+            continue;
+        }
+        write += sstr_pack_vector_avx512bw(data + write, v, keep, indices);
+    }
+    uint32_t remaining = length - read;
+    if (remaining < 8)
+    {
+        return sstr_compact_class_tail(data, read, write, length, cls);
+    }
+
+    // The masked load does not touch bytes past the end; packing goes through a local block
+    char packed[64 + 8];
+    __mmask64 live = ((__mmask64)1 << remaining) - 1;
+    __m512i v = _mm512_maskz_loadu_epi8(live, data + read);
+    uint32_t count = sstr_pack_vector_avx512bw(packed, v, sstr_class_keep_avx512bw(v, row0, row1) & live, indices);
+    memcpy(data + write, packed, count);
+    return write + count;
+}
+
+/*
+ * Span kernels build the keep mask of whole vectors, walking in from one end,
+ * and stop at the first vector with a byte outside the class; tzcnt or lzcnt
+ * of its mask gives the bound. Most strings do not start or end in the
+ * class, so the boundary byte is tested first. AVX2 leaves strings shorter
+ * than a vector to the scalar loop; AVX-512BW covers the partial vector with
+ * a masked load.
+ */
+
+SSTR_TARGET("avx2,popcnt")
+inline uint32_t sstr_kernel_span_class_avx2(const char *data, uint32_t length, const StaticStringCharClass *cls)
+{
+    if (length < 32 || !sstr_char_class_contains(cls, data[0]))
+    {
+        return sstr_kernel_span_class_scalar(data, length, cls);
+    }
+    const __m256i row0 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)cls->nibble_rows[0]));
+    const __m256i row1 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)cls->nibble_rows[1]));
+    uint32_t i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        uint32_t keep = sstr_class_keep_avx2(_mm256_loadu_si256((const __m256i *)(data + i)), row0, row1);
+        if (keep != 0)
+        {
+            return i + sstr_ctz64(keep);
+        }
+    }
+    if (i < length)
+    {
+        uint32_t keep = sstr_class_keep_avx2(_mm256_loadu_si256((const __m256i *)(data + length - 32)), row0, row1);
+        if (keep != 0)
+        {
+            return length - 32 + sstr_ctz64(keep);
+        }
+    }
+    return length;
+}
+
+SSTR_TARGET("avx2,popcnt")
+inline uint32_t sstr_kernel_span_class_reverse_avx2(const char *data, uint32_t length, const StaticStringCharClass *cls)
+{
+    if (length < 32 || !sstr_char_class_contains(cls, data[length - 1]))
+    {
+        return sstr_kernel_span_class_reverse_scalar(data, length, cls);
+    }
+    const __m256i row0 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)cls->nibble_rows[0]));
+    const __m256i row1 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)cls->nibble_rows[1]));
+    uint32_t end = length;
+    for (; end >= 32; end -= 32)
+    {
+        uint32_t keep = sstr_class_keep_avx2(_mm256_loadu_si256((const __m256i *)(data + end - 32)), row0, row1);
+        if (keep != 0)
+        {
+            return 31 - sstr_bsr64(keep) + (length - end);
+        }
+    }
+    if (end > 0)
+    {
+        // Overlaps the vector above; only the first end bytes are new
+        uint32_t keep = sstr_class_keep_avx2(_mm256_loadu_si256((const __m256i *)data), row0, row1) & ((1u << end) - 1);
+        if (keep != 0)
+        {
+            return length - 1 - sstr_bsr64(keep);
+        }
+    }
+    return length;
+}
+
+SSTR_TARGET("avx512bw,popcnt")
+inline uint32_t sstr_kernel_span_class_avx512bw(const char *data, uint32_t length, const StaticStringCharClass *cls)
+{
+    if (length == 0 || !sstr_char_class_contains(cls, data[0]))
+    {
+        return 0;
+    }
+    const __m512i row0 = sstr_broadcast128_avx512bw(_mm_loadu_si128((const __m128i *)cls->nibble_rows[0]));
+    const __m512i row1 = sstr_broadcast128_avx512bw(_mm_loadu_si128((const __m128i *)cls->nibble_rows[1]));
+    for (uint32_t i = 0; i < length; i += 64)
+    {
+        uint32_t remaining = length - i;
+        __mmask64 live = remaining >= 64 ? ~(__mmask64)0 : ((__mmask64)1 << remaining) - 1;
+        uint64_t keep = sstr_class_keep_avx512bw(_mm512_maskz_loadu_epi8(live, data + i), row0, row1) & live;
+        if (keep != 0)
+        {
+            return i + sstr_ctz64(keep);
+        }
+    }
+    return length;
+}
+
+SSTR_TARGET("avx512bw,popcnt")
+inline uint32_t sstr_kernel_span_class_reverse_avx512bw(const char *data, uint32_t length, const StaticStringCharClass *cls)
+{
+    if (length == 0 || !sstr_char_class_contains(cls, data[length - 1]))
+    {
+        return 0;
+    }
+    const __m512i row0 = sstr_broadcast128_avx512bw(_mm_loadu_si128((const __m128i *)cls->nibble_rows[0]));
+    const __m512i row1 = sstr_broadcast128_avx512bw(_mm_loadu_si128((const __m128i *)cls->nibble_rows[1]));
+    for (uint32_t end = length; end > 0;)
+    {
+        uint32_t count = end >= 64 ? 64 : end;
+        __mmask64 live = count == 64 ? ~(__mmask64)0 : ((__mmask64)1 << count) - 1;
+        uint64_t keep = sstr_class_keep_avx512bw(_mm512_maskz_loadu_epi8(live, data + end - count), row0, row1) & live;
+        if (keep != 0)
+        {
+            return length - (end - count) - 1 - sstr_bsr64(keep);
+        }
+        end -= count;
+    }
+    return length;
+}
+
+/*
+ * find_class kernels run the span loop with the keep mask inverted, stopping
+ * at the first byte inside the class. class_mask kernels classify the first
+ * 64 bytes like char_mask, for callers that walk matches as a bitmask.
+ */
+
+SSTR_TARGET("avx2,popcnt")
+inline uint32_t sstr_kernel_find_class_avx2(const char *data, uint32_t length, const StaticStringCharClass *cls)
+{
+    if (length < 16 || sstr_char_class_contains(cls, data[0]))
+    {
+        return sstr_kernel_find_class_scalar(data, length, cls);
+    }
+    const __m256i row0 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)cls->nibble_rows[0]));
+    const __m256i row1 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)cls->nibble_rows[1]));
+    if (length < 32)
+    {
+        // The first and last 16 bytes, overlapping, in one vector
+        __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)data)),
+                                            _mm_loadu_si128((const __m128i *)(data + length - 16)), 1);
+        uint32_t hits = ~sstr_class_keep_avx2(v, row0, row1);
+        if ((hits & 0xFFFF) != 0)
+        {
+            return sstr_ctz64(hits & 0xFFFF);
+        }
+        return hits != 0 ? length - 16 + sstr_ctz64(hits >> 16) : length;
+    }
+    uint32_t i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        uint32_t hits = ~sstr_class_keep_avx2(_mm256_loadu_si256((const __m256i *)(data + i)), row0, row1);
+        if (hits != 0)
+        {
+            return i + sstr_ctz64(hits);
+        }
+    }
+    if (i < length)
+    {
+        uint32_t hits = ~sstr_class_keep_avx2(_mm256_loadu_si256((const __m256i *)(data + length - 32)), row0, row1);
+        if (hits != 0)
+        {
+            return length - 32 + sstr_ctz64(hits);
+        }
+    }
+    return length;
+}
+
+SSTR_TARGET("avx2,popcnt")
+inline uint64_t sstr_kernel_class_mask_avx2(const char *data, uint32_t length, const StaticStringCharClass *cls)
+{
+    if (length < 32)
+    {
+        return sstr_kernel_class_mask_scalar(data, length, cls);
+    }
+    const __m256i row0 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)cls->nibble_rows[0]));
+    const __m256i row1 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)cls->nibble_rows[1]));
+    uint64_t mask = (uint32_t)~sstr_class_keep_avx2(_mm256_loadu_si256((const __m256i *)data), row0, row1);
+    if (length > 32)
+    {
+        // Second vector ends at min(length, 64) and may overlap the first
+        uint32_t offset = (length < 64 ? length : 64) - 32;
+        mask |= (uint64_t)(uint32_t)~sstr_class_keep_avx2(_mm256_loadu_si256((const __m256i *)(data + offset)), row0, row1) << offset;
+    }
+    return mask;
+}
+
+SSTR_TARGET("avx512bw,popcnt")
+inline uint32_t sstr_kernel_find_class_avx512bw(const char *data, uint32_t length, const StaticStringCharClass *cls)
+{
+    if (length == 0 || sstr_char_class_contains(cls, data[0]))
+    {
+        return 0;
+    }
+    const __m512i row0 = sstr_broadcast128_avx512bw(_mm_loadu_si128((const __m128i *)cls->nibble_rows[0]));
+    const __m512i row1 = sstr_broadcast128_avx512bw(_mm_loadu_si128((const __m128i *)cls->nibble_rows[1]));
+    uint32_t i = 0;
+    for (; i + 64 <= length; i += 64)
+    {
+        uint64_t hits = ~sstr_class_keep_avx512bw(_mm512_loadu_si512((const void *)(data + i)), row0, row1);
+        if (hits != 0)
+        {
+            return i + sstr_ctz64(hits);
+        }
+    }
+    if (i < length)
+    {
+        __mmask64 live = sstr_lane_mask64(length - i);
+        uint64_t hits = ~sstr_class_keep_avx512bw(_mm512_maskz_loadu_epi8(live, data + i), row0, row1) & live;
+        if (hits != 0)
+        {
+            return i + sstr_ctz64(hits);
+        }
+    }
+    return length;
+}
+
+SSTR_TARGET("avx512bw,popcnt")
+inline uint64_t sstr_kernel_class_mask_avx512bw(const char *data, uint32_t length, const StaticStringCharClass *cls)
+{
+    const __m512i row0 = sstr_broadcast128_avx512bw(_mm_loadu_si128((const __m128i *)cls->nibble_rows[0]));
+    const __m512i row1 = sstr_broadcast128_avx512bw(_mm_loadu_si128((const __m128i *)cls->nibble_rows[1]));
+    __mmask64 live = sstr_lane_mask64(length);
+    return ~sstr_class_keep_avx512bw(_mm512_maskz_loadu_epi8(live, data), row0, row1) & live;
+}
+
+/*
+ * Translation looks each byte up in the row of the table selected by its high
+ * nibble: pshufb with the low nibble reads the row, and a compare of the high
+ * nibble keeps the result only in the lanes of that row. Identity rows are
+ * skipped, so a table that touches letters only costs a few shuffles per
+ * vector. With AVX2, tables with more than SSTR_TRANSLATE_MAX_ROWS changed
+ * rows use the scalar lookup, which is faster there; with AVX-512 VBMI, two
+ * vpermi2b cover the whole table whatever it changes. Kernels return the
+ * number of bytes that changed.
+ */
+
+#define SSTR_TRANSLATE_MAX_ROWS 8 // Tables changing more rows are translated with the scalar kernel at the AVX2 level
+
+SSTR_TARGET("avx2,popcnt")
+inline __m256i sstr_translate_avx2(__m256i v, const StaticStringTranslation *table)
+{
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    __m256i low = _mm256_and_si256(v, nibble);
+    __m256i high = _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble);
+    __m256i out = v;
+    for (uint32_t rows = table->active_rows; rows != 0; rows &= rows - 1)
+    {
+        uint32_t row = sstr_ctz64(rows);
+        __m256i lookup = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)(table->map + 16 * row)));
+        __m256i in_row = _mm256_cmpeq_epi8(high, _mm256_set1_epi8((char)row));
+        out = _mm256_blendv_epi8(out, _mm256_shuffle_epi8(lookup, low), in_row);
+    }
+    return out;
+}
+
+SSTR_TARGET("avx2,popcnt")
+inline uint32_t sstr_kernel_translate_avx2(char *data, uint32_t length, const StaticStringTranslation *table)
+{
+    if (length < 32 || sstr_popcount64(table->active_rows) > SSTR_TRANSLATE_MAX_ROWS)
+    {
+        return sstr_kernel_translate_scalar(data, length, table);
+    }
+    // The last vector is translated from the original bytes and stored last, so
+    // the bytes it shares with the previous vector are not mapped twice
+    __m256i last = _mm256_loadu_si256((const __m256i *)(data + length - 32));
+    __m256i last_out = sstr_translate_avx2(last, table);
+    uint32_t count = 0;
+    uint32_t i = 0;
+    for (; i + 32 < length; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(data + i));
+        __m256i out = sstr_translate_avx2(v, table);
+        _mm256_storeu_si256((__m256i *)(data + i), out);
+        count += sstr_popcount64(~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(out, v)));
+    }
+    _mm256_storeu_si256((__m256i *)(data + length - 32), last_out);
+    uint32_t changed = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(last_out, last));
+    return count + sstr_popcount64(changed >> (i - (length - 32)));
+}
+
+SSTR_TARGET("avx512bw,popcnt")
+inline __m512i sstr_translate_avx512bw(__m512i v, const StaticStringTranslation *table)
+{
+    const __m512i nibble = _mm512_set1_epi8(0x0F);
+    __m512i low = _mm512_and_si512(v, nibble);
+    __m512i high = _mm512_and_si512(_mm512_srli_epi16(v, 4), nibble);
+    __m512i out = v;
+    for (uint32_t rows = table->active_rows; rows != 0; rows &= rows - 1)
+    {
+        uint32_t row = sstr_ctz64(rows);
+        __m512i lookup = sstr_broadcast128_avx512bw(_mm_loadu_si128((const __m128i *)(table->map + 16 * row)));
+        out = _mm512_mask_shuffle_epi8(out, _mm512_cmpeq_epi8_mask(high, _mm512_set1_epi8((char)row)), lookup, low);
+    }
+    return out;
+}
+
+SSTR_TARGET("avx512bw,popcnt")
+inline uint32_t sstr_kernel_translate_avx512bw(char *data, uint32_t length, const StaticStringTranslation *table)
+{
+    uint32_t count = 0;
+    uint32_t i = 0;
+    for (; i + 64 <= length; i += 64)
+    {
+        __m512i v = _mm512_loadu_si512((const void *)(data + i));
+        __m512i out = sstr_translate_avx512bw(v, table);
+        _mm512_storeu_si512((void *)(data + i), out);
+        count += sstr_popcount64(_mm512_cmpneq_epi8_mask(out, v));
+    }
+    if (i < length)
+    {
+        __mmask64 live = sstr_lane_mask64(length - i);
+        __m512i v = _mm512_maskz_loadu_epi8(live, data + i);
+        __m512i out = sstr_translate_avx512bw(v, table);
+        _mm512_mask_storeu_epi8(data + i, live, out);
+        count += sstr_popcount64(_mm512_mask_cmpneq_epi8_mask(live, out, v));
+    }
+    return count;
+}
+
+// Looks every byte of v up in the 256-byte table held by map0..map3
+SSTR_TARGET("avx512bw,avx512vbmi,popcnt")
+inline __m512i sstr_translate_avx512vbmi(__m512i v, __m512i map0, __m512i map1, __m512i map2, __m512i map3)
+{
+    // Bits 0-6 index one half of the table, bit 7 picks the half
+    __m512i low_half = _mm512_permutex2var_epi8(map0, v, map1);
+    __m512i high_half = _mm512_permutex2var_epi8(map2, v, map3);
+    return _mm512_mask_blend_epi8(_mm512_movepi8_mask(v), low_half, high_half);
+}
+
+SSTR_TARGET("avx512bw,avx512vbmi,popcnt")
+inline uint32_t sstr_kernel_translate_avx512vbmi(char *data, uint32_t length, const StaticStringTranslation *table)
+{
+    const __m512i map0 = _mm512_loadu_si512((const void *)table->map);
+    const __m512i map1 = _mm512_loadu_si512((const void *)(table->map + 64));
+    const __m512i map2 = _mm512_loadu_si512((const void *)(table->map + 128));
+    const __m512i map3 = _mm512_loadu_si512((const void *)(table->map + 192));
+    uint32_t count = 0;
+    uint32_t i = 0;
+    for (; i + 64 <= length; i += 64)
+    {
+        __m512i v = _mm512_loadu_si512((const void *)(data + i));
+        __m512i out = sstr_translate_avx512vbmi(v, map0, map1, map2, map3);
+        _mm512_storeu_si512((void *)(data + i), out);
+        count += sstr_popcount64(_mm512_cmpneq_epi8_mask(out, v));
+    }
+    if (i < length)
+    {
+        __mmask64 live = sstr_lane_mask64(length - i);
+        __m512i v = _mm512_maskz_loadu_epi8(live, data + i);
+        __m512i out = sstr_translate_avx512vbmi(v, map0, map1, map2, map3);
+        _mm512_mask_storeu_epi8(data + i, live, out);
+        count += sstr_popcount64(_mm512_mask_cmpneq_epi8_mask(live, out, v));
+    }
+    return count;
+}
+
+/**
+ * @brief Detects the best SIMD level supported by the CPU and the OS.
+ *
+ * @return int One of the SSTR_SIMD_* constants.
+ */
+inline int sstr_cpu_simd_level(void)
+{
+    uint32_t regs[4];
+    sstr_cpuid(0, 0, regs);
+    uint32_t max_leaf = regs[0];
+
+    sstr_cpuid(1, 0, regs);
+    if ((regs[3] & (1u << 26)) == 0) // SSE2
+    {
+        return SSTR_SIMD_SCALAR;
+    }
+    const uint32_t popcnt_osxsave_avx = (1u << 23) | (1u << 27) | (1u << 28); // AVX2 and AVX-512 kernels are built with popcnt
+    if ((regs[2] & popcnt_osxsave_avx) != popcnt_osxsave_avx || max_leaf < 7)
+    {
+        return SSTR_SIMD_SSE2;
+    }
+
+    uint64_t xcr0 = sstr_xgetbv0();
+    sstr_cpuid(7, 0, regs);
+    if ((xcr0 & 0x6) != 0x6 || (regs[1] & (1u << 5)) == 0) // YMM state, AVX2
+    {
+        return SSTR_SIMD_SSE2;
+    }
+    const uint32_t avx512f_bw = (1u << 16) | (1u << 30);
+    if ((xcr0 & 0xE6) != 0xE6 || (regs[1] & avx512f_bw) != avx512f_bw) // ZMM + opmask state, AVX-512F/BW
+    {
+        return SSTR_SIMD_AVX2;
+    }
+    return SSTR_SIMD_AVX512BW;
+}
+
+// Whether the CPU and the OS support AVX-512 VBMI, which the SSTR_SIMD_AVX512BW table uses for translation when present
+inline uint32_t sstr_cpu_has_avx512vbmi(void)
+{
+    if (sstr_cpu_simd_level() < SSTR_SIMD_AVX512BW) // Also checks that XCR0 enables the ZMM and opmask state
+    {
+        return 0;
+    }
+    uint32_t regs[4];
+    sstr_cpuid(7, 0, regs);
+    return (regs[2] >> 1) & 1;
+}
+
+#endif // SSTR_HAS_X86_KERNELS
+
+/**
+ * @brief Returns the kernel table for a given SIMD level.
+ *
+ * Levels not compiled into this build fall back to the best lower level.
+ *
+ * @param level One of the SSTR_SIMD_* constants.
+ *
+ * @return const SStrKernels* Pointer to a static kernel table.
+ */
+inline const SStrKernels *sstr_kernels_for_level(int level)
+{
+    // Every table is a constant; a fixed SSTR_SIMD_LEVEL compiles out the levels above it and never probes CPUID
+#if defined(SSTR_SIMD_LEVEL)
+    if (level > SSTR_SIMD_LEVEL)
+    {
+        level = SSTR_SIMD_LEVEL;
+    }
+#endif
+#if SSTR_HAS_X86_KERNELS
+    switch (level)
+    {
+#if !defined(SSTR_SIMD_LEVEL) || SSTR_SIMD_LEVEL >= SSTR_SIMD_AVX512BW
+    // The AVX-512BW table with either translate kernel; both are constants, and CPUID picks one when the level is not fixed
+#define SSTR_AVX512BW_KERNELS(translate)                                                                                              \
+    {SSTR_SIMD_AVX512BW, sstr_kernel_equals_avx512bw, sstr_kernel_count_char_avx512bw, sstr_kernel_find_char_avx512bw,                 \
+     sstr_kernel_find_char_reverse_avx512bw, sstr_kernel_flip_case_avx512bw, sstr_kernel_copy_cstr_avx512bw,                           \
+     sstr_kernel_mismatch_avx512bw, sstr_kernel_find_pair_avx512bw, sstr_kernel_find_pair_reverse_avx512bw,                            \
+     sstr_kernel_char_mask_avx512bw, sstr_kernel_compact_class_avx512bw, sstr_kernel_span_class_avx512bw,                              \
+     sstr_kernel_span_class_reverse_avx512bw, sstr_kernel_copy_cstr_flip_case_avx512bw, sstr_kernel_imismatch_avx512bw,                \
+     sstr_kernel_ifind_pair_avx512bw, sstr_kernel_find_class_avx512bw, sstr_kernel_class_mask_avx512bw, translate}
+    case SSTR_SIMD_AVX512BW:
+    {
+#if defined(SSTR_SIMD_LEVEL) && defined(__AVX512VBMI__)
+        static const SStrKernels avx512vbmi = SSTR_AVX512BW_KERNELS(sstr_kernel_translate_avx512vbmi);
+        return &avx512vbmi;
+#else
+        static const SStrKernels avx512bw = SSTR_AVX512BW_KERNELS(sstr_kernel_translate_avx512bw);
+#if !defined(SSTR_SIMD_LEVEL)
+        static const SStrKernels avx512vbmi = SSTR_AVX512BW_KERNELS(sstr_kernel_translate_avx512vbmi);
+        if (sstr_cpu_has_avx512vbmi())
+        {
+            return &avx512vbmi;
+        }
+#endif
+        return &avx512bw;
+#endif
+    }
+#undef SSTR_AVX512BW_KERNELS
+#endif
+#if !defined(SSTR_SIMD_LEVEL) || SSTR_SIMD_LEVEL >= SSTR_SIMD_AVX2
+    case SSTR_SIMD_AVX2:
+    {
+        static const SStrKernels avx2 = {SSTR_SIMD_AVX2, sstr_kernel_equals_avx2, sstr_kernel_count_char_avx2,
+                                         sstr_kernel_find_char_avx2, sstr_kernel_find_char_reverse_avx2,
+                                         sstr_kernel_flip_case_avx2, sstr_kernel_copy_cstr_avx2,
+                                         sstr_kernel_mismatch_avx2, sstr_kernel_find_pair_avx2,
+                                         sstr_kernel_find_pair_reverse_avx2,
+                                         sstr_kernel_char_mask_avx2, sstr_kernel_compact_class_avx2,
+                                         sstr_kernel_span_class_avx2, sstr_kernel_span_class_reverse_avx2,
+                                         sstr_kernel_copy_cstr_flip_case_avx2, sstr_kernel_imismatch_avx2,
+                                         sstr_kernel_ifind_pair_avx2, sstr_kernel_find_class_avx2,
+                                         sstr_kernel_class_mask_avx2, sstr_kernel_translate_avx2};
+        return &avx2;
+    }
+#endif
+    case SSTR_SIMD_SSE2:
+    {
+        static const SStrKernels sse2 = {SSTR_SIMD_SSE2, sstr_kernel_equals_sse2, sstr_kernel_count_char_sse2,
+                                         sstr_kernel_find_char_sse2, sstr_kernel_find_char_reverse_sse2,
+                                         sstr_kernel_flip_case_sse2, sstr_kernel_copy_cstr_sse2,
+                                         sstr_kernel_mismatch_sse2, sstr_kernel_find_pair_sse2,
+                                         sstr_kernel_find_pair_reverse_sse2,
+                                         sstr_kernel_char_mask_sse2, sstr_kernel_compact_class_scalar,
+                                         sstr_kernel_span_class_scalar, sstr_kernel_span_class_reverse_scalar,
+                                         sstr_kernel_copy_cstr_flip_case_sse2, sstr_kernel_imismatch_sse2,
+                                         sstr_kernel_ifind_pair_sse2, sstr_kernel_find_class_scalar,
+                                         sstr_kernel_class_mask_scalar, sstr_kernel_translate_scalar};
+        return &sse2;
+    }
+    default:
+        break;
+    }
+#endif
+    static const SStrKernels scalar = {SSTR_SIMD_SCALAR, sstr_kernel_equals_scalar, sstr_kernel_count_char_scalar,
+                                       sstr_kernel_find_char_scalar, sstr_kernel_find_char_reverse_scalar,
+                                       sstr_kernel_flip_case_scalar, sstr_kernel_copy_cstr_scalar,
+                                       sstr_kernel_mismatch_scalar, sstr_kernel_find_pair_scalar,
+                                       sstr_kernel_find_pair_reverse_scalar,
+                                       sstr_kernel_char_mask_scalar, sstr_kernel_compact_class_scalar,
+                                       sstr_kernel_span_class_scalar, sstr_kernel_span_class_reverse_scalar,
+                                       sstr_kernel_copy_cstr_flip_case_scalar, sstr_kernel_imismatch_scalar,
+                                       sstr_kernel_ifind_pair_scalar, sstr_kernel_find_class_scalar,
+                                       sstr_kernel_class_mask_scalar, sstr_kernel_translate_scalar};
+    return &scalar;
+}
+
+/**
+ * @brief Returns the kernel table used by the core functions.
+ *
+ * Selected once on first use from SSTR_SIMD_LEVEL if defined, otherwise from CPUID.
+ *
+ * @return const SStrKernels* Pointer to the active kernel table.
+ */
+#if !defined(SSTR_SIMD_LEVEL)
+// Table chosen by the first sstr_kernels() call. Racing first calls all store the same pointer to a constant table.
+SSTR_SELECTANY const SStrKernels *sstr_selected_kernels = NULL;
+#endif
+
+inline const SStrKernels *sstr_kernels(void)
+{
+#if defined(SSTR_SIMD_LEVEL)
+    return sstr_kernels_for_level(SSTR_SIMD_LEVEL);
+#else
+    const SStrKernels *selected = sstr_selected_kernels;
+    if (selected == NULL)
+    {
+        selected = sstr_kernels_for_level(sstr_cpu_simd_level());
+        sstr_selected_kernels = selected;
+    }
+    return selected;
+#endif
+}
+
+/*
+ * ---------------------------------------------------------------------------
+ * Runtime-capacity core
+ *
+ * Every algorithm is implemented once over a raw character buffer, a pointer
+ * to its length and its capacity (maximum length excluding the null terminator).
+ * The StaticString C API and the BasicStaticString<N> C++ template are thin
+ * layers over these functions, so strings of different capacities can be
+ * mixed freely.
+ * ---------------------------------------------------------------------------
+ */
+
+/**
+ * @brief Core implementation of sstr_init().
+ *
+ * @param data Character buffer of at least 1 byte.
+ * @param length Pointer to the string length.
+ *
+ * @return uint32_t Always 1.
+ */
+inline uint32_t sstr_core_init(char *data, uint32_t *length)
+{
+    *length = 0;
+    data[0] = '\0';
+    return 1;
+}
+
+/**
+ * @brief Core implementation of sstr_from_cstr_checked().
+ *
+ * @param data Character buffer of capacity + 1 bytes.
+ * @param length Pointer to the string length.
+ * @param capacity Maximum number of characters the buffer can hold.
+ * @param cstr Null-terminated C string to copy from.
+ * @param truncated Optional pointer set to 1 if cstr did not fit, 0 otherwise.
+ *
+ * @return uint32_t 1 if the buffer was initialized, 0 if cstr is NULL.
+ */
+inline uint32_t sstr_core_from_cstr(char *data, uint32_t *length, uint32_t capacity, const char *cstr, uint32_t *truncated)
+{
+    if (truncated != NULL)
+    {
+        *truncated = 0;
+    }
+    if (cstr == NULL)
+    {
+        return 0;
+    }
+    uint32_t i = sstr_kernels()->copy_cstr(data, cstr, capacity);
+    data[i] = '\0';
+    *length = i;
+    if (truncated != NULL && i == capacity)
+    {
+        *truncated = cstr[i] != '\0';
+    }
+    return 1;
+}
+
+/**
+ * @brief Core implementation of sstr_clear().
+ *
+ * Only the terminator is written; the old characters stay in the buffer.
+ *
+ * @param data Character buffer of capacity + 1 bytes.
+ * @param length Pointer to the string length.
+ * @param capacity Maximum number of characters the buffer can hold.
+ *
+ * @return uint32_t Always 1.
+ */
+inline uint32_t sstr_core_clear(char *data, uint32_t *length, uint32_t capacity)
+{
+    (void)capacity;
+    data[0] = '\0';
+    *length = 0;
+    return 1;
+}
+
+/**
+ * @brief Zeroes a buffer with stores the compiler may not remove.
+ *
+ * A plain memset() of memory that is never read again is a dead store the
+ * optimizer is allowed to drop. Calling memset() through a volatile function
+ * pointer hides the call from that analysis while keeping the library's wide
+ * stores, and the barrier afterwards makes the zeroed memory observable.
+ *
+ * @param data Buffer to zero.
+ * @param size Number of bytes to zero.
+ */
+inline void sstr_secure_zero(void *data, size_t size)
+{
+    static void *(*volatile const zero_memory)(void *, int, size_t) = memset;
+    zero_memory(data, 0, size);
+#if defined(__GNUC__) || defined(__clang__)
+    __asm__ __volatile__("" : : "r"(data) : "memory");
+#endif
+}
+
+/**
+ * @brief Core implementation of sstr_secure_wipe().
+ *
+ * @param data Character buffer of capacity + 1 bytes.
+ * @param length Pointer to the string length.
+ * @param capacity Maximum number of characters the buffer can hold.
+ *
+ * @return uint32_t Always 1.
+ */
+inline uint32_t sstr_core_secure_wipe(char *data, uint32_t *length, uint32_t capacity)
+{
+    sstr_secure_zero(data, (size_t)capacity + 1);
+    *length = 0;
+    return 1;
+}
+
+/**
+ * @brief Core implementation of sstr_append().
+ *
+ * @param data Character buffer of capacity + 1 bytes.
+ * @param length Pointer to the string length.
+ * @param capacity Maximum number of characters the buffer can hold.
+ * @param character The character to append.
+ *
+ * @return uint32_t 1 if the character was appended, 0 if the buffer was full.
+ */
+inline uint32_t sstr_core_append(char *data, uint32_t *length, uint32_t capacity, const char character)
+{
+    if (*length < capacity)
+    {
+        data[*length] = character;
+        data[*length + 1] = '\0';
+        (*length)++;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Core implementation of sstr_append_cstr_checked().
+ *
+ * @param data Character buffer of capacity + 1 bytes.
+ * @param length Pointer to the string length.
+ * @param capacity Maximum number of characters the buffer can hold.
+ * @param cstr Null-terminated C string to append.
+ * @param truncated Optional pointer set to 1 if cstr did not fit, 0 otherwise.
+ *
+ * @return uint32_t The number of characters appended.
+ */
+inline uint32_t sstr_core_append_cstr(char *data, uint32_t *length, uint32_t capacity, const char *cstr, uint32_t *truncated)
+{
+    if (truncated != NULL)
+    {
+        *truncated = 0;
+    }
+    if (cstr == NULL)
+    {
+        return 0;
+    }
+    if (*length >= capacity)
+    {
+        if (truncated != NULL)
+        {
+            *truncated = cstr[0] != '\0';
+        }
+        return 0;
+    }
+
+    uint32_t room = capacity - *length;
+    uint32_t i = sstr_kernels()->copy_cstr(data + *length, cstr, room);
+    data[*length + i] = '\0';
+    *length += i;
+    if (truncated != NULL && i == room)
+    {
+        *truncated = cstr[i] != '\0';
+    }
+    return i;
+}
+
+/**
+ * @brief Core implementation of sstr_replace_char_from_index().
+ *
+ * @param data Character buffer.
+ * @param length Current string length.
+ * @param capacity Maximum number of characters the buffer can hold.
+ * @param index Zero-based index of the character to replace.
+ * @param character The new character.
+ *
+ * @return uint32_t 1 if the replacement was successful, 0 otherwise.
+ */
+inline uint32_t sstr_core_replace_char_from_index(char *data, uint32_t length, uint32_t capacity, uint32_t index, char character)
+{
+    if (index >= length || index >= capacity || character == '\0')
+    {
+        return 0;
+    }
+
+    data[index] = character;
+    return 1;
+}
+
+/**
+ * @brief Core implementation of sstr_replace_all_chars().
+ *
+ * @param data Character buffer.
+ * @param length Current string length.
+ * @param old_char The character to search for.
+ * @param new_char The character to replace with.
+ *
+ * @return uint32_t The number of characters replaced.
+ */
+inline uint32_t sstr_core_replace_all_chars(char *data, uint32_t length, char old_char, char new_char)
+{
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < length; i++)
+    {
+        if (data[i] == old_char)
+        {
+            data[i] = new_char;
+            count++;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Core implementation of sstr_insert_char_at().
+ *
+ * @param data Character buffer of capacity + 1 bytes.
+ * @param length Pointer to the string length.
+ * @param capacity Maximum number of characters the buffer can hold.
+ * @param index Zero-based index where the character should be inserted.
+ * @param character The character to insert.
+ *
+ * @return uint32_t The new length of the string, or 0 if the index was out of bounds.
+ */
+inline uint32_t sstr_core_insert_char_at(char *data, uint32_t *length, uint32_t capacity, uint32_t index, char character)
+{
+    if (index > *length || *length >= capacity)
+    {
+        return 0;
+    }
+
+    memmove(data + index + 1, data + index, *length - index);
+    data[index] = character;
+    (*length)++;
+    data[*length] = '\0';
+
+    return *length;
+}
+
+/**
+ * @brief Core implementation of sstr_remove_at().
+ *
+ * @param data Character buffer.
+ * @param length Pointer to the string length.
+ * @param index Zero-based index of the character to remove.
+ *
+ * @return uint32_t The new length of the string.
+ */
+inline uint32_t sstr_core_remove_at(char *data, uint32_t *length, uint32_t index)
+{
+    if (index >= *length)
+    {
+        return *length;
+    }
+
+    memmove(data + index, data + index + 1, *length - index - 1);
+    (*length)--;
+    data[*length] = '\0';
+    return *length;
+}
+
+/**
+ * @brief Core implementation of sstr_remove_range().
+ *
+ * @param data Character buffer.
+ * @param length Pointer to the string length.
+ * @param start Zero-based index of the first character to remove.
+ * @param end Zero-based index of the last character to remove.
+ *
+ * @return uint32_t The new length of the string.
+ */
+inline uint32_t sstr_core_remove_range(char *data, uint32_t *length, uint32_t start, uint32_t end)
+{
+    if (start >= *length || end >= *length || start > end)
+    {
+        return *length;
+    }
+
+    memmove(data + start, data + end + 1, *length - end - 1);
+    *length = *length - (end - start + 1);
+    data[*length] = '\0';
+
+    return *length;
+}
+
+/**
+ * @brief Replaces count characters at index with src_length characters from src.
+ *
+ * The tail of the string is shifted once with memmove(). src may point into
+ * the string itself; its pieces are then copied from wherever the shift left
+ * them.
+ *
+ * @param data Character buffer of capacity + 1 bytes.
+ * @param length Pointer to the string length.
+ * @param capacity Maximum number of characters the buffer can hold.
+ * @param index Zero-based index of the first character to replace, at most *length.
+ * @param count Number of characters to replace, at most *length - index.
+ * @param src Characters to insert. May be NULL if src_length is 0.
+ * @param src_length Number of characters to insert.
+ *
+ * @return uint32_t 1 if the string was modified, 0 if the result would not fit.
+ */
+inline uint32_t sstr_core_splice(char *data, uint32_t *length, uint32_t capacity, uint32_t index, uint32_t count, const char *src,
+                                 uint32_t src_length)
+{
+    uint32_t kept = *length - count;
+    if (src_length > capacity - kept)
+    {
+        return 0;
+    }
+    uint32_t end = index + count; // First character after the replaced range
+    uint32_t tail = *length - end;
+
+    if (src_length <= count)
+    {
+        // The tail moves left, after src has been read
+        if (src_length > 0)
+        {
+            memmove(data + index, src, src_length);
+        }
+        memmove(data + index + src_length, data + end, tail);
+    }
+    else if (src + src_length <= data || src >= data + *length)
+    {
+        memmove(data + index + src_length, data + end, tail);
+        memcpy(data + index, src, src_length);
+    }
+    else
+    {
+        // The tail moves right over part of src: the piece inside the replaced range
+        // stays in place, the piece after it moves with the tail
+        uint32_t offset = (uint32_t)(src - data);
+        uint32_t src_end = offset + src_length;
+        uint32_t before = offset < index ? (src_end < index ? src_end : index) - offset : 0;
+        uint32_t inside_start = offset > index ? offset : index;
+        uint32_t inside_end = src_end < end ? src_end : end;
+        uint32_t inside = inside_end > inside_start ? inside_end - inside_start : 0;
+        uint32_t after = src_length - before - inside;
+        uint32_t after_start = (offset > end ? offset : end) + (src_length - count);
+
+        memmove(data + index + src_length, data + end, tail);
+        memmove(data + index + before, data + inside_start, inside);
+        memcpy(data + index, data + offset, before);
+        memcpy(data + index + before + inside, data + after_start, after);
+    }
+
+    *length = kept + src_length;
+    data[*length] = '\0';
+    return 1;
+}
+
+/**
+ * @brief Core implementation of sstr_insert().
+ *
+ * @param data Character buffer of capacity + 1 bytes.
+ * @param length Pointer to the string length.
+ * @param capacity Maximum number of characters the buffer can hold.
+ * @param index Zero-based index where the characters should be inserted.
+ * @param src Characters to insert; may point into the string itself.
+ * @param src_length Number of characters to insert.
+ *
+ * @return uint32_t 1 if the characters were inserted, 0 if the index is out of bounds or they do not fit.
+ */
+inline uint32_t sstr_core_insert(char *data, uint32_t *length, uint32_t capacity, uint32_t index, const char *src, uint32_t src_length)
+{
+    if (index > *length || (src == NULL && src_length > 0))
+    {
+        return 0;
+    }
+    return sstr_core_splice(data, length, capacity, index, 0, src, src_length);
+}
+
+/**
+ * @brief Core implementation of sstr_replace_range().
+ *
+ * @param data Character buffer of capacity + 1 bytes.
+ * @param length Pointer to the string length.
+ * @param capacity Maximum number of characters the buffer can hold.
+ * @param start Zero-based index of the first character to replace.
+ * @param end Zero-based index of the last character to replace.
+ * @param src Replacement characters; may point into the string itself.
+ * @param src_length Number of replacement characters.
+ *
+ * @return uint32_t 1 if the range was replaced, 0 if the indices are invalid or the result does not fit.
+ */
+inline uint32_t sstr_core_replace_range(char *data, uint32_t *length, uint32_t capacity, uint32_t start, uint32_t end, const char *src,
+                                        uint32_t src_length)
+{
+    if (start >= *length || end >= *length || start > end || (src == NULL && src_length > 0))
+    {
+        return 0;
+    }
+    return sstr_core_splice(data, length, capacity, start, end - start + 1, src, src_length);
+}
+
+/**
+ * @brief Core implementation of sstr_substring().
+ *
+ * Unlike the StaticString API, source and destination may have different
+ * capacities; the copy fails if the range does not fit the destination.
+ *
+ * @param src Source character buffer.
+ * @param src_length Source string length.
+ * @param dest Destination character buffer of dest_capacity + 1 bytes.
+ * @param dest_length Pointer to the destination string length.
+ * @param dest_capacity Maximum number of characters the destination can hold.
+ * @param start Zero-based index of the first character to copy.
+ * @param end Zero-based index of the last character to copy.
+ *
+ * @return uint32_t 1 if the operation is successful, 0 otherwise.
+ */
+inline uint32_t sstr_core_substring(const char *src, uint32_t src_length, char *dest, uint32_t *dest_length, uint32_t dest_capacity, uint32_t start, uint32_t end)
+{
+    if (start >= src_length || end >= src_length || start > end)
+    {
+        return 0;
+    }
+    if (end - start + 1 > dest_capacity)
+    {
+        return 0;
+    }
+
+    *dest_length = end - start + 1;
+    memmove(dest, src + start, *dest_length);
+    dest[*dest_length] = '\0';
+    return 1;
+}
+
+/**
+ * @brief Core implementation of sstr_trim_trailing().
+ *
+ * @param data Character buffer.
+ * @param length Pointer to the string length.
+ *
+ * @return uint32_t The number of characters trimmed from the end.
+ */
+inline uint32_t sstr_core_trim_trailing(char *data, uint32_t *length)
+{
+    uint32_t count = sstr_kernels()->span_class_reverse(data, *length, sstr_char_class_whitespace());
+    *length -= count;
+    data[*length] = '\0';
+    return count;
+}
+
+/**
+ * @brief Core implementation of sstr_trim_leading().
+ *
+ * @param data Character buffer.
+ * @param length Pointer to the string length.
+ *
+ * @return uint32_t The number of characters removed from the beginning.
+ */
+inline uint32_t sstr_core_trim_leading(char *data, uint32_t *length)
+{
+    uint32_t offset = sstr_kernels()->span_class(data, *length, sstr_char_class_whitespace());
+
+    if (offset > 0)
+    {
+        *length -= offset;
+        memmove(data, data + offset, *length);
+        data[*length] = '\0';
+    }
+
+    return offset;
+}
+
+/**
+ * @brief Core implementation of sstr_trim_class().
+ *
+ * Finds both bounds before moving anything, so the remaining characters are
+ * shifted at most once.
+ *
+ * @param data Character buffer.
+ * @param length Pointer to the string length.
+ * @param cls Class of the characters to trim.
+ *
+ * @return uint32_t The number of characters removed from both ends.
+ */
+inline uint32_t sstr_core_trim_class(char *data, uint32_t *length, const StaticStringCharClass *cls)
+{
+    if (*length == 0 || (!sstr_char_class_contains(cls, data[0]) && !sstr_char_class_contains(cls, data[*length - 1])))
+    {
+        return 0; // Nothing to trim, the common case
+    }
+    const SStrKernels *kernels = sstr_kernels();
+    uint32_t start = kernels->span_class(data, *length, cls);
+    uint32_t kept = 0;
+    if (start < *length)
+    {
+        kept = *length - start - kernels->span_class_reverse(data + start, *length - start, cls);
+    }
+    if (start > 0)
+    {
+        memmove(data, data + start, kept);
+    }
+    uint32_t removed = *length - kept;
+    *length = kept;
+    data[kept] = '\0';
+    return removed;
+}
+
+/**
+ * @brief Core implementation of sstr_trim().
+ *
+ * @param data Character buffer.
+ * @param length Pointer to the string length.
+ *
+ * @return uint32_t The number of characters removed from both ends.
+ */
+inline uint32_t sstr_core_trim(char *data, uint32_t *length)
+{
+    return sstr_core_trim_class(data, length, sstr_char_class_whitespace());
+}
+
+/**
+ * @brief Core implementation of sstr_strip_class().
+ *
+ * @param data Character buffer.
+ * @param length Pointer to the string length.
+ * @param cls Class of the characters to remove.
+ *
+ * @return uint32_t The number of characters removed.
+ */
+inline uint32_t sstr_core_strip_class(char *data, uint32_t *length, const StaticStringCharClass *cls)
+{
+    uint32_t kept = sstr_kernels()->compact_class(data, *length, cls);
+    data[kept] = '\0';
+    uint32_t removed = *length - kept;
+    *length = kept;
+    return removed;
+}
+
+/**
+ * @brief Core implementation of sstr_strip_all_whitespace().
+ *
+ * @param data Character buffer.
+ * @param length Pointer to the string length.
+ *
+ * @return uint32_t The number of characters removed.
+ */
+inline uint32_t sstr_core_strip_all_whitespace(char *data, uint32_t *length)
+{
+    return sstr_core_strip_class(data, length, sstr_char_class_whitespace());
+}
+
+/**
+ * @brief Core implementation of sstr_equals().
+ *
+ * @param data1 First character buffer.
+ * @param length1 Length of the first string.
+ * @param data2 Second character buffer.
+ * @param length2 Length of the second string.
+ *
+ * @return uint32_t 1 if the strings are equal, 0 otherwise.
+ */
+inline uint32_t sstr_core_equals(const char *data1, uint32_t length1, const char *data2, uint32_t length2)
+{
+    if (length1 != length2)
+    {
+        return 0;
+    }
+    if (length1 <= 16)
+    {
+        return sstr_equals_small(data1, data2, length1);
+    }
+    // Reject on the first word before paying for the kernel dispatch
+    if (sstr_load64(data1) != sstr_load64(data2))
+    {
+        return 0;
+    }
+    return sstr_kernels()->equals(data1, data2, length1);
+}
+
+/**
+ * @brief Core implementation of sstr_compare().
+ *
+ * @param data1 First character buffer.
+ * @param length1 Length of the first string.
+ * @param data2 Second character buffer.
+ * @param length2 Length of the second string.
+ *
+ * @return int32_t -1, 0 or 1 as the first string orders before, equal to or after the second.
+ */
+inline int32_t sstr_core_compare(const char *data1, uint32_t length1, const char *data2, uint32_t length2)
+{
+    uint32_t common = length1 < length2 ? length1 : length2;
+    uint32_t i = 0;
+    if (common > 16 && sstr_load64(data1) == sstr_load64(data2))
+    {
+        i = 8 + sstr_kernels()->mismatch(data1 + 8, data2 + 8, common - 8);
+    }
+    else
+    {
+        // Short strings and first-word mismatches are resolved with word loads, without dispatch
+        i = sstr_kernel_mismatch_scalar(data1, data2, common <= 16 ? common : 8);
+    }
+    if (i < common)
+    {
+        return (uint8_t)data1[i] < (uint8_t)data2[i] ? -1 : 1;
+    }
+    if (length1 == length2)
+    {
+        return 0;
+    }
+    return length1 < length2 ? -1 : 1;
+}
+
+/**
+ * @brief Core implementation of sstr_equals_cstr().
+ *
+ * @param data Character buffer.
+ * @param length String length.
+ * @param cstr Pointer to the null-terminated C string.
+ *
+ * @return uint32_t 1 if the strings are equal, 0 otherwise.
+ */
+inline uint32_t sstr_core_equals_cstr(const char *data, uint32_t length, const char *cstr)
+{
+    if (cstr == NULL)
+    {
+        return 0;
+    }
+
+    uint32_t i = 0;
+
+    while (i < length && cstr[i] != '\0')
+    {
+        if (data[i] != cstr[i])
+        {
+            return 0;
+        }
+        i++;
+    }
+    return (i == length && cstr[i] == '\0');
+}
+
+/**
+ * @brief Core implementation of sstr_iequals().
+ *
+ * @param data1 First character buffer.
+ * @param length1 Length of the first string.
+ * @param data2 Second character buffer.
+ * @param length2 Length of the second string.
+ *
+ * @return uint32_t 1 if the strings are equal ignoring ASCII case, 0 otherwise.
+ */
+inline uint32_t sstr_core_iequals(const char *data1, uint32_t length1, const char *data2, uint32_t length2)
+{
+    if (length1 != length2)
+    {
+        return 0;
+    }
+    if (length1 <= 16)
+    {
+        return sstr_kernel_imismatch_scalar(data1, data2, length1) == length1;
+    }
+    return sstr_kernels()->imismatch(data1, data2, length1) == length1;
+}
+
+/**
+ * @brief Core implementation of sstr_icompare().
+ *
+ * Orders like sstr_core_compare() applied to both strings folded to lowercase.
+ *
+ * @param data1 First character buffer.
+ * @param length1 Length of the first string.
+ * @param data2 Second character buffer.
+ * @param length2 Length of the second string.
+ *
+ * @return int32_t -1, 0 or 1 as the first string orders before, equal to or after the second.
+ */
+inline int32_t sstr_core_icompare(const char *data1, uint32_t length1, const char *data2, uint32_t length2)
+{
+    uint32_t common = length1 < length2 ? length1 : length2;
+    uint32_t i = common <= 16 ? sstr_kernel_imismatch_scalar(data1, data2, common) : sstr_kernels()->imismatch(data1, data2, common);
+    if (i < common)
+    {
+        return (uint8_t)sstr_fold_lower(data1[i]) < (uint8_t)sstr_fold_lower(data2[i]) ? -1 : 1;
+    }
+    if (length1 == length2)
+    {
+        return 0;
+    }
+    return length1 < length2 ? -1 : 1;
+}
+
+/**
+ * @brief Core implementation of sstr_iequals_cstr().
+ *
+ * @param data Character buffer.
+ * @param length String length.
+ * @param cstr Pointer to the null-terminated C string.
+ *
+ * @return uint32_t 1 if the strings are equal ignoring ASCII case, 0 otherwise.
+ */
+inline uint32_t sstr_core_iequals_cstr(const char *data, uint32_t length, const char *cstr)
+{
+    if (cstr == NULL)
+    {
+        return 0;
+    }
+
+    uint32_t i = 0;
+
+    while (i < length && cstr[i] != '\0')
+    {
+        if (sstr_fold_lower(data[i]) != sstr_fold_lower(cstr[i]))
+        {
+            return 0;
+        }
+        i++;
+    }
+    return (i == length && cstr[i] == '\0');
+}
+
+/**
+ * @brief Core implementation of sstr_pop().
+ *
+ * @param data Character buffer.
+ * @param length Pointer to the string length.
+ *
+ * @return char The last character if available, otherwise 0.
+ */
+inline char sstr_core_pop(char *data, uint32_t *length)
+{
+    char return_char = 0;
+    if (*length > 0)
+    {
+        return_char = data[*length - 1];
+        data[*length - 1] = '\0';
+        (*length)--;
+    }
+    return return_char;
+}
+
+/**
+ * @brief Core implementation of sstr_truncate().
+ *
+ * @param data Character buffer.
+ * @param length Pointer to the string length.
+ * @param capacity Maximum number of characters the buffer can hold.
+ * @param new_length The desired new length of the string.
+ *
+ * @return uint32_t 1 if the truncation was successful, 0 otherwise.
+ */
+inline uint32_t sstr_core_truncate(char *data, uint32_t *length, uint32_t capacity, uint32_t new_length)
+{
+    if (new_length > *length || new_length > capacity)
+    {
+        return 0;
+    }
+
+    *length = new_length;
+    data[*length] = '\0';
+    return 1;
+}
+
+/**
+ * @brief Core implementation of sstr_reverse().
+ *
+ * @param data Character buffer.
+ * @param length String length.
+ *
+ * @return uint32_t 1 if the string was reversed, 0 if it is empty.
+ */
+inline uint32_t sstr_core_reverse(char *data, uint32_t length)
+{
+    if (length == 0)
+    {
+        return 0;
+    }
+    uint32_t i = 0, j = length - 1;
+    while (i < j)
+    {
+        char temp = data[i];
+        data[i] = data[j];
+        data[j] = temp;
+        i++;
+        j--;
+    }
+    return 1;
+}
+
+/**
+ * @brief Core implementation of sstr_copy().
+ *
+ * @param dest Destination character buffer of dest_capacity + 1 bytes.
+ * @param dest_length Pointer to the destination string length.
+ * @param dest_capacity Maximum number of characters the destination can hold.
+ * @param src Source character buffer.
+ * @param src_length Source string length.
+ *
+ * @return uint32_t 1 if the copy was successful, 0 if the source is too long.
+ */
+inline uint32_t sstr_core_copy(char *dest, uint32_t *dest_length, uint32_t dest_capacity, const char *src, uint32_t src_length)
+{
+    if (src_length > dest_capacity)
+    {
+        return 0;
+    }
+    *dest_length = src_length;
+    memmove(dest, src, src_length);
+    dest[src_length] = '\0';
+    return 1;
+}
+
+/**
+ * @brief Core implementation of sstr_to_uppercase().
+ *
+ * @param data Character buffer.
+ * @param length String length.
+ *
+ * @return uint32_t The number of characters that were converted.
+ */
+inline uint32_t sstr_core_to_uppercase(char *data, uint32_t length)
+{
+    return sstr_kernels()->flip_case(data, length, 'a');
+}
+
+/**
+ * @brief Core implementation of sstr_to_lowercase().
+ *
+ * @param data Character buffer.
+ * @param length String length.
+ *
+ * @return uint32_t The number of characters that were converted.
+ */
+inline uint32_t sstr_core_to_lowercase(char *data, uint32_t length)
+{
+    return sstr_kernels()->flip_case(data, length, 'A');
+}
+
+/**
+ * @brief Core implementation of sstr_translate().
+ *
+ * @param data Character buffer.
+ * @param length String length.
+ * @param table Translation table to apply.
+ *
+ * @return uint32_t The number of characters that were changed, 0 if table is NULL.
+ */
+inline uint32_t sstr_core_translate(char *data, uint32_t length, const StaticStringTranslation *table)
+{
+    if (table == NULL || table->active_rows == 0)
+    {
+        return 0;
+    }
+    return sstr_kernels()->translate(data, length, table);
+}
+
+// sstr_core_from_cstr() that flips the case of [first, first + 25] while copying
+inline uint32_t sstr_core_from_cstr_flip_case(char *data, uint32_t *length, uint32_t capacity, const char *cstr, uint32_t *truncated, char first)
+{
+    if (truncated != NULL)
+    {
+        *truncated = 0;
+    }
+    if (cstr == NULL)
+    {
+        return 0;
+    }
+    uint32_t i = sstr_kernels()->copy_cstr_flip_case(data, cstr, capacity, first);
+    data[i] = '\0';
+    *length = i;
+    if (truncated != NULL && i == capacity)
+    {
+        *truncated = cstr[i] != '\0';
+    }
+    return 1;
+}
+
+/**
+ * @brief Core implementation of sstr_from_cstr_lowercase().
+ *
+ * @param data Character buffer of capacity + 1 bytes.
+ * @param length Pointer to the string length.
+ * @param capacity Maximum number of characters the buffer can hold.
+ * @param cstr Null-terminated C string to copy from.
+ * @param truncated Optional pointer set to 1 if cstr did not fit, 0 otherwise.
+ *
+ * @return uint32_t 1 if the buffer was initialized, 0 if cstr is NULL.
+ */
+inline uint32_t sstr_core_from_cstr_lowercase(char *data, uint32_t *length, uint32_t capacity, const char *cstr, uint32_t *truncated)
+{
+    return sstr_core_from_cstr_flip_case(data, length, capacity, cstr, truncated, 'A');
+}
+
+/**
+ * @brief Core implementation of sstr_from_cstr_uppercase().
+ *
+ * @param data Character buffer of capacity + 1 bytes.
+ * @param length Pointer to the string length.
+ * @param capacity Maximum number of characters the buffer can hold.
+ * @param cstr Null-terminated C string to copy from.
+ * @param truncated Optional pointer set to 1 if cstr did not fit, 0 otherwise.
+ *
+ * @return uint32_t 1 if the buffer was initialized, 0 if cstr is NULL.
+ */
+inline uint32_t sstr_core_from_cstr_uppercase(char *data, uint32_t *length, uint32_t capacity, const char *cstr, uint32_t *truncated)
+{
+    return sstr_core_from_cstr_flip_case(data, length, capacity, cstr, truncated, 'a');
+}
+
+/**
+ * @brief Core implementation of sstr_contains().
+ *
+ * @param data Character buffer.
+ * @param length String length.
+ * @param ch The character to search for.
+ *
+ * @return uint32_t The number of times the character appears in the string.
+ */
+inline uint32_t sstr_core_contains(const char *data, uint32_t length, char ch)
+{
+    return sstr_kernels()->count_char(data, length, ch);
+}
+
+/**
+ * @brief Core implementation of sstr_first_index_of().
+ *
+ * @param data Character buffer.
+ * @param length String length.
+ * @param ch The character to find.
+ *
+ * @return int32_t The index of the first occurrence of the character, or -1 if not found.
+ */
+inline int32_t sstr_core_first_index_of(const char *data, uint32_t length, char ch)
+{
+    uint32_t index = sstr_kernels()->find_char(data, length, ch);
+    return index < length ? (int32_t)index : -1;
+}
+
+/**
+ * @brief Core implementation of sstr_last_index_of().
+ *
+ * @param data Character buffer.
+ * @param length String length.
+ * @param ch The character to find.
+ *
+ * @return int32_t The index of the last occurrence of the character, or -1 if not found.
+ */
+inline int32_t sstr_core_last_index_of(const char *data, uint32_t length, char ch)
+{
+    uint32_t index = sstr_kernels()->find_char_reverse(data, length, ch);
+    return index < length ? (int32_t)index : -1;
+}
+
+/**
+ * @brief Core implementation of sstr_index_of_from().
+ *
+ * @param data Character buffer.
+ * @param length String length.
+ * @param ch The character to find.
+ * @param start Index to start searching from.
+ *
+ * @return int32_t The index of the first occurrence at or after start, or -1 if not found.
+ */
+inline int32_t sstr_core_index_of_from(const char *data, uint32_t length, char ch, uint32_t start)
+{
+    if (start >= length)
+    {
+        return -1;
+    }
+    uint32_t index = sstr_kernels()->find_char(data + start, length - start, ch);
+    return index < length - start ? (int32_t)(start + index) : -1;
+}
+
+/**
+ * @brief Core implementation of sstr_span().
+ *
+ * @param data Character buffer.
+ * @param length String length.
+ * @param cls Character class.
+ *
+ * @return uint32_t The number of leading characters in the class.
+ */
+inline uint32_t sstr_core_span(const char *data, uint32_t length, const StaticStringCharClass *cls)
+{
+    return sstr_kernels()->span_class(data, length, cls);
+}
+
+/**
+ * @brief Core implementation of sstr_cspan().
+ *
+ * @param data Character buffer.
+ * @param length String length.
+ * @param cls Character class.
+ *
+ * @return uint32_t The number of leading characters outside the class.
+ */
+inline uint32_t sstr_core_cspan(const char *data, uint32_t length, const StaticStringCharClass *cls)
+{
+    return sstr_kernels()->find_class(data, length, cls);
+}
+
+/**
+ * @brief Core implementation of sstr_find_first_of().
+ *
+ * @param data Character buffer.
+ * @param length String length.
+ * @param cls Character class.
+ *
+ * @return int32_t The index of the first character in the class, or -1 if there is none.
+ */
+inline int32_t sstr_core_find_first_of(const char *data, uint32_t length, const StaticStringCharClass *cls)
+{
+    uint32_t index = sstr_core_cspan(data, length, cls);
+    return index < length ? (int32_t)index : -1;
+}
+
+/**
+ * @brief Core implementation of sstr_find_first_not_of().
+ *
+ * @param data Character buffer.
+ * @param length String length.
+ * @param cls Character class.
+ *
+ * @return int32_t The index of the first character outside the class, or -1 if there is none.
+ */
+inline int32_t sstr_core_find_first_not_of(const char *data, uint32_t length, const StaticStringCharClass *cls)
+{
+    uint32_t index = sstr_core_span(data, length, cls);
+    return index < length ? (int32_t)index : -1;
+}
+
+/**
+ * @brief Two-Way string matching (Crochemore-Perrin).
+ *
+ * Runs in O(haystack_length + needle_length) time with constant extra space.
+ * It is the fallback of the prefilter-based search when too many candidates
+ * fail verification. With reverse set, both strings are read back to front
+ * and the result is an offset from the end of the haystack. With fold set,
+ * both strings are read as if folded to lowercase.
+ *
+ * @param haystack Buffer to search.
+ * @param haystack_length Length of the haystack.
+ * @param needle Buffer to find.
+ * @param needle_length Length of the needle, at least 1.
+ * @param reverse Non-zero to search from the end.
+ * @param fold Non-zero to ignore ASCII case.
+ *
+ * @return uint32_t Offset of the first match in the scan direction, or haystack_length if none.
+ */
+inline uint32_t sstr_two_way(const char *haystack, uint32_t haystack_length, const char *needle, uint32_t needle_length, int reverse, int fold)
+{
+    // Reverse scans walk both buffers backwards from their last byte
+    const ptrdiff_t step = reverse ? -1 : 1;
+    const char *h_base = reverse ? haystack + haystack_length - 1 : haystack;
+    const char *n_base = reverse ? needle + needle_length - 1 : needle;
+    // ORed into uppercase letters only, so it is 0 for a case-sensitive search
+    const uint8_t fold_bit = fold ? 0x20 : 0;
+#define SSTR_TW_FOLD(c) ((uint8_t)((c) | ((uint8_t)((c) - 'A') < 26 ? fold_bit : 0)))
+#define SSTR_TW_H(i) SSTR_TW_FOLD((uint8_t)h_base[(ptrdiff_t)(i) * step])
+#define SSTR_TW_N(i) SSTR_TW_FOLD((uint8_t)n_base[(ptrdiff_t)(i) * step])
+    const uint32_t l = needle_length;
+    uint32_t byteset[8] = {0};
+    uint32_t shift[256];
+    uint32_t i, ip, jp, k, p, ms, p0, left, mem, mem0, pos;
+
+    for (i = 0; i < l; i++)
+    {
+        uint8_t c = SSTR_TW_N(i);
+        byteset[c >> 5] |= 1u << (c & 31);
+        shift[c] = i + 1;
+    }
+
+    // Maximal suffix for the byte order; ip starts at -1 and relies on unsigned wrap-around
+    ip = (uint32_t)-1;
+    jp = 0;
+    k = p = 1;
+    while (jp + k < l)
+    {
+        uint8_t a = SSTR_TW_N(ip + k), b = SSTR_TW_N(jp + k);
+        if (a == b)
+        {
+            if (k == p)
+            {
+                jp += p;
+                k = 1;
+            }
+            else
+            {
+                k++;
+            }
+        }
+        else if (a > b)
+        {
+            jp += k;
+            k = 1;
+            p = jp - ip;
+        }
+        else
+        {
+            ip = jp++;
+            k = p = 1;
+        }
+    }
+    ms = ip;
+    p0 = p;
+
+    // Maximal suffix for the opposite order; the longer one gives the critical factorization
+    ip = (uint32_t)-1;
+    jp = 0;
+    k = p = 1;
+    while (jp + k < l)
+    {
+        uint8_t a = SSTR_TW_N(ip + k), b = SSTR_TW_N(jp + k);
+        if (a == b)
+        {
+            if (k == p)
+            {
+                jp += p;
+                k = 1;
+            }
+            else
+            {
+                k++;
+            }
+        }
+        else if (a < b)
+        {
+            jp += k;
+            k = 1;
+            p = jp - ip;
+        }
+        else
+        {
+            ip = jp++;
+            k = p = 1;
+        }
+    }
+    if (ip + 1 > ms + 1)
+    {
+        ms = ip;
+    }
+    else
+    {
+        p = p0;
+    }
+    left = ms + 1; // Length of the left half
+
+    // A needle that is not periodic with period p can shift past the longer half
+    for (i = 0; i < left; i++)
+    {
+        if (SSTR_TW_N(i) != SSTR_TW_N(i + p))
+        {
+            break;
+        }
+    }
+    if (i < left)
+    {
+        mem0 = 0;
+        p = (left > l - left + 1 ? left : l - left + 1);
+    }
+    else
+    {
+        mem0 = l - p;
+    }
+
+    mem = 0;
+    pos = 0;
+    for (;;)
+    {
+        if (haystack_length - pos < l)
+        {
+            return haystack_length;
+        }
+
+        // Check the last byte of the window first and skip by the shift table on a miss
+        uint8_t c = SSTR_TW_H(pos + l - 1);
+        if (byteset[c >> 5] & (1u << (c & 31)))
+        {
+            k = l - shift[c];
+            if (k != 0)
+            {
+                if (k < mem)
+                {
+                    k = mem;
+                }
+                pos += k;
+                mem = 0;
+                continue;
+            }
+        }
+        else
+        {
+            pos += l;
+            mem = 0;
+            continue;
+        }
+
+        // Compare the right half, then the left half
+        for (k = (left > mem ? left : mem); k < l && SSTR_TW_N(k) == SSTR_TW_H(pos + k); k++)
+        {
+        }
+        if (k < l)
+        {
+            pos += k - left + 1;
+            mem = 0;
+            continue;
+        }
+        for (k = left; k > mem && SSTR_TW_N(k - 1) == SSTR_TW_H(pos + k - 1); k--)
+        {
+        }
+        if (k <= mem)
+        {
+            return pos;
+        }
+        pos += p;
+        mem = mem0;
+    }
+#undef SSTR_TW_H
+#undef SSTR_TW_N
+#undef SSTR_TW_FOLD
+}
+
+/**
+ * @brief Core implementation of sstr_find().
+ *
+ * Candidates whose first and last bytes match are located with the find_pair
+ * kernel and verified in the middle. Once failed verifications cost more than
+ * the bytes skipped so far, the search switches to sstr_two_way(), which keeps
+ * the worst case linear on adversarial input.
+ *
+ * @param haystack Buffer to search.
+ * @param haystack_length Length of the haystack.
+ * @param needle Buffer to find.
+ * @param needle_length Length of the needle.
+ * @param start Index at which the search starts.
+ *
+ * @return int32_t Index of the first match at or after start, or -1 if not found.
+ */
+inline int32_t sstr_core_find(const char *haystack, uint32_t haystack_length, const char *needle, uint32_t needle_length, uint32_t start)
+{
+    if (start > haystack_length || needle_length > haystack_length - start)
+    {
+        return -1;
+    }
+    if (needle_length == 0)
+    {
+        return (int32_t)start;
+    }
+
+    const SStrKernels *kernels = sstr_kernels();
+    const char *h = haystack + start;
+    uint32_t h_length = haystack_length - start;
+    if (needle_length == 1)
+    {
+        uint32_t index = kernels->find_char(h, h_length, needle[0]);
+        return index < h_length ? (int32_t)(start + index) : -1;
+    }
+
+    uint32_t distance = needle_length - 1;
+    uint32_t pos = 0;
+    uint64_t wasted = 0;
+    while (h_length - pos >= needle_length)
+    {
+        uint32_t offset = kernels->find_pair(h + pos, h_length - pos, needle[0], needle[distance], distance);
+        if (offset == h_length - pos)
+        {
+            return -1;
+        }
+        pos += offset;
+        if (needle_length <= 2 || sstr_core_equals(h + pos + 1, distance - 1, needle + 1, distance - 1))
+        {
+            return (int32_t)(start + pos);
+        }
+
+        wasted += needle_length;
+        pos++;
+        if (wasted > 4 * (uint64_t)pos + 16 * (uint64_t)needle_length)
+        {
+            uint32_t index = sstr_two_way(h + pos, h_length - pos, needle, needle_length, 0, 0);
+            return index < h_length - pos ? (int32_t)(start + pos + index) : -1;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Core implementation of sstr_ifind().
+ *
+ * Same strategy as sstr_core_find() with the case-insensitive kernels, and a
+ * case-folding sstr_two_way() as the fallback.
+ *
+ * @param haystack Buffer to search.
+ * @param haystack_length Length of the haystack.
+ * @param needle Buffer to find.
+ * @param needle_length Length of the needle.
+ * @param start Index at which the search starts.
+ *
+ * @return int32_t Index of the first match ignoring ASCII case at or after start, or -1 if not found.
+ */
+inline int32_t sstr_core_ifind(const char *haystack, uint32_t haystack_length, const char *needle, uint32_t needle_length, uint32_t start)
+{
+    if (start > haystack_length || needle_length > haystack_length - start)
+    {
+        return -1;
+    }
+    if (needle_length == 0)
+    {
+        return (int32_t)start;
+    }
+
+    const SStrKernels *kernels = sstr_kernels();
+    const char *h = haystack + start;
+    uint32_t h_length = haystack_length - start;
+    uint32_t distance = needle_length - 1;
+    char first = sstr_fold_lower(needle[0]);
+    char last = sstr_fold_lower(needle[distance]);
+    uint32_t pos = 0;
+    uint64_t wasted = 0;
+    while (h_length - pos >= needle_length)
+    {
+        uint32_t offset = kernels->ifind_pair(h + pos, h_length - pos, first, last, distance);
+        if (offset == h_length - pos)
+        {
+            return -1;
+        }
+        pos += offset;
+        if (needle_length <= 2 || kernels->imismatch(h + pos + 1, needle + 1, distance - 1) == distance - 1)
+        {
+            return (int32_t)(start + pos);
+        }
+
+        wasted += needle_length;
+        pos++;
+        if (wasted > 4 * (uint64_t)pos + 16 * (uint64_t)needle_length)
+        {
+            uint32_t index = sstr_two_way(h + pos, h_length - pos, needle, needle_length, 0, 1);
+            return index < h_length - pos ? (int32_t)(start + pos + index) : -1;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Core implementation of sstr_rfind().
+ *
+ * Mirror image of sstr_core_find(): candidates are located from the end with
+ * the find_pair_reverse kernel, and the search falls back to a reversed
+ * sstr_two_way() under the same budget.
+ *
+ * @param haystack Buffer to search.
+ * @param haystack_length Length of the haystack.
+ * @param needle Buffer to find.
+ * @param needle_length Length of the needle.
+ *
+ * @return int32_t Index of the last match, or -1 if not found.
+ */
+inline int32_t sstr_core_rfind(const char *haystack, uint32_t haystack_length, const char *needle, uint32_t needle_length)
+{
+    if (needle_length > haystack_length)
+    {
+        return -1;
+    }
+    if (needle_length == 0)
+    {
+        return (int32_t)haystack_length;
+    }
+    if (needle_length == 1)
+    {
+        return sstr_core_last_index_of(haystack, haystack_length, needle[0]);
+    }
+
+    const SStrKernels *kernels = sstr_kernels();
+    uint32_t distance = needle_length - 1;
+    uint32_t last_start = haystack_length - needle_length;
+    uint64_t wasted = 0;
+    for (uint32_t end = last_start + 1; end > 0;) // Candidates left are the positions before end
+    {
+        uint32_t pos = kernels->find_pair_reverse(haystack, end + distance, needle[0], needle[distance], distance);
+        if (pos == end + distance)
+        {
+            return -1;
+        }
+        end = pos;
+        if (needle_length <= 2 || sstr_core_equals(haystack + pos + 1, distance - 1, needle + 1, distance - 1))
+        {
+            return (int32_t)pos;
+        }
+
+        wasted += needle_length;
+        if (wasted > 4 * (uint64_t)(last_start - pos + 1) + 16 * (uint64_t)needle_length)
+        {
+            // Remaining matches start before pos, so they end before pos + distance
+            uint32_t limit = pos + distance;
+            uint32_t index = sstr_two_way(haystack, limit, needle, needle_length, 1, 0);
+            return index < limit ? (int32_t)(limit - index - needle_length) : -1;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Core implementation of sstr_find_all().
+ *
+ * @param haystack Buffer to search.
+ * @param haystack_length Length of the haystack.
+ * @param needle Buffer to find.
+ * @param needle_length Length of the needle.
+ * @param positions Array receiving match indices. May be NULL if max_positions is 0.
+ * @param max_positions Capacity of the positions array.
+ *
+ * @return uint32_t Total number of non-overlapping matches, which may exceed max_positions.
+ */
+inline uint32_t sstr_core_find_all(const char *haystack, uint32_t haystack_length, const char *needle, uint32_t needle_length,
+                                   uint32_t *positions, uint32_t max_positions)
+{
+    if (needle_length == 0)
+    {
+        return 0;
+    }
+    uint32_t count = 0;
+    uint32_t start = 0;
+    for (;;)
+    {
+        int32_t index = sstr_core_find(haystack, haystack_length, needle, needle_length, start);
+        if (index < 0)
+        {
+            break;
+        }
+        if (count < max_positions)
+        {
+            positions[count] = (uint32_t)index;
+        }
+        count++;
+        start = (uint32_t)index + needle_length;
+    }
+    return count;
+}
+
+/**
+ * @brief Core implementation of sstr_replace_all_cstr_checked().
+ *
+ * Matches are found left to right without overlapping, as in
+ * sstr_core_find_all(). A replacement no longer than the needle is applied
+ * in one forward pass; the write position never passes the read position.
+ * A longer replacement first measures how much of the result fits, moves
+ * that part of the string to the end of the buffer and rebuilds it front to
+ * back, so no match positions are stored. A result longer than capacity is
+ * cut off at capacity, and only occurrences whose replacement starts before
+ * the cut are counted.
+ *
+ * @param data Character buffer of capacity + 1 bytes.
+ * @param length Pointer to the string length.
+ * @param capacity Maximum number of characters the buffer can hold.
+ * @param needle Characters to replace; must not point into data.
+ * @param needle_length Length of the needle.
+ * @param replacement Replacement characters; must not point into data.
+ * @param replacement_length Length of the replacement.
+ * @param truncated Optional pointer set to 1 if the result was cut off at capacity, 0 otherwise.
+ *
+ * @return uint32_t The number of occurrences replaced, 0 if the needle is empty or a pointer is NULL.
+ */
+inline uint32_t sstr_core_replace_all(char *data, uint32_t *length, uint32_t capacity, const char *needle, uint32_t needle_length,
+                                      const char *replacement, uint32_t replacement_length, uint32_t *truncated)
+{
+    if (truncated != NULL)
+    {
+        *truncated = 0;
+    }
+    if (needle == NULL || needle_length == 0 || (replacement == NULL && replacement_length > 0))
+    {
+        return 0;
+    }
+    if (replacement == NULL)
+    {
+        replacement = ""; // Empty replacement; memcpy needs a valid pointer even for zero bytes
+    }
+    const uint32_t len = *length;
+    uint32_t count = 0;
+    uint32_t read = 0;
+    uint32_t write = 0;
+    int32_t match;
+
+    if (replacement_length <= needle_length)
+    {
+        while ((match = sstr_core_find(data, len, needle, needle_length, read)) >= 0)
+        {
+            uint32_t run = (uint32_t)match - read;
+            if (write != read)
+            {
+                memmove(data + write, data + read, run);
+            }
+            memcpy(data + write + run, replacement, replacement_length);
+            write += run + replacement_length;
+            read = (uint32_t)match + needle_length;
+            count++;
+        }
+        if (count > 0 && write != read)
+        {
+            memmove(data + write, data + read, len - read);
+            *length = write + (len - read);
+            data[*length] = '\0';
+        }
+        return count;
+    }
+
+    // Measure the prefix of the string whose replaced form fits, and the part of a
+    // replacement cut off at capacity
+    uint32_t out = 0;
+    uint32_t tail = 0;
+    uint32_t clipped = 0;
+    for (;;)
+    {
+        match = sstr_core_find(data, len, needle, needle_length, read);
+        uint32_t run = (match >= 0 ? (uint32_t)match : len) - read;
+        if (run > capacity - out)
+        {
+            read += capacity - out;
+            out = capacity;
+            clipped = 1;
+            break;
+        }
+        read += run;
+        out += run;
+        if (match < 0)
+        {
+            break;
+        }
+        if (out == capacity)
+        {
+            clipped = 1;
+            break;
+        }
+        count++;
+        if (replacement_length > capacity - out)
+        {
+            tail = capacity - out;
+            clipped = 1;
+            break;
+        }
+        read += needle_length;
+        out += replacement_length;
+    }
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    // The prefix grows by out - read; moving it up by that much keeps every write
+    // behind the next unread character
+    const uint32_t prefix = read;
+    const char *src = data + (out - prefix);
+    memmove(data + (out - prefix), data, prefix);
+    read = 0;
+    while ((match = sstr_core_find(src, prefix, needle, needle_length, read)) >= 0)
+    {
+        uint32_t run = (uint32_t)match - read;
+        memmove(data + write, src + read, run);
+        memcpy(data + write + run, replacement, replacement_length);
+        write += run + replacement_length;
+        read = (uint32_t)match + needle_length;
+    }
+    memmove(data + write, src + read, prefix - read);
+    write += prefix - read;
+    memcpy(data + write, replacement, tail);
+    *length = write + tail;
+    data[*length] = '\0';
+    if (truncated != NULL)
+    {
+        *truncated = clipped;
+    }
+    return count;
+}
+
+/**
+ * @brief Core implementation of sstr_replace_all_copy().
+ *
+ * Writes src to dest with every occurrence of the needle replaced, in one
+ * forward pass. The buffers must not overlap.
+ *
+ * @param src Source character buffer.
+ * @param src_length Source string length.
+ * @param dest Destination character buffer of dest_capacity + 1 bytes.
+ * @param dest_length Pointer to the destination string length.
+ * @param dest_capacity Maximum number of characters the destination can hold.
+ * @param needle Characters to replace; an empty needle copies src unchanged.
+ * @param needle_length Length of the needle.
+ * @param replacement Replacement characters.
+ * @param replacement_length Length of the replacement.
+ * @param truncated Optional pointer set to 1 if the result was cut off at dest_capacity, 0 otherwise.
+ *
+ * @return uint32_t The number of occurrences replaced, 0 if a pointer is NULL.
+ */
+inline uint32_t sstr_core_replace_all_copy(const char *src, uint32_t src_length, char *dest, uint32_t *dest_length,
+                                           uint32_t dest_capacity, const char *needle, uint32_t needle_length,
+                                           const char *replacement, uint32_t replacement_length, uint32_t *truncated)
+{
+    if (truncated != NULL)
+    {
+        *truncated = 0;
+    }
+    if (src == NULL || (needle == NULL && needle_length > 0) || (replacement == NULL && replacement_length > 0))
+    {
+        return 0;
+    }
+    if (replacement == NULL)
+    {
+        replacement = "";
+    }
+    uint32_t count = 0;
+    uint32_t read = 0;
+    uint32_t write = 0;
+    uint32_t clipped = 0;
+    for (;;)
+    {
+        int32_t match = needle_length > 0 ? sstr_core_find(src, src_length, needle, needle_length, read) : -1;
+        uint32_t run = (match >= 0 ? (uint32_t)match : src_length) - read;
+        if (run > dest_capacity - write)
+        {
+            run = dest_capacity - write;
+            clipped = 1;
+        }
+        memcpy(dest + write, src + read, run);
+        write += run;
+        if (clipped || match < 0)
+        {
+            break;
+        }
+        if (replacement_length > 0 && write == dest_capacity)
+        {
+            clipped = 1;
+            break;
+        }
+        count++;
+        uint32_t piece = replacement_length;
+        if (piece > dest_capacity - write)
+        {
+            piece = dest_capacity - write;
+            clipped = 1;
+        }
+        memcpy(dest + write, replacement, piece);
+        write += piece;
+        if (clipped)
+        {
+            break;
+        }
+        read = (uint32_t)match + needle_length;
+    }
+    dest[write] = '\0';
+    *dest_length = write;
+    if (truncated != NULL)
+    {
+        *truncated = clipped;
+    }
+    return count;
+}
+
+/*
+ * ---------------------------------------------------------------------------
+ * Hashing
+ *
+ * Strings hash to a polynomial state  sum(c[i] * B^(n - 1 - i)) mod 2^64,
+ * which is passed through a 64-bit finalizer together with the length. The
+ * state can be extended by appended characters and shrunk by removed suffix
+ * characters in time proportional to the change, which is what lets
+ * SSTR_CACHED_HASH keep it up to date on every mutation.
+ * ---------------------------------------------------------------------------
+ */
+
+#define SSTR_HASH_BASE 0x9E3779B97F4A7C15ULL         // Odd, so it is invertible modulo 2^64
+#define SSTR_HASH_BASE_INVERSE 0xF1DE83E19937733DULL // SSTR_HASH_BASE * SSTR_HASH_BASE_INVERSE == 1 modulo 2^64
+
+// base^exponent modulo 2^64
+inline uint64_t sstr_hash_pow(uint64_t base, uint32_t exponent)
+{
+    uint64_t result = 1;
+    while (exponent != 0)
+    {
+        if (exponent & 1)
+        {
+            result *= base;
+        }
+        base *= base;
+        exponent >>= 1;
+    }
+    return result;
+}
+
+/**
+ * @brief Extends a hash state with more characters.
+ *
+ * @param state Hash state of the preceding characters (0 for none).
+ * @param data Characters to append.
+ * @param length Number of characters to append.
+ *
+ * @return uint64_t Hash state of the preceding characters followed by data.
+ */
+inline uint64_t sstr_hash_extend(uint64_t state, const char *data, uint32_t length)
+{
+    const uint64_t b2 = SSTR_HASH_BASE * SSTR_HASH_BASE;
+    const uint64_t b3 = b2 * SSTR_HASH_BASE;
+    const uint64_t b4 = b2 * b2;
+    uint32_t i = 0;
+    // Four characters per step shorten the multiply dependency chain
+    for (; i + 4 <= length; i += 4)
+    {
+        state = state * b4 + (uint8_t)data[i] * b3 + (uint8_t)data[i + 1] * b2 + (uint8_t)data[i + 2] * SSTR_HASH_BASE + (uint8_t)data[i + 3];
+    }
+    for (; i < length; i++)
+    {
+        state = state * SSTR_HASH_BASE + (uint8_t)data[i];
+    }
+    return state;
+}
+
+/**
+ * @brief Removes trailing characters from a hash state.
+ *
+ * @param state Hash state of the whole string.
+ * @param suffix The trailing characters being removed.
+ * @param suffix_length Number of trailing characters.
+ *
+ * @return uint64_t Hash state of the string without the suffix.
+ */
+inline uint64_t sstr_hash_remove_suffix(uint64_t state, const char *suffix, uint32_t suffix_length)
+{
+    uint64_t suffix_state = sstr_hash_extend(0, suffix, suffix_length);
+    return (state - suffix_state) * sstr_hash_pow(SSTR_HASH_BASE_INVERSE, suffix_length);
+}
+
+/**
+ * @brief Turns a hash state into a well-mixed 64-bit hash.
+ *
+ * @param state Hash state of the characters.
+ * @param length Number of characters.
+ *
+ * @return uint64_t The hash value.
+ */
+inline uint64_t sstr_hash_finalize(uint64_t state, uint32_t length)
+{
+    uint64_t h = state ^ ((uint64_t)length * 0xC2B2AE3D27D4EB4FULL);
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/**
+ * @brief Core implementation of sstr_hash().
+ *
+ * @param data Character buffer.
+ * @param length String length.
+ *
+ * @return uint64_t The hash value.
+ */
+inline uint64_t sstr_core_hash(const char *data, uint32_t length)
+{
+    return sstr_hash_finalize(sstr_hash_extend(0, data, length), length);
+}
+
+/**
+ * @brief Core implementation of sstr_ihash().
+ *
+ * Folds each character to lowercase as it enters the hash, so the result
+ * equals sstr_core_hash() of the lowercased string without building it.
+ *
+ * @param data Character buffer.
+ * @param length String length.
+ *
+ * @return uint64_t The hash value.
+ */
+inline uint64_t sstr_core_ihash(const char *data, uint32_t length)
+{
+    const uint64_t b2 = SSTR_HASH_BASE * SSTR_HASH_BASE;
+    const uint64_t b3 = b2 * SSTR_HASH_BASE;
+    const uint64_t b4 = b2 * b2;
+    uint64_t state = 0;
+    uint32_t i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        uint64_t x = sstr_load64(data + i);
+        char folded[8];
+        sstr_store64(folded, x ^ sstr_case_flips64(x, 'A'));
+        state = state * b4 + (uint8_t)folded[0] * b3 + (uint8_t)folded[1] * b2 + (uint8_t)folded[2] * SSTR_HASH_BASE + (uint8_t)folded[3];
+        state = state * b4 + (uint8_t)folded[4] * b3 + (uint8_t)folded[5] * b2 + (uint8_t)folded[6] * SSTR_HASH_BASE + (uint8_t)folded[7];
+    }
+    for (; i < length; i++)
+    {
+        state = state * SSTR_HASH_BASE + (uint8_t)sstr_fold_lower(data[i]);
+    }
+    return sstr_hash_finalize(state, length);
+}
+
+/*
+ * ---------------------------------------------------------------------------
+ * StaticString C API
+ * ---------------------------------------------------------------------------
+ */
+
+/*
+ * Cached hash maintenance. With SSTR_CACHED_HASH disabled these compile to
+ * nothing; each mutating function calls the cheapest one that applies.
+ */
+
+#if SSTR_CACHED_HASH
+inline void sstr_cache_rebuild(StaticString *sstr)
+{
+    sstr->string_hash = sstr_hash_extend(0, sstr->static_string, sstr->string_length);
+}
+
+// Characters from old_length onwards were appended
+inline void sstr_cache_extend(StaticString *sstr, uint32_t old_length)
+{
+    sstr->string_hash = sstr_hash_extend(sstr->string_hash, sstr->static_string + old_length, sstr->string_length - old_length);
+}
+
+// Must run before the string is truncated to new_length
+inline void sstr_cache_truncate(StaticString *sstr, uint32_t new_length)
+{
+    if (new_length <= sstr->string_length)
+    {
+        sstr->string_hash = sstr_hash_remove_suffix(sstr->string_hash, sstr->static_string + new_length, sstr->string_length - new_length);
+    }
+}
+
+// The character at index changed from old_char
+inline void sstr_cache_replace(StaticString *sstr, uint32_t index, char old_char)
+{
+    uint64_t weight = sstr_hash_pow(SSTR_HASH_BASE, sstr->string_length - 1 - index);
+    sstr->string_hash += ((uint64_t)(uint8_t)sstr->static_string[index] - (uint64_t)(uint8_t)old_char) * weight;
+}
+#else
+inline void sstr_cache_rebuild(StaticString *sstr)
+{
+    (void)sstr;
+}
+
+inline void sstr_cache_extend(StaticString *sstr, uint32_t old_length)
+{
+    (void)sstr;
+    (void)old_length;
+}
+
+inline void sstr_cache_truncate(StaticString *sstr, uint32_t new_length)
+{
+    (void)sstr;
+    (void)new_length;
+}
+
+inline void sstr_cache_replace(StaticString *sstr, uint32_t index, char old_char)
+{
+    (void)sstr;
+    (void)index;
+    (void)old_char;
+}
+#endif
+
+/**
+ * @brief Initializes a StaticString structure.
+ *
+ * Sets the string length to 0 and null-terminates the internal character buffer.
+ *
+ * @param sstr Pointer to the StaticString to initialize.
+ *
+ * @warning This function does not clear the internal character buffer.
+ *
+ * @return uint32_t 1 if the StaticString was successfully initialized, 0 otherwise.
+ */
+inline uint32_t sstr_init(StaticString *sstr)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_init(sstr->static_string, &sstr->string_length);
+    sstr_cache_rebuild(sstr);
+    return result;
+}
+
+/**
+ * @brief Initializes a StaticString from a null-terminated C string.
+ *
+ * Copies characters from the given C string into the StaticString's internal buffer,
+ * truncating if necessary to fit within the maximum allowed length.
+ *
+ * @param sstr Pointer to the StaticString to initialize.
+ * @param cstr Null-terminated C string to copy from.
+ *
+ * @return uint32_t 1 if the StaticString was successfully initialized, 0 otherwise.
+ */
+inline uint32_t sstr_from_cstr(StaticString *sstr, const char *cstr)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_from_cstr(sstr->static_string, &sstr->string_length, SSTR_MAX_LENGTH, cstr, NULL);
+    sstr_cache_rebuild(sstr);
+    return result;
+}
+
+/**
+ * @brief Initializes a StaticString from a C string and reports truncation.
+ *
+ * Same as sstr_from_cstr(), but tells the caller whether the C string was
+ * longer than the maximum allowed length and had to be clipped.
+ *
+ * @param sstr Pointer to the StaticString to initialize.
+ * @param cstr Null-terminated C string to copy from.
+ * @param truncated Pointer set to 1 if cstr was truncated, 0 otherwise. May be NULL.
+ *
+ * @return uint32_t 1 if the StaticString was successfully initialized, 0 otherwise.
+ */
+inline uint32_t sstr_from_cstr_checked(StaticString *sstr, const char *cstr, uint32_t *truncated)
+{
+    if (sstr == NULL)
+    {
+        if (truncated != NULL)
+        {
+            *truncated = 0;
+        }
+        return 0;
+    }
+    uint32_t result = sstr_core_from_cstr(sstr->static_string, &sstr->string_length, SSTR_MAX_LENGTH, cstr, truncated);
+    sstr_cache_rebuild(sstr);
+    return result;
+}
+
+/**
+ * @brief Clears the contents of a StaticString.
+ *
+ * Resets the string length to 0 and null-terminates the buffer in constant time.
+ *
+ * @param sstr Pointer to the StaticString to clear.
+ *
+ * @warning The previous characters remain in the internal buffer. Use
+ *          sstr_secure_wipe() for strings that held secrets.
+ *
+ * @return uint32_t 1 if the StaticString was successfully cleared, 0 otherwise.
+ */
+inline uint32_t sstr_clear(StaticString *sstr)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_clear(sstr->static_string, &sstr->string_length, SSTR_MAX_LENGTH);
+    sstr_cache_rebuild(sstr);
+    return result;
+}
+
+/**
+ * @brief Clears a StaticString and zeroes its entire buffer.
+ *
+ * Unlike sstr_clear(), every byte of the internal buffer is overwritten, and
+ * the stores are not removed by the optimizer even if the string is never
+ * read again. Intended for strings that held credentials or other secrets;
+ * it costs time proportional to SSTR_MAX_LENGTH.
+ *
+ * @param sstr Pointer to the StaticString to wipe.
+ *
+ * @return uint32_t 1 if the StaticString was successfully wiped, 0 otherwise.
+ */
+inline uint32_t sstr_secure_wipe(StaticString *sstr)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_secure_wipe(sstr->static_string, &sstr->string_length, SSTR_MAX_LENGTH);
+    sstr_cache_rebuild(sstr);
+    return result;
+}
+
+/**
+ * @brief Appends a single character to the end of a StaticString.
+ *
+ * Adds the given character to the end of the string, null-terminates the result,
+ * and updates the string length. If the string is already full, the character is not added.
+ *
+ * @param sstr Pointer to the StaticString to modify.
+ * @param character The character to append.
+ *
+ * @return uint32_t 1 if the character was appended, 0 if the string was full.
+ */
+inline uint32_t sstr_append(StaticString *sstr, const char character)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    uint32_t old_length = sstr->string_length;
+    uint32_t result = sstr_core_append(sstr->static_string, &sstr->string_length, SSTR_MAX_LENGTH, character);
+    sstr_cache_extend(sstr, old_length);
+    return result;
+}
+
+/**
+ * @brief Appends a null-terminated C string to a StaticString.
+ *
+ * Safely appends characters from the given C string to the end of the StaticString,
+ * truncating if necessary to prevent buffer overflow. If the input string is NULL
+ * or the StaticString is already full, the operation is skipped.
+ *
+ * @param sstr Pointer to the StaticString to modify.
+ * @param cstr Null-terminated C string to append.
+ *
+ * @return uint32_t The number of characters appended.
+ */
+inline uint32_t sstr_append_cstr(StaticString *sstr, const char *cstr)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    uint32_t old_length = sstr->string_length;
+    uint32_t result = sstr_core_append_cstr(sstr->static_string, &sstr->string_length, SSTR_MAX_LENGTH, cstr, NULL);
+    sstr_cache_extend(sstr, old_length);
+    return result;
+}
+
+/**
+ * @brief Appends a C string to a StaticString and reports truncation.
+ *
+ * Same as sstr_append_cstr(), but tells the caller whether part of the C
+ * string was dropped because the StaticString became full.
+ *
+ * @param sstr Pointer to the StaticString to modify.
+ * @param cstr Null-terminated C string to append.
+ * @param truncated Pointer set to 1 if cstr was truncated, 0 otherwise. May be NULL.
+ *
+ * @return uint32_t The number of characters appended.
+ */
+inline uint32_t sstr_append_cstr_checked(StaticString *sstr, const char *cstr, uint32_t *truncated)
+{
+    if (sstr == NULL)
+    {
+        if (truncated != NULL)
+        {
+            *truncated = 0;
+        }
+        return 0;
+    }
+    uint32_t old_length = sstr->string_length;
+    uint32_t result = sstr_core_append_cstr(sstr->static_string, &sstr->string_length, SSTR_MAX_LENGTH, cstr, truncated);
+    sstr_cache_extend(sstr, old_length);
+    return result;
+}
+
+/**
+ * @brief Replaces a character in a StaticString at a given index.
+ *
+ * If the index is within the bounds of the current string length, replaces
+ * the character at that index with the given character.
+ *
+ * @param sstr Pointer to the StaticString to modify.
+ * @param index Zero-based index of the character to replace.
+ * @param character The new character to write at the specified index.
+ *
+ * @warning This function does not allow null characters.
+ *
+ * @return uint32_t 1 if the replacement was successful, 0 if otherwise.
+ */
+inline uint32_t sstr_replace_char_from_index(StaticString *sstr, uint32_t index, char character)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    char old_char = index < sstr->string_length ? sstr->static_string[index] : '\0';
+    uint32_t result = sstr_core_replace_char_from_index(sstr->static_string, sstr->string_length, SSTR_MAX_LENGTH, index, character);
+    if (result)
+    {
+        sstr_cache_replace(sstr, index, old_char);
+    }
+    return result;
+}
+
+/**
+ * @brief Replaces all occurrences of a character in a StaticString.
+ *
+ * Iterates through the StaticString and replaces every instance of the specified
+ * old character with the new character.
+ *
+ * @param sstr Pointer to the StaticString to modify.
+ * @param old_char The character to search for.
+ * @param new_char The character to replace with.
+ *
+ * @return uint32_t The number of characters replaced.
+ */
+inline uint32_t sstr_replace_all_chars(StaticString *sstr, char old_char, char new_char)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_replace_all_chars(sstr->static_string, sstr->string_length, old_char, new_char);
+    if (result)
+    {
+        sstr_cache_rebuild(sstr);
+    }
+    return result;
+}
+
+/**
+ * @brief Inserts a single character into a StaticString at a given index.
+ *
+ * Shifts all characters at and after the given index to the right by one position
+ * and inserts the given character at the specified index. If the index is greater
+ * than the current string length, the character is not inserted.
+ *
+ * @param sstr Pointer to the StaticString to modify.
+ * @param index Zero-based index where the character should be inserted.
+ * @param character The character to insert.
+ *
+ * @return uint32_t The new length of the string, or 0 if the index was out of bounds.
+ */
+inline uint32_t sstr_insert_char_at(StaticString *sstr, uint32_t index, char character)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_insert_char_at(sstr->static_string, &sstr->string_length, SSTR_MAX_LENGTH, index, character);
+    if (result)
+    {
+        sstr_cache_rebuild(sstr);
+    }
+    return result;
+}
+
+/**
+ * @brief Removes a single character from a StaticString at a given index.
+ *
+ * Shifts all characters at and after the given index to the left by one position
+ * and removes the character at the specified index. If the index is greater
+ * than the current string length, the function does not modify the string.
+ *
+ * @param sstr Pointer to the StaticString to modify.
+ * @param index Zero-based index of the character to remove.
+ *
+ * @return uint32_t The new length of the string.
+ */
+inline uint32_t sstr_remove_at(StaticString *sstr, uint32_t index)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_remove_at(sstr->static_string, &sstr->string_length, index);
+    sstr_cache_rebuild(sstr); // The result is the new length, which is 0 after removing the last character
+    return result;
+}
+
+/**
+ * @brief Removes a range of characters from a StaticString.
+ *
+ * Shifts all characters at and after the given start index to the left by the
+ * given range length and removes the characters at the specified range.
+ * If the start index is greater than the current string length, the function
+ * does not modify the string.
+ *
+ * @param sstr Pointer to the StaticString to modify.
+ * @param start Zero-based index of the first character to remove.
+ * @param end Zero-based index of the last character to remove.
+ *
+ * @return uint32_t The new length of the string.
+ */
+inline uint32_t sstr_remove_range(StaticString *sstr, uint32_t start, uint32_t end)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_remove_range(sstr->static_string, &sstr->string_length, start, end);
+    sstr_cache_rebuild(sstr); // The result is the new length, which is 0 after removing the last character
+    return result;
+}
+
+/**
+ * @brief Inserts another StaticString into a StaticString at a given index.
+ *
+ * Shifts the characters at and after the index to the right once, by the
+ * length of src, and copies src into the gap. Unlike repeated calls to
+ * sstr_insert_char_at(), the tail is moved a single time. src may be sstr
+ * itself. Nothing is inserted if the result would exceed the maximum length.
+ *
+ * @param sstr Pointer to the StaticString to modify.
+ * @param index Zero-based index where src should be inserted, at most the string length.
+ * @param src Pointer to the StaticString to insert.
+ *
+ * @return uint32_t 1 if src was inserted, 0 otherwise.
+ */
+inline uint32_t sstr_insert(StaticString *sstr, uint32_t index, const StaticString *src)
+{
+    if (sstr == NULL || src == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_insert(sstr->static_string, &sstr->string_length, SSTR_MAX_LENGTH, index, src->static_string, src->string_length);
+    if (result)
+    {
+        sstr_cache_rebuild(sstr);
+    }
+    return result;
+}
+
+/**
+ * @brief Inserts a null-terminated C string into a StaticString at a given index.
+ *
+ * @param sstr Pointer to the StaticString to modify.
+ * @param index Zero-based index where cstr should be inserted, at most the string length.
+ * @param cstr Null-terminated C string to insert.
+ *
+ * @return uint32_t 1 if cstr was inserted, 0 if the index is out of bounds or it does not fit.
+ */
+inline uint32_t sstr_insert_cstr(StaticString *sstr, uint32_t index, const char *cstr)
+{
+    if (sstr == NULL || cstr == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_insert(sstr->static_string, &sstr->string_length, SSTR_MAX_LENGTH, index, cstr, (uint32_t)strlen(cstr));
+    if (result)
+    {
+        sstr_cache_rebuild(sstr);
+    }
+    return result;
+}
+
+/**
+ * @brief Replaces a range of characters in a StaticString with another StaticString.
+ *
+ * The range is zero-based and inclusive, as in sstr_remove_range(). The
+ * characters after the range are shifted once to close or open the gap.
+ * src may be sstr itself.
+ *
+ * @param sstr Pointer to the StaticString to modify.
+ * @param start Zero-based index of the first character to replace.
+ * @param end Zero-based index of the last character to replace.
+ * @param src Pointer to the replacement StaticString.
+ *
+ * @return uint32_t 1 if the range was replaced, 0 if the indices are invalid or the result does not fit.
+ */
+inline uint32_t sstr_replace_range(StaticString *sstr, uint32_t start, uint32_t end, const StaticString *src)
+{
+    if (sstr == NULL || src == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_replace_range(sstr->static_string, &sstr->string_length, SSTR_MAX_LENGTH, start, end,
+                                              src->static_string, src->string_length);
+    if (result)
+    {
+        sstr_cache_rebuild(sstr);
+    }
+    return result;
+}
+
+/**
+ * @brief Replaces a range of characters in a StaticString with a null-terminated C string.
+ *
+ * @param sstr Pointer to the StaticString to modify.
+ * @param start Zero-based index of the first character to replace.
+ * @param end Zero-based index of the last character to replace.
+ * @param cstr Null-terminated replacement string.
+ *
+ * @return uint32_t 1 if the range was replaced, 0 if the indices are invalid or the result does not fit.
+ */
+inline uint32_t sstr_replace_range_cstr(StaticString *sstr, uint32_t start, uint32_t end, const char *cstr)
+{
+    if (sstr == NULL || cstr == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_replace_range(sstr->static_string, &sstr->string_length, SSTR_MAX_LENGTH, start, end, cstr,
+                                              (uint32_t)strlen(cstr));
+    if (result)
+    {
+        sstr_cache_rebuild(sstr);
+    }
+    return result;
+}
+
+/**
+ * @brief Replaces every occurrence of a substring in a StaticString.
+ *
+ * Occurrences are found left to right without overlapping, with the same
+ * search as sstr_find(), and the string is rewritten in a single pass, or
+ * two when the replacement is longer than the needle. If the result is
+ * longer than SSTR_MAX_LENGTH it is cut off; use
+ * sstr_replace_all_cstr_checked() to detect that.
+ *
+ * @param sstr Pointer to the StaticString to modify.
+ * @param needle Pointer to the substring to replace; must not be sstr.
+ * @param replacement Pointer to the replacement; must not be sstr.
+ *
+ * @return uint32_t The number of occurrences replaced, 0 if the needle is empty or a pointer is NULL.
+ */
+inline uint32_t sstr_replace_all(StaticString *sstr, const StaticString *needle, const StaticString *replacement)
+{
+    if (sstr == NULL || needle == NULL || replacement == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_replace_all(sstr->static_string, &sstr->string_length, SSTR_MAX_LENGTH, needle->static_string,
+                                            needle->string_length, replacement->static_string, replacement->string_length, NULL);
+    if (result)
+    {
+        sstr_cache_rebuild(sstr);
+    }
+    return result;
+}
+
+/**
+ * @brief Replaces every occurrence of a substring and reports truncation.
+ *
+ * Same as sstr_replace_all_cstr(), but tells the caller whether the result
+ * was longer than the maximum allowed length and had to be clipped.
+ *
+ * @param sstr Pointer to the StaticString to modify.
+ * @param needle Null-terminated substring to replace.
+ * @param replacement Null-terminated replacement.
+ * @param truncated Pointer set to 1 if the result was truncated, 0 otherwise. May be NULL.
+ *
+ * @return uint32_t The number of occurrences replaced, 0 if the needle is empty or a pointer is NULL.
+ */
+inline uint32_t sstr_replace_all_cstr_checked(StaticString *sstr, const char *needle, const char *replacement, uint32_t *truncated)
+{
+    if (sstr == NULL || needle == NULL || replacement == NULL)
+    {
+        if (truncated != NULL)
+        {
+            *truncated = 0;
+        }
+        return 0;
+    }
+    uint32_t result = sstr_core_replace_all(sstr->static_string, &sstr->string_length, SSTR_MAX_LENGTH, needle,
+                                            (uint32_t)strlen(needle), replacement, (uint32_t)strlen(replacement), truncated);
+    if (result)
+    {
+        sstr_cache_rebuild(sstr);
+    }
+    return result;
+}
+
+/**
+ * @brief Replaces every occurrence of a null-terminated substring in a StaticString.
+ *
+ * @param sstr Pointer to the StaticString to modify.
+ * @param needle Null-terminated substring to replace, e.g. "\r\n".
+ * @param replacement Null-terminated replacement, e.g. "\n".
+ *
+ * @return uint32_t The number of occurrences replaced, 0 if the needle is empty or a pointer is NULL.
+ */
+inline uint32_t sstr_replace_all_cstr(StaticString *sstr, const char *needle, const char *replacement)
+{
+    return sstr_replace_all_cstr_checked(sstr, needle, replacement, NULL);
+}
+
+/**
+ * @brief Copies a StaticString with every occurrence of a substring replaced.
+ *
+ * Writes the result into dest in one forward pass and leaves src unchanged.
+ * dest may be src, in which case the replacement is done in place.
+ *
+ * @param dest Pointer to the StaticString receiving the result.
+ * @param src Pointer to the StaticString to read.
+ * @param needle Null-terminated substring to replace; an empty needle copies src unchanged.
+ * @param replacement Null-terminated replacement.
+ * @param truncated Pointer set to 1 if the result was truncated, 0 otherwise. May be NULL.
+ *
+ * @return uint32_t The number of occurrences replaced, 0 if a pointer is NULL.
+ */
+inline uint32_t sstr_replace_all_copy(StaticString *dest, const StaticString *src, const char *needle, const char *replacement,
+                                      uint32_t *truncated)
+{
+    if (dest == src)
+    {
+        return sstr_replace_all_cstr_checked(dest, needle, replacement, truncated);
+    }
+    if (dest == NULL || src == NULL || needle == NULL || replacement == NULL)
+    {
+        if (truncated != NULL)
+        {
+            *truncated = 0;
+        }
+        return 0;
+    }
+    uint32_t result = sstr_core_replace_all_copy(src->static_string, src->string_length, dest->static_string, &dest->string_length,
+                                                 SSTR_MAX_LENGTH, needle, (uint32_t)strlen(needle), replacement,
+                                                 (uint32_t)strlen(replacement), truncated);
+    sstr_cache_rebuild(dest);
+    return result;
+}
+
+/**
+ * @brief Copies a substring from one StaticString to another.
+ *
+ * Copies a range of characters from the source StaticString to the destination
+ * StaticString. The range is specified by the start and end indices, which
+ * are zero-based and inclusive. The function returns 1 if the operation is
+ * successful, or 0 if the start index is greater than the current string
+ * length, the end index is greater than the current string length, or the
+ * start index is greater than the end index.
+ *
+ * @param sstr_source Pointer to the source StaticString.
+ * @param sstr_dest Pointer to the destination StaticString.
+ * @param start Zero-based index of the first character to copy.
+ * @param end Zero-based index of the last character to copy.
+ *
+ * @return uint32_t 1 if the operation is successful, 0 if the indices are invalid.
+ */
+inline uint32_t sstr_substring(const StaticString *sstr_source, StaticString *sstr_dest, uint32_t start, uint32_t end)
+{
+    if (sstr_source == NULL || sstr_dest == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_substring(sstr_source->static_string, sstr_source->string_length,
+                                          sstr_dest->static_string, &sstr_dest->string_length, SSTR_MAX_LENGTH, start, end);
+    if (result)
+    {
+        sstr_cache_rebuild(sstr_dest);
+    }
+    return result;
+}
+
+/**
+ * @brief Trims trailing whitespace characters from a StaticString.
+ *
+ * Removes whitespace characters (as defined by IS_WHITESPACE) from the end of the
+ * string, updating the string length and null-terminator accordingly.
+ *
+ * @param sstr Pointer to the StaticString to modify.
+ *
+ * @return uint32_t The number of characters trimmed from the end.
+ */
+inline uint32_t sstr_trim_trailing(StaticString *sstr)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_trim_trailing(sstr->static_string, &sstr->string_length);
+    if (result)
+    {
+        sstr_cache_rebuild(sstr);
+    }
+    return result;
+}
+
+/**
+ * @brief Trims leading whitespace characters from a StaticString.
+ *
+ * Efficiently removes leading whitespace characters by finding the first
+ * non-whitespace character and shifting the remainder of the string forward.
+ *
+ * @param sstr Pointer to the StaticString to modify.
+ *
+ * @return uint32_t The number of characters removed from the beginning.
+ */
+inline uint32_t sstr_trim_leading(StaticString *sstr)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_trim_leading(sstr->static_string, &sstr->string_length);
+    if (result)
+    {
+        sstr_cache_rebuild(sstr);
+    }
+    return result;
+}
+
+/**
+ * @brief Trims both leading and trailing whitespace characters from a StaticString.
+ *
+ * Locates both ends of the trimmed text first, then shifts it to the front
+ * with a single memmove, updating its length and content in-place.
+ *
+ * @param sstr Pointer to the StaticString to modify.
+ *
+ * @return uint32_t The total number of characters removed.
+ */
+inline uint32_t sstr_trim(StaticString *sstr)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_trim(sstr->static_string, &sstr->string_length);
+    if (result)
+    {
+        sstr_cache_rebuild(sstr);
+    }
+    return result;
+}
+
+/**
+ * @brief Trims the characters of a class from both ends of a StaticString.
+ *
+ * @param sstr Pointer to the StaticString to modify.
+ * @param cls Class of the characters to trim.
+ *
+ * @return uint32_t The total number of characters removed, 0 if a pointer is NULL.
+ */
+inline uint32_t sstr_trim_class(StaticString *sstr, const StaticStringCharClass *cls)
+{
+    if (sstr == NULL || cls == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_trim_class(sstr->static_string, &sstr->string_length, cls);
+    if (result)
+    {
+        sstr_cache_rebuild(sstr);
+    }
+    return result;
+}
+
+/**
+ * @brief Removes all whitespace characters from a StaticString (optimized version).
+ *
+ * Same as sstr_strip_class() with the class of SSTR_WHITESPACE_CHARS, the
+ * characters matched by IS_WHITESPACE.
+ *
+ * @param sstr Pointer to the StaticString to modify.
+ *
+ * @return uint32_t The number of characters removed.
+ */
+inline uint32_t sstr_strip_all_whitespace(StaticString *sstr)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_strip_all_whitespace(sstr->static_string, &sstr->string_length);
+    if (result)
+    {
+        sstr_cache_rebuild(sstr);
+    }
+    return result;
+}
+
+/**
+ * @brief Removes every character of a character class from a StaticString.
+ *
+ * The kept characters are compacted in a single pass. With SIMD kernels each
+ * vector is classified with nibble-table lookups and its kept bytes are
+ * left-packed with byte shuffles.
+ *
+ * @param sstr Pointer to the StaticString to modify.
+ * @param cls Class of the characters to remove, e.g. from sstr_char_class_init().
+ *
+ * @return uint32_t The number of characters removed.
+ */
+inline uint32_t sstr_strip_class(StaticString *sstr, const StaticStringCharClass *cls)
+{
+    if (sstr == NULL || cls == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_strip_class(sstr->static_string, &sstr->string_length, cls);
+    if (result)
+    {
+        sstr_cache_rebuild(sstr);
+    }
+    return result;
+}
+
+/**
+ * @brief Removes every occurrence of the given characters from a StaticString.
+ *
+ * Builds a character class from chars on each call; prefer sstr_strip_class()
+ * with a prebuilt class in loops.
+ *
+ * @param sstr Pointer to the StaticString to modify.
+ * @param chars Null-terminated list of characters to remove.
+ *
+ * @return uint32_t The number of characters removed.
+ */
+inline uint32_t sstr_strip_chars(StaticString *sstr, const char *chars)
+{
+    if (chars == NULL)
+    {
+        return 0;
+    }
+    StaticStringCharClass cls;
+    sstr_char_class_init(&cls, chars);
+    return sstr_strip_class(sstr, &cls);
+}
+
+/**
+ * @brief Compares two StaticString instances for equality.
+ *
+ * Checks whether both strings have the same length and identical characters.
+ *
+ * @param sstr1 Pointer to the first StaticString.
+ * @param sstr2 Pointer to the second StaticString.
+ *
+ * @return uint32_t 1 if the strings are equal, 0 otherwise.
+ */
+inline uint32_t sstr_equals(const StaticString *sstr1, const StaticString *sstr2)
+{
+    if (sstr1 == NULL || sstr2 == NULL)
+    {
+        return 0;
+    }
+#if SSTR_CACHED_HASH
+    if (sstr1->string_hash != sstr2->string_hash)
+    {
+        return 0;
+    }
+#endif
+    return sstr_core_equals(sstr1->static_string, sstr1->string_length, sstr2->static_string, sstr2->string_length);
+}
+
+/**
+ * @brief Compares two StaticString instances lexicographically.
+ *
+ * Characters are compared as unsigned bytes, like memcmp(). When one string
+ * is a prefix of the other, the shorter string orders first. A NULL pointer
+ * orders before any StaticString.
+ *
+ * @param sstr1 Pointer to the first StaticString.
+ * @param sstr2 Pointer to the second StaticString.
+ *
+ * @return int32_t -1 if sstr1 orders before sstr2, 0 if they are equal, 1 otherwise.
+ */
+inline int32_t sstr_compare(const StaticString *sstr1, const StaticString *sstr2)
+{
+    if (sstr1 == NULL || sstr2 == NULL)
+    {
+        return (sstr1 != NULL) - (sstr2 != NULL);
+    }
+    return sstr_core_compare(sstr1->static_string, sstr1->string_length, sstr2->static_string, sstr2->string_length);
+}
+
+/**
+ * @brief Compares a StaticString with a null-terminated C string for equality.
+ *
+ * Checks whether the StaticString and the C string contain the same characters
+ * and have the same length. If the C string is NULL, the function returns 0.
+ *
+ * @param sstr Pointer to the StaticString.
+ * @param cstr Pointer to the null-terminated C string.
+ *
+ * @return uint32_t 1 if the strings are equal, 0 otherwise.
+ */
+inline uint32_t sstr_equals_cstr(const StaticString *sstr, const char *cstr)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    return sstr_core_equals_cstr(sstr->static_string, sstr->string_length, cstr);
+}
+
+/**
+ * @brief Compares two StaticString instances for equality, ignoring ASCII case.
+ *
+ * Folds case inside the comparison loop; neither string is copied or modified.
+ *
+ * @param sstr1 Pointer to the first StaticString.
+ * @param sstr2 Pointer to the second StaticString.
+ *
+ * @return uint32_t 1 if the strings are equal ignoring case, 0 otherwise.
+ */
+inline uint32_t sstr_iequals(const StaticString *sstr1, const StaticString *sstr2)
+{
+    if (sstr1 == NULL || sstr2 == NULL)
+    {
+        return 0;
+    }
+    return sstr_core_iequals(sstr1->static_string, sstr1->string_length, sstr2->static_string, sstr2->string_length);
+}
+
+/**
+ * @brief Compares a StaticString with a C string for equality, ignoring ASCII case.
+ *
+ * @param sstr Pointer to the StaticString.
+ * @param cstr Pointer to the null-terminated C string.
+ *
+ * @return uint32_t 1 if the strings are equal ignoring case, 0 otherwise.
+ */
+inline uint32_t sstr_iequals_cstr(const StaticString *sstr, const char *cstr)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    return sstr_core_iequals_cstr(sstr->static_string, sstr->string_length, cstr);
+}
+
+/**
+ * @brief Compares two StaticString instances lexicographically, ignoring ASCII case.
+ *
+ * Orders like sstr_compare() applied to both strings converted to lowercase.
+ *
+ * @param sstr1 Pointer to the first StaticString.
+ * @param sstr2 Pointer to the second StaticString.
+ *
+ * @return int32_t -1 if sstr1 orders before sstr2, 0 if they are equal ignoring case, 1 otherwise.
+ */
+inline int32_t sstr_icompare(const StaticString *sstr1, const StaticString *sstr2)
+{
+    if (sstr1 == NULL || sstr2 == NULL)
+    {
+        return (sstr1 != NULL) - (sstr2 != NULL);
+    }
+    return sstr_core_icompare(sstr1->static_string, sstr1->string_length, sstr2->static_string, sstr2->string_length);
+}
+
+/**
+ * @brief Returns a pointer to the internal null-terminated C string.
+ *
+ * Provides read-only access to the internal character array of the StaticString.
+ * The returned string is guaranteed to be null-terminated.
+ *
+ * @param sstr Pointer to the StaticString.
+ *
+ * @return const char* Pointer to the null-terminated C string.
+ */
+inline const char *sstr_to_cstr(const StaticString *sstr)
+{
+    if (sstr == NULL)
+    {
+        return NULL;
+    }
+    return sstr->static_string;
+}
+
+/**
+ * @brief Removes and returns the last character from the StaticString.
+ *
+ * If the StaticString is not empty, this function removes the last character,
+ * updates the string length, and returns the removed character.
+ * If the string is empty, it returns 0.
+ *
+ * @param sstr Pointer to the StaticString.
+ *
+ * @return char The last character if available, otherwise 0.
+ */
+inline char sstr_pop(StaticString *sstr)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    if (sstr->string_length > 0)
+    {
+        sstr_cache_truncate(sstr, sstr->string_length - 1);
+    }
+    return sstr_core_pop(sstr->static_string, &sstr->string_length);
+}
+
+/**
+ * @brief Truncates the StaticString to the specified length.
+ *
+ * Shortens the StaticString to the given length if the new length is less than
+ * or equal to the current length. Ensures the string remains null-terminated.
+ *
+ * @param sstr Pointer to the StaticString to truncate.
+ * @param new_length The desired new length of the string.
+ *
+ * @return uint32_t 1 if the truncation was successful, 0 if new_length is greater than current length.
+ */
+inline uint32_t sstr_truncate(StaticString *sstr, uint32_t new_length)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    if (new_length > sstr->string_length || new_length > SSTR_MAX_LENGTH)
+    {
+        return 0;
+    }
+    sstr_cache_truncate(sstr, new_length);
+    return sstr_core_truncate(sstr->static_string, &sstr->string_length, SSTR_MAX_LENGTH, new_length);
+}
+
+/**
+ * @brief Returns the current length of the StaticString.
+ *
+ * This function provides access to the length of the string,
+ * excluding the null terminator.
+ *
+ * @param sstr Pointer to the StaticString.
+ *
+ * @return uint32_t The number of characters in the string.
+ */
+inline uint32_t sstr_length(const StaticString *sstr)
+{
+    return sstr->string_length;
+}
+
+/**
+ * @brief Returns a 64-bit hash of the characters of a StaticString.
+ *
+ * Equal strings always have equal hashes. With SSTR_CACHED_HASH enabled the
+ * hash is kept up to date by every mutating function and this call is O(1);
+ * otherwise it is computed from the characters.
+ *
+ * @param sstr Pointer to the StaticString.
+ *
+ * @return uint64_t The hash value, or 0 if sstr is NULL.
+ */
+inline uint64_t sstr_hash(const StaticString *sstr)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+#if SSTR_CACHED_HASH
+    return sstr_hash_finalize(sstr->string_hash, sstr->string_length);
+#else
+    return sstr_core_hash(sstr->static_string, sstr->string_length);
+#endif
+}
+
+/**
+ * @brief Returns a 64-bit hash of a StaticString that ignores ASCII case.
+ *
+ * Strings that sstr_iequals() considers equal have equal hashes; the value is
+ * sstr_hash() of the lowercased string. Always computed from the characters.
+ *
+ * @param sstr Pointer to the StaticString.
+ *
+ * @return uint64_t The hash value, or 0 if sstr is NULL.
+ */
+inline uint64_t sstr_ihash(const StaticString *sstr)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    return sstr_core_ihash(sstr->static_string, sstr->string_length);
+}
+
+/**
+ * @brief Reverses the contents of the StaticString in place.
+ *
+ * Reverses the characters of the StaticString without allocating
+ * additional memory. The operation is done in-place.
+ *
+ * @param sstr Pointer to the StaticString to be reversed.
+ *
+ * @return uint32_t 1 if the string was successfully reversed, 0 otherwise.
+ */
+inline uint32_t sstr_reverse(StaticString *sstr)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_reverse(sstr->static_string, sstr->string_length);
+    if (result)
+    {
+        sstr_cache_rebuild(sstr);
+    }
+    return result;
+}
+
+/**
+ * @brief Copies the contents of one StaticString to another.
+ *
+ * Performs a deep copy of the contents and string length from the source
+ * StaticString (`sstr2`) to the destination StaticString (`sstr1`), including
+ * null-termination. Returns void if the source StaticString (`sstr2`) is too long.
+ *
+ * @param sstr1 Pointer to the destination StaticString.
+ * @param sstr2 Pointer to the source StaticString.
+ *
+ * @return uint32_t 1 if the copy was successful, 0 if the source StaticString is too long.
+ */
+inline uint32_t sstr_copy(StaticString *sstr1, const StaticString *sstr2)
+{
+    if (sstr1 == NULL || sstr2 == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_copy(sstr1->static_string, &sstr1->string_length, SSTR_MAX_LENGTH, sstr2->static_string, sstr2->string_length);
+#if SSTR_CACHED_HASH
+    if (result)
+    {
+        sstr1->string_hash = sstr2->string_hash;
+    }
+#endif
+    return result;
+}
+
+/**
+ * @brief Converts all lowercase letters in the StaticString to uppercase.
+ *
+ * Iterates through the StaticString and converts each ASCII lowercase
+ * character ('a' to 'z') to its uppercase equivalent ('A' to 'Z').
+ *
+ * @param sstr Pointer to the StaticString to modify.
+ *
+ * @return uint32_t The number of characters that were converted.
+ */
+inline uint32_t sstr_to_uppercase(StaticString *sstr)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_to_uppercase(sstr->static_string, sstr->string_length);
+    if (result)
+    {
+        sstr_cache_rebuild(sstr);
+    }
+    return result;
+}
+
+/**
+ * @brief Converts all uppercase letters in the StaticString to lowercase.
+ *
+ * Iterates through the StaticString and converts each ASCII uppercase
+ * character ('A' to 'Z') to its lowercase equivalent ('a' to 'z').
+ *
+ * @param sstr Pointer to the StaticString to modify.
+ *
+ * @return uint32_t The number of characters that were converted.
+ */
+inline uint32_t sstr_to_lowercase(StaticString *sstr)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_to_lowercase(sstr->static_string, sstr->string_length);
+    if (result)
+    {
+        sstr_cache_rebuild(sstr);
+    }
+    return result;
+}
+
+/**
+ * @brief Maps every character of the StaticString through a translation table.
+ *
+ * Applies all the mappings composed into the table in a single pass, e.g.
+ * replacing separators and uppercasing at once. The length does not change;
+ * a mapping to '\0' leaves an embedded null character.
+ *
+ * @param sstr Pointer to the StaticString to modify.
+ * @param table Pointer to the translation table, see sstr_translation_map().
+ *
+ * @return uint32_t The number of characters that were changed, 0 if a pointer is NULL.
+ */
+inline uint32_t sstr_translate(StaticString *sstr, const StaticStringTranslation *table)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_translate(sstr->static_string, sstr->string_length, table);
+    if (result)
+    {
+        sstr_cache_rebuild(sstr);
+    }
+    return result;
+}
+
+/**
+ * @brief Initializes a StaticString from a C string converted to lowercase.
+ *
+ * Same as sstr_from_cstr() followed by sstr_to_lowercase(), in a single pass
+ * over the characters.
+ *
+ * @param sstr Pointer to the StaticString to initialize.
+ * @param cstr Null-terminated C string to copy from.
+ *
+ * @return uint32_t 1 if the StaticString was successfully initialized, 0 otherwise.
+ */
+inline uint32_t sstr_from_cstr_lowercase(StaticString *sstr, const char *cstr)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_from_cstr_lowercase(sstr->static_string, &sstr->string_length, SSTR_MAX_LENGTH, cstr, NULL);
+    sstr_cache_rebuild(sstr);
+    return result;
+}
+
+/**
+ * @brief Initializes a StaticString from a C string converted to uppercase.
+ *
+ * Same as sstr_from_cstr() followed by sstr_to_uppercase(), in a single pass
+ * over the characters.
+ *
+ * @param sstr Pointer to the StaticString to initialize.
+ * @param cstr Null-terminated C string to copy from.
+ *
+ * @return uint32_t 1 if the StaticString was successfully initialized, 0 otherwise.
+ */
+inline uint32_t sstr_from_cstr_uppercase(StaticString *sstr, const char *cstr)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_from_cstr_uppercase(sstr->static_string, &sstr->string_length, SSTR_MAX_LENGTH, cstr, NULL);
+    sstr_cache_rebuild(sstr);
+    return result;
+}
+
+/**
+ * @brief Returns the number of times a character appears in a StaticString.
+ *
+ * Iterates through the StaticString and counts the number of occurrences of
+ * the specified character.
+ *
+ * @param sstr Pointer to the StaticString.
+ * @param ch The character to search for.
+ *
+ * @return uint32_t The number of times the character appears in the string.
+ */
+inline uint32_t sstr_contains(const StaticString *sstr, char ch)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    return sstr_core_contains(sstr->static_string, sstr->string_length, ch);
+}
+
+/**
+ * @brief Finds the first occurrence of a character in a StaticString.
+ *
+ * Searches the StaticString for the specified character and returns the
+ * zero-based index of its first occurrence. If the character is not found,
+ * the function returns -1.
+ *
+ * @param sstr Pointer to the StaticString to search.
+ * @param ch The character to find.
+ *
+ * @return int32_t The index of the first occurrence of the character, or -1 if not found.
+ */
+inline int32_t sstr_first_index_of(const StaticString *sstr, char ch)
+{
+    if (sstr == NULL)
+    {
+        return -1;
+    }
+    return sstr_core_first_index_of(sstr->static_string, sstr->string_length, ch);
+}
+
+/**
+ * @brief Finds the last occurrence of a character in a StaticString.
+ *
+ * Searches the StaticString in reverse order for the specified character
+ * and returns the zero-based index of its last occurrence. If the character
+ * is not found, the function returns -1.
+ *
+ * @param sstr Pointer to the StaticString to search.
+ * @param ch The character to find.
+ *
+ * @return int32_t The index of the last occurrence of the character, or -1 if not found.
+ */
+inline int32_t sstr_last_index_of(const StaticString *sstr, char ch)
+{
+    if (sstr == NULL)
+    {
+        return -1;
+    }
+    return sstr_core_last_index_of(sstr->static_string, sstr->string_length, ch);
+}
+
+/**
+ * @brief Finds the next occurrence of a character in a StaticString.
+ *
+ * Like sstr_first_index_of(), but the search begins at start, so repeated
+ * calls with the previous index + 1 walk all occurrences without rescanning
+ * the prefix.
+ *
+ * @param sstr Pointer to the StaticString to search.
+ * @param ch The character to find.
+ * @param start Index to start searching from.
+ *
+ * @return int32_t The index of the first occurrence at or after start, or -1
+ *         if not found or start is past the end.
+ */
+inline int32_t sstr_index_of_from(const StaticString *sstr, char ch, uint32_t start)
+{
+    if (sstr == NULL)
+    {
+        return -1;
+    }
+    return sstr_core_index_of_from(sstr->static_string, sstr->string_length, ch, start);
+}
+
+/**
+ * @brief Finds the first character of a StaticString that belongs to a class.
+ *
+ * The class is built once, e.g. with sstr_char_class_init(), and reused. With
+ * SIMD kernels each vector is classified with nibble-table lookups, so a
+ * class of many characters costs the same as a single one.
+ *
+ * @param sstr Pointer to the StaticString to search.
+ * @param cls Class of the characters to find.
+ *
+ * @return int32_t The index of the first character in the class, or -1 if
+ *         there is none or a pointer is NULL.
+ */
+inline int32_t sstr_find_first_of(const StaticString *sstr, const StaticStringCharClass *cls)
+{
+    if (sstr == NULL || cls == NULL)
+    {
+        return -1;
+    }
+    return sstr_core_find_first_of(sstr->static_string, sstr->string_length, cls);
+}
+
+/**
+ * @brief Finds the first character of a StaticString outside a class.
+ *
+ * @param sstr Pointer to the StaticString to search.
+ * @param cls Class of the characters to skip.
+ *
+ * @return int32_t The index of the first character outside the class, or -1
+ *         if there is none or a pointer is NULL.
+ */
+inline int32_t sstr_find_first_not_of(const StaticString *sstr, const StaticStringCharClass *cls)
+{
+    if (sstr == NULL || cls == NULL)
+    {
+        return -1;
+    }
+    return sstr_core_find_first_not_of(sstr->static_string, sstr->string_length, cls);
+}
+
+/**
+ * @brief Measures the prefix of a StaticString made of characters in a class, like strspn().
+ *
+ * @param sstr Pointer to the StaticString.
+ * @param cls Class of the characters to accept.
+ *
+ * @return uint32_t The length of the prefix, 0 if a pointer is NULL.
+ */
+inline uint32_t sstr_span(const StaticString *sstr, const StaticStringCharClass *cls)
+{
+    if (sstr == NULL || cls == NULL)
+    {
+        return 0;
+    }
+    return sstr_core_span(sstr->static_string, sstr->string_length, cls);
+}
+
+/**
+ * @brief Measures the prefix of a StaticString made of characters outside a class, like strcspn().
+ *
+ * @param sstr Pointer to the StaticString.
+ * @param cls Class of the characters that end the prefix.
+ *
+ * @return uint32_t The length of the prefix, 0 if a pointer is NULL.
+ */
+inline uint32_t sstr_cspan(const StaticString *sstr, const StaticStringCharClass *cls)
+{
+    if (sstr == NULL || cls == NULL)
+    {
+        return 0;
+    }
+    return sstr_core_cspan(sstr->static_string, sstr->string_length, cls);
+}
+
+/**
+ * @brief Finds the first occurrence of a substring in a StaticString.
+ *
+ * Searches the StaticString for the needle StaticString and returns the
+ * zero-based index where it first occurs. An empty needle matches at index 0.
+ * The search is linear in the worst case.
+ *
+ * @param sstr Pointer to the StaticString to search.
+ * @param needle Pointer to the StaticString to find.
+ *
+ * @return int32_t The index of the first occurrence, or -1 if not found.
+ */
+inline int32_t sstr_find(const StaticString *sstr, const StaticString *needle)
+{
+    if (sstr == NULL || needle == NULL)
+    {
+        return -1;
+    }
+    return sstr_core_find(sstr->static_string, sstr->string_length, needle->static_string, needle->string_length, 0);
+}
+
+/**
+ * @brief Finds the first occurrence of a null-terminated C string in a StaticString.
+ *
+ * @param sstr Pointer to the StaticString to search.
+ * @param cstr Null-terminated C string to find.
+ *
+ * @return int32_t The index of the first occurrence, or -1 if not found.
+ */
+inline int32_t sstr_find_cstr(const StaticString *sstr, const char *cstr)
+{
+    if (sstr == NULL || cstr == NULL)
+    {
+        return -1;
+    }
+    return sstr_core_find(sstr->static_string, sstr->string_length, cstr, (uint32_t)strlen(cstr), 0);
+}
+
+/**
+ * @brief Finds the first occurrence of a substring in a StaticString, ignoring ASCII case.
+ *
+ * An empty needle matches at index 0. The search is linear in the worst case.
+ *
+ * @param sstr Pointer to the StaticString to search.
+ * @param needle Pointer to the StaticString to find.
+ *
+ * @return int32_t The index of the first occurrence, or -1 if not found.
+ */
+inline int32_t sstr_ifind(const StaticString *sstr, const StaticString *needle)
+{
+    if (sstr == NULL || needle == NULL)
+    {
+        return -1;
+    }
+    return sstr_core_ifind(sstr->static_string, sstr->string_length, needle->static_string, needle->string_length, 0);
+}
+
+/**
+ * @brief Finds the first occurrence of a C string in a StaticString, ignoring ASCII case.
+ *
+ * @param sstr Pointer to the StaticString to search.
+ * @param cstr Null-terminated C string to find.
+ *
+ * @return int32_t The index of the first occurrence, or -1 if not found.
+ */
+inline int32_t sstr_ifind_cstr(const StaticString *sstr, const char *cstr)
+{
+    if (sstr == NULL || cstr == NULL)
+    {
+        return -1;
+    }
+    return sstr_core_ifind(sstr->static_string, sstr->string_length, cstr, (uint32_t)strlen(cstr), 0);
+}
+
+/**
+ * @brief Finds the last occurrence of a substring in a StaticString.
+ *
+ * An empty needle matches at the end of the string.
+ *
+ * @param sstr Pointer to the StaticString to search.
+ * @param needle Pointer to the StaticString to find.
+ *
+ * @return int32_t The index of the last occurrence, or -1 if not found.
+ */
+inline int32_t sstr_rfind(const StaticString *sstr, const StaticString *needle)
+{
+    if (sstr == NULL || needle == NULL)
+    {
+        return -1;
+    }
+    return sstr_core_rfind(sstr->static_string, sstr->string_length, needle->static_string, needle->string_length);
+}
+
+/**
+ * @brief Finds the last occurrence of a null-terminated C string in a StaticString.
+ *
+ * @param sstr Pointer to the StaticString to search.
+ * @param cstr Null-terminated C string to find.
+ *
+ * @return int32_t The index of the last occurrence, or -1 if not found.
+ */
+inline int32_t sstr_rfind_cstr(const StaticString *sstr, const char *cstr)
+{
+    if (sstr == NULL || cstr == NULL)
+    {
+        return -1;
+    }
+    return sstr_core_rfind(sstr->static_string, sstr->string_length, cstr, (uint32_t)strlen(cstr));
+}
+
+/**
+ * @brief Finds all non-overlapping occurrences of a substring in a StaticString.
+ *
+ * Stores the index of each match, from left to right, into the positions
+ * array until it is full, but keeps counting past that point. An empty
+ * needle has no matches.
+ *
+ * @param sstr Pointer to the StaticString to search.
+ * @param needle Pointer to the StaticString to find.
+ * @param positions Array receiving the match indices. May be NULL if max_positions is 0.
+ * @param max_positions Number of elements in the positions array.
+ *
+ * @return uint32_t The total number of matches.
+ */
+inline uint32_t sstr_find_all(const StaticString *sstr, const StaticString *needle, uint32_t *positions, uint32_t max_positions)
+{
+    if (sstr == NULL || needle == NULL)
+    {
+        return 0;
+    }
+    return sstr_core_find_all(sstr->static_string, sstr->string_length, needle->static_string, needle->string_length,
+                              positions, max_positions);
+}
+
+/**
+ * @brief Finds all non-overlapping occurrences of a C string in a StaticString.
+ *
+ * @param sstr Pointer to the StaticString to search.
+ * @param cstr Null-terminated C string to find.
+ * @param positions Array receiving the match indices. May be NULL if max_positions is 0.
+ * @param max_positions Number of elements in the positions array.
+ *
+ * @return uint32_t The total number of matches.
+ */
+inline uint32_t sstr_find_all_cstr(const StaticString *sstr, const char *cstr, uint32_t *positions, uint32_t max_positions)
+{
+    if (sstr == NULL || cstr == NULL)
+    {
+        return 0;
+    }
+    return sstr_core_find_all(sstr->static_string, sstr->string_length, cstr, (uint32_t)strlen(cstr), positions, max_positions);
+}
+
+/*
+ * ---------------------------------------------------------------------------
+ * StaticStringView
+ *
+ * A non-owning pointer + length pair that refers to characters owned by a
+ * StaticString, a C string or any other buffer. Views are passed by value,
+ * are not null-terminated, and stay valid only as long as the characters they
+ * point to are neither modified nor destroyed. Producing a view never copies;
+ * sstr_from_view() copies it into a StaticString when an owned string is needed.
+ * ---------------------------------------------------------------------------
+ */
+
+typedef struct
+{
+    const char *data; // First character; not null-terminated in general
+    uint32_t length;  // Number of characters
+} StaticStringView;
+
+/**
+ * @brief Returns a view of all characters of a StaticString.
+ *
+ * @param sstr Pointer to the StaticString.
+ *
+ * @return StaticStringView A view of the string, or an empty view if sstr is NULL.
+ */
+inline StaticStringView sstr_view(const StaticString *sstr)
+{
+    StaticStringView view = {"", 0};
+    if (sstr != NULL)
+    {
+        view.data = sstr->static_string;
+        view.length = sstr->string_length;
+    }
+    return view;
+}
+
+/**
+ * @brief Returns a view of a null-terminated C string.
+ *
+ * @param cstr Null-terminated C string.
+ *
+ * @return StaticStringView A view of the string, or an empty view if cstr is NULL.
+ */
+inline StaticStringView sstr_view_cstr(const char *cstr)
+{
+    StaticStringView view = {"", 0};
+    if (cstr != NULL)
+    {
+        view.data = cstr;
+        view.length = (uint32_t)strlen(cstr);
+    }
+    return view;
+}
+
+/**
+ * @brief Returns a view of the characters between two indices of a view.
+ *
+ * Uses the same inclusive range as sstr_substring(), but copies nothing.
+ *
+ * @param view The view to slice.
+ * @param start Starting index (inclusive).
+ * @param end Ending index (inclusive).
+ * @param out Receives the slice. Left unchanged on failure.
+ *
+ * @return uint32_t 1 on success, 0 if the range is invalid or out is NULL.
+ */
+inline uint32_t sstr_view_slice(StaticStringView view, uint32_t start, uint32_t end, StaticStringView *out)
+{
+    if (out == NULL || start >= view.length || end >= view.length || start > end)
+    {
+        return 0;
+    }
+    out->data = view.data + start;
+    out->length = end - start + 1;
+    return 1;
+}
+
+/**
+ * @brief Zero-copy counterpart of sstr_substring().
+ *
+ * @param sstr Pointer to the source StaticString.
+ * @param start Starting index (inclusive).
+ * @param end Ending index (inclusive).
+ * @param view Receives a view of the characters in the range.
+ *
+ * @return uint32_t 1 on success, 0 if the range is invalid or a pointer is NULL.
+ */
+inline uint32_t sstr_substring_view(const StaticString *sstr, uint32_t start, uint32_t end, StaticStringView *view)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    return sstr_view_slice(sstr_view(sstr), start, end, view);
+}
+
+/**
+ * @brief Returns a view without the characters of a class at either end.
+ *
+ * @param view The view to trim.
+ * @param cls Class of the characters to skip.
+ *
+ * @return StaticStringView The trimmed view, pointing into the same characters.
+ */
+inline StaticStringView sstr_view_trim_class(StaticStringView view, const StaticStringCharClass *cls)
+{
+    if (cls == NULL)
+    {
+        return view;
+    }
+    const SStrKernels *kernels = sstr_kernels();
+    uint32_t start = kernels->span_class(view.data, view.length, cls);
+    view.data += start;
+    view.length -= start;
+    view.length -= kernels->span_class_reverse(view.data, view.length, cls);
+    return view;
+}
+
+/**
+ * @brief Returns a view without leading and trailing whitespace.
+ *
+ * @param view The view to trim.
+ *
+ * @return StaticStringView The trimmed view, pointing into the same characters.
+ */
+inline StaticStringView sstr_view_trim(StaticStringView view)
+{
+    return sstr_view_trim_class(view, sstr_char_class_whitespace());
+}
+
+/**
+ * @brief Zero-copy counterpart of sstr_trim().
+ *
+ * Leaves the string unchanged and moves no characters.
+ *
+ * @param sstr Pointer to the StaticString.
+ *
+ * @return StaticStringView A view of the string without leading and trailing
+ *         whitespace, or an empty view if sstr is NULL.
+ */
+inline StaticStringView sstr_trimmed_view(const StaticString *sstr)
+{
+    return sstr_view_trim(sstr_view(sstr));
+}
+
+/**
+ * @brief Copies the characters of a view into a StaticString.
+ *
+ * @param sstr Pointer to the destination StaticString.
+ * @param view The characters to copy.
+ *
+ * @return uint32_t 1 on success, 0 if sstr is NULL or the view does not fit.
+ */
+inline uint32_t sstr_from_view(StaticString *sstr, StaticStringView view)
+{
+    if (sstr == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_copy(sstr->static_string, &sstr->string_length, SSTR_MAX_LENGTH, view.data, view.length);
+    if (result)
+    {
+        sstr_cache_rebuild(sstr);
+    }
+    return result;
+}
+
+/**
+ * @brief Compares two views for equality.
+ *
+ * @return uint32_t 1 if both views contain the same characters, 0 otherwise.
+ */
+inline uint32_t sstr_view_equals(StaticStringView view1, StaticStringView view2)
+{
+    return sstr_core_equals(view1.data, view1.length, view2.data, view2.length);
+}
+
+/**
+ * @brief Compares a view with a null-terminated C string for equality.
+ *
+ * @return uint32_t 1 if they contain the same characters, 0 otherwise or if cstr is NULL.
+ */
+inline uint32_t sstr_view_equals_cstr(StaticStringView view, const char *cstr)
+{
+    return sstr_core_equals_cstr(view.data, view.length, cstr);
+}
+
+/**
+ * @brief Compares two views for equality, ignoring ASCII case.
+ *
+ * @return uint32_t 1 if both views contain the same characters ignoring case, 0 otherwise.
+ */
+inline uint32_t sstr_view_iequals(StaticStringView view1, StaticStringView view2)
+{
+    return sstr_core_iequals(view1.data, view1.length, view2.data, view2.length);
+}
+
+/**
+ * @brief Compares a view with a null-terminated C string for equality, ignoring ASCII case.
+ *
+ * @return uint32_t 1 if they contain the same characters ignoring case, 0 otherwise or if cstr is NULL.
+ */
+inline uint32_t sstr_view_iequals_cstr(StaticStringView view, const char *cstr)
+{
+    return sstr_core_iequals_cstr(view.data, view.length, cstr);
+}
+
+/**
+ * @brief Compares two views lexicographically, like sstr_compare().
+ *
+ * @return int32_t -1, 0 or 1 as view1 orders before, equal to or after view2.
+ */
+inline int32_t sstr_view_compare(StaticStringView view1, StaticStringView view2)
+{
+    return sstr_core_compare(view1.data, view1.length, view2.data, view2.length);
+}
+
+/**
+ * @brief Compares two views lexicographically ignoring ASCII case, like sstr_icompare().
+ *
+ * @return int32_t -1, 0 or 1 as view1 orders before, equal to or after view2.
+ */
+inline int32_t sstr_view_icompare(StaticStringView view1, StaticStringView view2)
+{
+    return sstr_core_icompare(view1.data, view1.length, view2.data, view2.length);
+}
+
+/**
+ * @brief Hashes the characters of a view.
+ *
+ * @return uint64_t The same value sstr_hash() returns for a StaticString with these characters.
+ */
+inline uint64_t sstr_view_hash(StaticStringView view)
+{
+    return sstr_core_hash(view.data, view.length);
+}
+
+/**
+ * @brief Hashes the characters of a view, ignoring ASCII case.
+ *
+ * @return uint64_t The same value sstr_ihash() returns for a StaticString with these characters.
+ */
+inline uint64_t sstr_view_ihash(StaticStringView view)
+{
+    return sstr_core_ihash(view.data, view.length);
+}
+
+/**
+ * @brief Counts the occurrences of a character in a view, like sstr_contains().
+ *
+ * @return uint32_t The number of times ch occurs in the view.
+ */
+inline uint32_t sstr_view_contains(StaticStringView view, char ch)
+{
+    return sstr_core_contains(view.data, view.length, ch);
+}
+
+/**
+ * @brief Finds the first occurrence of a character in a view.
+ *
+ * @return int32_t The index of the first occurrence, or -1 if not found.
+ */
+inline int32_t sstr_view_first_index_of(StaticStringView view, char ch)
+{
+    return sstr_core_first_index_of(view.data, view.length, ch);
+}
+
+/**
+ * @brief Finds the last occurrence of a character in a view.
+ *
+ * @return int32_t The index of the last occurrence, or -1 if not found.
+ */
+inline int32_t sstr_view_last_index_of(StaticStringView view, char ch)
+{
+    return sstr_core_last_index_of(view.data, view.length, ch);
+}
+
+/**
+ * @brief Finds the first occurrence of a character at or after start in a view.
+ *
+ * @return int32_t The index of the occurrence, or -1 if not found.
+ */
+inline int32_t sstr_view_index_of_from(StaticStringView view, char ch, uint32_t start)
+{
+    return sstr_core_index_of_from(view.data, view.length, ch, start);
+}
+
+/**
+ * @brief Finds the first character of a view in a class, like sstr_find_first_of().
+ *
+ * @return int32_t The index of the character, or -1 if there is none or cls is NULL.
+ */
+inline int32_t sstr_view_find_first_of(StaticStringView view, const StaticStringCharClass *cls)
+{
+    return cls == NULL ? -1 : sstr_core_find_first_of(view.data, view.length, cls);
+}
+
+/**
+ * @brief Finds the first character of a view outside a class, like sstr_find_first_not_of().
+ *
+ * @return int32_t The index of the character, or -1 if there is none or cls is NULL.
+ */
+inline int32_t sstr_view_find_first_not_of(StaticStringView view, const StaticStringCharClass *cls)
+{
+    return cls == NULL ? -1 : sstr_core_find_first_not_of(view.data, view.length, cls);
+}
+
+/**
+ * @brief Length of the prefix of a view made of characters in a class, like sstr_span().
+ *
+ * @return uint32_t The length of the prefix, 0 if cls is NULL.
+ */
+inline uint32_t sstr_view_span(StaticStringView view, const StaticStringCharClass *cls)
+{
+    return cls == NULL ? 0 : sstr_core_span(view.data, view.length, cls);
+}
+
+/**
+ * @brief Length of the prefix of a view made of characters outside a class, like sstr_cspan().
+ *
+ * @return uint32_t The length of the prefix, 0 if cls is NULL.
+ */
+inline uint32_t sstr_view_cspan(StaticStringView view, const StaticStringCharClass *cls)
+{
+    return cls == NULL ? 0 : sstr_core_cspan(view.data, view.length, cls);
+}
+
+/**
+ * @brief Finds the first occurrence of a substring in a view, like sstr_find().
+ *
+ * @return int32_t The index of the first occurrence, or -1 if not found.
+ */
+inline int32_t sstr_view_find(StaticStringView view, StaticStringView needle)
+{
+    return sstr_core_find(view.data, view.length, needle.data, needle.length, 0);
+}
+
+/**
+ * @brief Finds the first occurrence of a substring in a view ignoring ASCII case, like sstr_ifind().
+ *
+ * @return int32_t The index of the first occurrence, or -1 if not found.
+ */
+inline int32_t sstr_view_ifind(StaticStringView view, StaticStringView needle)
+{
+    return sstr_core_ifind(view.data, view.length, needle.data, needle.length, 0);
+}
+
+/**
+ * @brief Finds the last occurrence of a substring in a view, like sstr_rfind().
+ *
+ * @return int32_t The index of the last occurrence, or -1 if not found.
+ */
+inline int32_t sstr_view_rfind(StaticStringView view, StaticStringView needle)
+{
+    return sstr_core_rfind(view.data, view.length, needle.data, needle.length);
+}
+
+/**
+ * @brief Finds all non-overlapping occurrences of a substring in a view, like sstr_find_all().
+ *
+ * @return uint32_t The total number of matches.
+ */
+inline uint32_t sstr_view_find_all(StaticStringView view, StaticStringView needle, uint32_t *positions, uint32_t max_positions)
+{
+    return sstr_core_find_all(view.data, view.length, needle.data, needle.length, positions, max_positions);
+}
+
+/*
+ * ---------------------------------------------------------------------------
+ * Split iterator
+ *
+ * Splits a view into tokens without copying or allocating: each call to
+ * sstr_split_next() returns a view of the next token. Delimiters are located
+ * 64 characters at a time as a bitmask from the char_mask kernel, so runs of
+ * short tokens cost one vector pass per 64 characters instead of one search
+ * per token. N delimiters always produce N + 1 tokens, some possibly empty.
+ * ---------------------------------------------------------------------------
+ */
+
+#define SSTR_SPLIT_CHAR 0   // Split on a single character
+#define SSTR_SPLIT_ANY 1    // Split on any character of a set
+#define SSTR_SPLIT_STRING 2 // Split on a multi-character delimiter
+
+#define SSTR_SPLIT_MAX_MASKED_SET 4 // Larger character sets are matched through a character class
+
+typedef struct
+{
+    StaticStringView input;     // String being split
+    StaticStringView delimiter; // Delimiter of SSTR_SPLIT_STRING; must outlive the iterator
+    uint32_t position;          // Start of the next token
+    uint32_t finished;          // 1 once the last token has been returned
+    int mode;                   // One of the SSTR_SPLIT_* constants
+    uint32_t set_size;          // Number of characters in set_chars (SSTR_SPLIT_ANY)
+    char set_chars[SSTR_SPLIT_MAX_MASKED_SET]; // Delimiter characters; set_chars[0] is the first delimiter byte otherwise
+    StaticStringCharClass set_class; // All delimiter characters (SSTR_SPLIT_ANY)
+    uint32_t block_start;       // Input index of bit 0 of block_mask
+    uint64_t block_mask;        // Delimiter candidates in [block_start, block_start + 64)
+} StaticStringSplit;
+
+// Delimiter candidates among the 64 characters starting at start
+inline uint64_t sstr_split_block_mask(const StaticStringSplit *split, uint32_t start)
+{
+    const char *data = split->input.data + start;
+    uint32_t length = split->input.length - start;
+    const SStrKernels *kernels = sstr_kernels();
+    if (split->mode != SSTR_SPLIT_ANY)
+    {
+        return kernels->char_mask(data, length, split->set_chars[0]);
+    }
+    if (split->set_size <= SSTR_SPLIT_MAX_MASKED_SET)
+    {
+        uint64_t mask = 0;
+        for (uint32_t i = 0; i < split->set_size; i++)
+        {
+            mask |= kernels->char_mask(data, length, split->set_chars[i]);
+        }
+        return mask;
+    }
+    return kernels->class_mask(data, length, &split->set_class);
+}
+
+// Index of the next delimiter at or after split->position, or the input length
+inline uint32_t sstr_split_find(StaticStringSplit *split)
+{
+    const uint32_t length = split->input.length;
+    uint32_t from = split->position;
+    while (from < length)
+    {
+        if (from - split->block_start >= 64)
+        {
+            split->block_start = from;
+            split->block_mask = sstr_split_block_mask(split, from);
+        }
+        uint64_t mask = split->block_mask & (~0ULL << (from - split->block_start));
+        for (; mask != 0; mask &= mask - 1)
+        {
+            uint32_t index = split->block_start + sstr_ctz64(mask);
+            if (split->mode != SSTR_SPLIT_STRING ||
+                (split->delimiter.length <= length - index &&
+                 memcmp(split->input.data + index, split->delimiter.data, split->delimiter.length) == 0))
+            {
+                return index;
+            }
+        }
+        from = split->block_start + 64;
+    }
+    return length;
+}
+
+// Shared setup of the sstr_split_init* functions
+inline void sstr_split_reset(StaticStringSplit *split, StaticStringView input, int mode)
+{
+    memset(split, 0, sizeof(*split));
+    split->input = input;
+    split->delimiter.data = "";
+    split->mode = mode;
+    split->block_start = (uint32_t)0 - 64; // No block loaded yet; the first search loads the block at 0
+}
+
+/**
+ * @brief Prepares to split a view on a single delimiter character.
+ *
+ * @param split Iterator state to initialize.
+ * @param input The characters to split; must stay valid while iterating.
+ * @param delimiter The delimiter character.
+ *
+ * @return uint32_t 1 on success, 0 if split is NULL.
+ */
+inline uint32_t sstr_split_init(StaticStringSplit *split, StaticStringView input, char delimiter)
+{
+    if (split == NULL)
+    {
+        return 0;
+    }
+    sstr_split_reset(split, input, SSTR_SPLIT_CHAR);
+    split->set_chars[0] = delimiter;
+    return 1;
+}
+
+/**
+ * @brief Prepares to split a view on any character of a set.
+ *
+ * Consecutive delimiters produce empty tokens, as with sstr_split_init().
+ *
+ * @param split Iterator state to initialize.
+ * @param input The characters to split; must stay valid while iterating.
+ * @param delimiters Null-terminated set of delimiter characters; copied, so it need not outlive the iterator.
+ *
+ * @return uint32_t 1 on success, 0 if a pointer is NULL or the set is empty.
+ */
+inline uint32_t sstr_split_init_any(StaticStringSplit *split, StaticStringView input, const char *delimiters)
+{
+    if (split == NULL || delimiters == NULL || delimiters[0] == '\0')
+    {
+        return 0;
+    }
+    sstr_split_reset(split, input, SSTR_SPLIT_ANY);
+    for (const char *c = delimiters; *c != '\0'; c++)
+    {
+        if (sstr_char_class_contains(&split->set_class, *c))
+        {
+            continue; // Duplicate
+        }
+        sstr_char_class_add(&split->set_class, *c);
+        if (split->set_size < SSTR_SPLIT_MAX_MASKED_SET)
+        {
+            split->set_chars[split->set_size] = *c;
+        }
+        split->set_size++;
+    }
+    return 1;
+}
+
+/**
+ * @brief Prepares to split a view on a multi-character delimiter.
+ *
+ * Delimiter occurrences are matched left to right without overlapping.
+ *
+ * @param split Iterator state to initialize.
+ * @param input The characters to split; must stay valid while iterating.
+ * @param delimiter The delimiter; must stay valid while iterating.
+ *
+ * @return uint32_t 1 on success, 0 if split is NULL or the delimiter is empty.
+ */
+inline uint32_t sstr_split_init_string(StaticStringSplit *split, StaticStringView input, StaticStringView delimiter)
+{
+    if (split == NULL || delimiter.length == 0)
+    {
+        return 0;
+    }
+    sstr_split_reset(split, input, delimiter.length == 1 ? SSTR_SPLIT_CHAR : SSTR_SPLIT_STRING);
+    split->delimiter = delimiter;
+    split->set_chars[0] = delimiter.data[0];
+    return 1;
+}
+
+/**
+ * @brief Returns the next token.
+ *
+ * @param split Iterator state from one of the sstr_split_init* functions.
+ * @param token Receives a view of the token, which points into the input.
+ *
+ * @return uint32_t 1 if a token was returned, 0 once all tokens have been returned.
+ */
+inline uint32_t sstr_split_next(StaticStringSplit *split, StaticStringView *token)
+{
+    if (split == NULL || token == NULL || split->finished)
+    {
+        return 0;
+    }
+    uint32_t end = sstr_split_find(split);
+    token->data = split->input.data + split->position;
+    token->length = end - split->position;
+    if (end == split->input.length)
+    {
+        split->finished = 1;
+    }
+    else
+    {
+        split->position = end + (split->mode == SSTR_SPLIT_STRING ? split->delimiter.length : 1);
+    }
+    return 1;
+}
+
+/*
+ * ---------------------------------------------------------------------------
+ * Edit scripts
+ *
+ * Queues insert, remove and replace edits against the original positions of a
+ * string and applies them together. Applying moves every kept character once,
+ * straight to its final position, so k edits on an n-character string cost
+ * O(n + k) instead of one tail shift per edit. The edit array is owned by the
+ * caller; the inserted characters are views that must stay valid until the
+ * script is applied and must not point into the edited string.
+ * ---------------------------------------------------------------------------
+ */
+
+typedef struct
+{
+    uint32_t offset;         // Position in the original string
+    uint32_t delete_length;  // Number of original characters removed at offset
+    StaticStringView insert; // Characters inserted at offset
+} StaticStringEdit;
+
+typedef struct
+{
+    StaticStringEdit *edits; // Caller-provided storage
+    uint32_t count;          // Number of queued edits
+    uint32_t capacity;       // Number of elements in edits
+} StaticStringEditScript;
+
+/**
+ * @brief Prepares an empty edit script.
+ *
+ * @param script Script to initialize.
+ * @param edits Storage for the queued edits; must outlive the script.
+ * @param capacity Number of elements in edits.
+ *
+ * @return uint32_t 1 on success, 0 if script is NULL or edits is NULL with a non-zero capacity.
+ */
+inline uint32_t sstr_edit_script_init(StaticStringEditScript *script, StaticStringEdit *edits, uint32_t capacity)
+{
+    if (script == NULL || (edits == NULL && capacity > 0))
+    {
+        return 0;
+    }
+    script->edits = edits;
+    script->count = 0;
+    script->capacity = capacity;
+    return 1;
+}
+
+/**
+ * @brief Removes all queued edits.
+ *
+ * @param script Script to reset.
+ */
+inline void sstr_edit_script_clear(StaticStringEditScript *script)
+{
+    if (script != NULL)
+    {
+        script->count = 0;
+    }
+}
+
+/**
+ * @brief Queues an edit that replaces delete_length characters at offset with insert.
+ *
+ * Offsets always refer to the string as it was before any queued edit. The
+ * removed ranges of a script must not overlap. Edits at the same offset are
+ * applied in the order they were queued, and only the last of them may
+ * remove characters.
+ *
+ * @param script Script to add to.
+ * @param offset Position in the original string.
+ * @param delete_length Number of characters to remove at offset, possibly 0.
+ * @param insert Characters to insert at offset, possibly empty.
+ *
+ * @return uint32_t 1 if the edit was queued, 0 if the script is full.
+ */
+inline uint32_t sstr_edit_script_add(StaticStringEditScript *script, uint32_t offset, uint32_t delete_length, StaticStringView insert)
+{
+    if (script == NULL || script->count >= script->capacity || (insert.data == NULL && insert.length > 0))
+    {
+        return 0;
+    }
+    StaticStringEdit *edit = &script->edits[script->count++];
+    edit->offset = offset;
+    edit->delete_length = delete_length;
+    edit->insert = insert;
+    return 1;
+}
+
+/**
+ * @brief Queues the insertion of a C string at offset.
+ *
+ * @param script Script to add to.
+ * @param offset Position in the original string.
+ * @param cstr Null-terminated string to insert; must stay valid until the script is applied.
+ *
+ * @return uint32_t 1 if the edit was queued, 0 otherwise.
+ */
+inline uint32_t sstr_edit_script_insert_cstr(StaticStringEditScript *script, uint32_t offset, const char *cstr)
+{
+    return cstr != NULL && sstr_edit_script_add(script, offset, 0, sstr_view_cstr(cstr));
+}
+
+/**
+ * @brief Queues the removal of length characters at offset.
+ *
+ * @param script Script to add to.
+ * @param offset Position in the original string.
+ * @param length Number of characters to remove.
+ *
+ * @return uint32_t 1 if the edit was queued, 0 otherwise.
+ */
+inline uint32_t sstr_edit_script_remove(StaticStringEditScript *script, uint32_t offset, uint32_t length)
+{
+    StaticStringView empty = {"", 0};
+    return sstr_edit_script_add(script, offset, length, empty);
+}
+
+/**
+ * @brief Queues the replacement of length characters at offset with a C string.
+ *
+ * @param script Script to add to.
+ * @param offset Position in the original string.
+ * @param length Number of characters to replace.
+ * @param cstr Null-terminated replacement; must stay valid until the script is applied.
+ *
+ * @return uint32_t 1 if the edit was queued, 0 otherwise.
+ */
+inline uint32_t sstr_edit_script_replace_cstr(StaticStringEditScript *script, uint32_t offset, uint32_t length, const char *cstr)
+{
+    return cstr != NULL && sstr_edit_script_add(script, offset, length, sstr_view_cstr(cstr));
+}
+
+/**
+ * @brief Core implementation of sstr_apply_edits().
+ *
+ * Edits are first sorted by offset with a stable insertion sort, which is
+ * linear for scripts queued in order. The kept characters between edits form
+ * segments that each move by the net size change of the edits before them.
+ * Segments moving left are moved front to back, then segments moving right
+ * back to front, so no segment overwrites characters that have not moved yet;
+ * the inserted characters are copied last.
+ *
+ * @param data Character buffer of capacity + 1 bytes.
+ * @param length Pointer to the string length.
+ * @param capacity Maximum number of characters the buffer can hold.
+ * @param edits Edits to apply; reordered by offset in place.
+ * @param count Number of edits.
+ *
+ * @return uint32_t 1 if the edits were applied, 0 if they overlap, fall outside the
+ *         string or the result does not fit. The string is unchanged on failure.
+ */
+inline uint32_t sstr_core_apply_edits(char *data, uint32_t *length, uint32_t capacity, StaticStringEdit *edits, uint32_t count)
+{
+    for (uint32_t i = 1; i < count; i++)
+    {
+        if (edits[i].offset < edits[i - 1].offset)
+        {
+            StaticStringEdit edit = edits[i];
+            uint32_t j = i;
+            for (; j > 0 && edits[j - 1].offset > edit.offset; j--)
+            {
+                edits[j] = edits[j - 1];
+            }
+            edits[j] = edit;
+        }
+    }
+
+    uint64_t new_length = *length;
+    uint64_t covered = 0; // End of the last removed range
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const StaticStringEdit *edit = &edits[i];
+        uint64_t end = (uint64_t)edit->offset + edit->delete_length;
+        if (edit->offset < covered || end > *length)
+        {
+            return 0;
+        }
+        if (edit->insert.length > 0 && edit->insert.data < data + *length && edit->insert.data + edit->insert.length > data)
+        {
+            return 0;
+        }
+        covered = end;
+        new_length += (uint64_t)edit->insert.length - edit->delete_length;
+    }
+    if (new_length > capacity)
+    {
+        return 0;
+    }
+
+    // Segment i (1 <= i <= count) runs from the end of edit i - 1 to the start of edit i, or the end of the string
+    int64_t delta = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        delta += (int64_t)edits[i].insert.length - (int64_t)edits[i].delete_length;
+        uint32_t start = edits[i].offset + edits[i].delete_length;
+        uint32_t end = i + 1 < count ? edits[i + 1].offset : *length;
+        if (delta < 0 && end > start)
+        {
+            memmove(data + start + delta, data + start, end - start);
+        }
+    }
+    for (uint32_t i = count; i > 0; i--)
+    {
+        uint32_t start = edits[i - 1].offset + edits[i - 1].delete_length;
+        uint32_t end = i < count ? edits[i].offset : *length;
+        if (delta > 0 && end > start)
+        {
+            memmove(data + start + delta, data + start, end - start);
+        }
+        delta -= (int64_t)edits[i - 1].insert.length - (int64_t)edits[i - 1].delete_length;
+    }
+    for (uint32_t i = 0; i < count; i++)
+    {
+        delta += (int64_t)edits[i].insert.length;
+        if (edits[i].insert.length > 0)
+        {
+            memcpy(data + edits[i].offset + delta - edits[i].insert.length, edits[i].insert.data, edits[i].insert.length);
+        }
+        delta -= (int64_t)edits[i].delete_length;
+    }
+
+    *length = (uint32_t)new_length;
+    data[*length] = '\0';
+    return 1;
+}
+
+/**
+ * @brief Applies all edits of a script to a StaticString in one pass.
+ *
+ * Equivalent to performing the edits one by one from the highest offset to
+ * the lowest, but each kept character is moved only once. The script is left
+ * sorted by offset and can be applied again or cleared.
+ *
+ * @param sstr Pointer to the StaticString to modify.
+ * @param script Edits to apply, with offsets into the current contents of sstr.
+ *
+ * @return uint32_t 1 if the edits were applied, 0 if they overlap, fall outside the
+ *         string or the result would exceed the maximum length. The string is
+ *         unchanged on failure.
+ */
+inline uint32_t sstr_apply_edits(StaticString *sstr, StaticStringEditScript *script)
+{
+    if (sstr == NULL || script == NULL)
+    {
+        return 0;
+    }
+    uint32_t result = sstr_core_apply_edits(sstr->static_string, &sstr->string_length, SSTR_MAX_LENGTH, script->edits, script->count);
+    if (result)
+    {
+        sstr_cache_rebuild(sstr);
+    }
+    return result;
+}
+
+/*
+ * ---------------------------------------------------------------------------
+ * Gap buffer
+ *
+ * Edits a StaticString in place as a gap buffer, for line editors that insert
+ * and delete at a cursor. The characters after the gap are kept at the end of
+ * the string's buffer, so inserting or deleting at the gap is O(1); moving the
+ * cursor is O(1) as well, and the gap follows it on the next edit by moving
+ * only the characters in between. While edits are in progress the StaticString
+ * itself is not valid: sstr_gap_to_cstr() closes the gap, null-terminates the
+ * string and updates its length, after which it can be used directly until
+ * the next gap edit. Call sstr_gap_init() again after modifying the string
+ * through any other function.
+ * ---------------------------------------------------------------------------
+ */
+
+typedef struct
+{
+    StaticString *sstr; // Edited string; its buffer holds the text before and after the gap
+    uint32_t gap_start; // Number of characters before the gap
+    uint32_t gap_end;   // Buffer index of the first character after the gap
+    uint32_t cursor;    // Edit position; the gap is moved here by the next edit
+} StaticStringGapBuffer;
+
+/**
+ * @brief Moves a gap so that it starts at position.
+ *
+ * The characters between the old and the new gap position are moved across
+ * the gap with one memmove(); the gap size is unchanged.
+ *
+ * @param data Character buffer.
+ * @param gap_start Pointer to the number of characters before the gap.
+ * @param gap_end Pointer to the buffer index of the first character after the gap.
+ * @param position New gap start, at most the number of characters in the buffer.
+ */
+inline void sstr_core_gap_move(char *data, uint32_t *gap_start, uint32_t *gap_end, uint32_t position)
+{
+    if (position < *gap_start)
+    {
+        uint32_t count = *gap_start - position;
+        memmove(data + *gap_end - count, data + position, count);
+        *gap_start = position;
+        *gap_end -= count;
+    }
+    else if (position > *gap_start)
+    {
+        uint32_t count = position - *gap_start;
+        memmove(data + *gap_start, data + *gap_end, count);
+        *gap_start = position;
+        *gap_end += count;
+    }
+}
+
+/**
+ * @brief Starts gap-buffer editing of a StaticString.
+ *
+ * The gap initially spans the unused end of the buffer and the cursor is
+ * placed after the last character, so no characters are moved.
+ *
+ * @param gap Gap buffer state to initialize.
+ * @param sstr Pointer to the StaticString to edit.
+ *
+ * @return uint32_t 1 on success, 0 if gap or sstr is NULL.
+ */
+inline uint32_t sstr_gap_init(StaticStringGapBuffer *gap, StaticString *sstr)
+{
+    if (gap == NULL || sstr == NULL)
+    {
+        return 0;
+    }
+    gap->sstr = sstr;
+    gap->gap_start = sstr->string_length;
+    gap->gap_end = SSTR_MAX_LENGTH;
+    gap->cursor = sstr->string_length;
+    return 1;
+}
+
+/**
+ * @brief Returns the number of characters in a gap buffer.
+ *
+ * @param gap Pointer to the gap buffer.
+ *
+ * @return uint32_t The number of characters, excluding the gap.
+ */
+inline uint32_t sstr_gap_length(const StaticStringGapBuffer *gap)
+{
+    return gap->gap_start + (SSTR_MAX_LENGTH - gap->gap_end);
+}
+
+/**
+ * @brief Returns the cursor position of a gap buffer.
+ *
+ * @param gap Pointer to the gap buffer.
+ *
+ * @return uint32_t Number of characters before the cursor.
+ */
+inline uint32_t sstr_gap_cursor(const StaticStringGapBuffer *gap)
+{
+    return gap->cursor;
+}
+
+/**
+ * @brief Moves the cursor of a gap buffer.
+ *
+ * No characters are moved until the next edit.
+ *
+ * @param gap Pointer to the gap buffer.
+ * @param position New cursor position, at most sstr_gap_length().
+ *
+ * @return uint32_t 1 if the cursor was moved, 0 if position is out of bounds.
+ */
+inline uint32_t sstr_gap_set_cursor(StaticStringGapBuffer *gap, uint32_t position)
+{
+    if (gap == NULL || position > sstr_gap_length(gap))
+    {
+        return 0;
+    }
+    gap->cursor = position;
+    return 1;
+}
+
+/**
+ * @brief Inserts a character at the cursor and advances the cursor past it.
+ *
+ * @param gap Pointer to the gap buffer.
+ * @param character The character to insert.
+ *
+ * @return uint32_t 1 if the character was inserted, 0 if the buffer is full.
+ */
+inline uint32_t sstr_gap_insert(StaticStringGapBuffer *gap, char character)
+{
+    if (gap == NULL || gap->gap_start == gap->gap_end)
+    {
+        return 0;
+    }
+    sstr_core_gap_move(gap->sstr->static_string, &gap->gap_start, &gap->gap_end, gap->cursor);
+    gap->sstr->static_string[gap->gap_start++] = character;
+    gap->cursor++;
+    return 1;
+}
+
+/**
+ * @brief Inserts a C string at the cursor and advances the cursor past it.
+ *
+ * @param gap Pointer to the gap buffer.
+ * @param cstr Null-terminated C string to insert.
+ *
+ * @return uint32_t 1 if the string was inserted, 0 if it does not fit.
+ */
+inline uint32_t sstr_gap_insert_cstr(StaticStringGapBuffer *gap, const char *cstr)
+{
+    if (gap == NULL || cstr == NULL)
+    {
+        return 0;
+    }
+    size_t count = strlen(cstr);
+    if (count > gap->gap_end - gap->gap_start)
+    {
+        return 0;
+    }
+    sstr_core_gap_move(gap->sstr->static_string, &gap->gap_start, &gap->gap_end, gap->cursor);
+    memcpy(gap->sstr->static_string + gap->gap_start, cstr, count);
+    gap->gap_start += (uint32_t)count;
+    gap->cursor += (uint32_t)count;
+    return 1;
+}
+
+/**
+ * @brief Deletes the character before the cursor, like the backspace key.
+ *
+ * @param gap Pointer to the gap buffer.
+ *
+ * @return uint32_t 1 if a character was deleted, 0 if the cursor is at the start.
+ */
+inline uint32_t sstr_gap_backspace(StaticStringGapBuffer *gap)
+{
+    if (gap == NULL || gap->cursor == 0)
+    {
+        return 0;
+    }
+    sstr_core_gap_move(gap->sstr->static_string, &gap->gap_start, &gap->gap_end, gap->cursor);
+    gap->gap_start--;
+    gap->cursor--;
+    return 1;
+}
+
+/**
+ * @brief Deletes the character after the cursor, like the delete key.
+ *
+ * @param gap Pointer to the gap buffer.
+ *
+ * @return uint32_t 1 if a character was deleted, 0 if the cursor is at the end.
+ */
+inline uint32_t sstr_gap_delete(StaticStringGapBuffer *gap)
+{
+    if (gap == NULL || gap->cursor == sstr_gap_length(gap))
+    {
+        return 0;
+    }
+    sstr_core_gap_move(gap->sstr->static_string, &gap->gap_start, &gap->gap_end, gap->cursor);
+    gap->gap_end++;
+    return 1;
+}
+
+/**
+ * @brief Returns the character at a given index of a gap buffer.
+ *
+ * @param gap Pointer to the gap buffer.
+ * @param index Zero-based index, ignoring the gap.
+ *
+ * @return char The character, or '\0' if index is out of bounds.
+ */
+inline char sstr_gap_char_at(const StaticStringGapBuffer *gap, uint32_t index)
+{
+    if (gap == NULL || index >= sstr_gap_length(gap))
+    {
+        return '\0';
+    }
+    return index < gap->gap_start ? gap->sstr->static_string[index] : gap->sstr->static_string[gap->gap_end + (index - gap->gap_start)];
+}
+
+/**
+ * @brief Closes the gap and returns the edited string as a C string.
+ *
+ * Moves the characters after the gap next to those before it, null-terminates
+ * the string and updates the StaticString's length, so the StaticString can
+ * be used directly again. Only the characters after the gap are moved, and
+ * none if the last edit was at the end. The cursor is kept; editing can
+ * continue afterwards.
+ *
+ * @param gap Pointer to the gap buffer.
+ *
+ * @return const char* The null-terminated string, or NULL if gap is NULL.
+ */
+inline const char *sstr_gap_to_cstr(StaticStringGapBuffer *gap)
+{
+    if (gap == NULL)
+    {
+        return NULL;
+    }
+    StaticString *sstr = gap->sstr;
+    uint32_t length = sstr_gap_length(gap);
+    sstr_core_gap_move(sstr->static_string, &gap->gap_start, &gap->gap_end, length);
+    sstr->static_string[length] = '\0';
+    sstr->string_length = length;
+    sstr_cache_rebuild(sstr);
+    return sstr->static_string;
+}
+
+#ifdef __cplusplus
+
+#include <type_traits>
+
+/*
+ * ---------------------------------------------------------------------------
+ * BasicStaticString<N, LenT, Layout, CachedHash> C++ template
+ *
+ * A StaticString whose capacity N is part of the type. The length field uses
+ * the smallest unsigned type able to hold N, so small strings do not pay for a
+ * 32-bit length. All member functions forward to the runtime-capacity core.
+ *
+ * Layout selects where the length lives:
+ *   SSTR_LAYOUT_HEADER_FIRST (default) - length before the buffer, so reading
+ *       the length and the first characters touches a single cache line.
+ *   SSTR_LAYOUT_TRAILING - length after the buffer, like the StaticString struct.
+ *   SSTR_LAYOUT_COMPACT - no length field; the last byte holds N - length, so
+ *       it doubles as the null terminator when the string is full (N <= 255).
+ *
+ * CachedHash keeps the hash state next to the string, like SSTR_CACHED_HASH
+ * does for the StaticString struct, so hash() is O(1) and equals() can reject
+ * most unequal strings without reading them. It costs 8 bytes per string.
+ * ---------------------------------------------------------------------------
+ */
+
+namespace sstr_detail
+{
+    // Smallest unsigned integer type able to represent values up to N
+    template <uint32_t N>
+    struct length_type
+    {
+        typedef typename std::conditional<(N <= 0xFFu), uint8_t,
+                                          typename std::conditional<(N <= 0xFFFFu), uint16_t, uint32_t>::type>::type type;
+    };
+
+    // Character buffer and length storage for each SSTR_LAYOUT_* value
+    template <uint32_t N, typename LenT, int Layout>
+    struct layout_storage;
+
+    template <uint32_t N, typename LenT>
+    struct layout_storage<N, LenT, SSTR_LAYOUT_HEADER_FIRST>
+    {
+        LenT string_length;      // Number of characters in the string (excluding the null terminator)
+        char string_data[N + 1]; // char array + null terminator
+
+        uint32_t get_length() const { return string_length; }
+        void set_length(uint32_t length) { string_length = (LenT)length; }
+    };
+
+    template <uint32_t N, typename LenT>
+    struct layout_storage<N, LenT, SSTR_LAYOUT_TRAILING>
+    {
+        char string_data[N + 1]; // char array + null terminator
+        LenT string_length;      // Number of characters in the string (excluding the null terminator)
+
+        uint32_t get_length() const { return string_length; }
+        void set_length(uint32_t length) { string_length = (LenT)length; }
+    };
+
+    template <uint32_t N, typename LenT>
+    struct layout_storage<N, LenT, SSTR_LAYOUT_COMPACT>
+    {
+        static_assert(N <= 0xFFu, "SSTR_LAYOUT_COMPACT requires N <= 255");
+
+        char string_data[N + 1]; // char array + remaining capacity (null terminator when full)
+
+        uint32_t get_length() const { return N - (uint8_t)string_data[N]; }
+        void set_length(uint32_t length) { string_data[N] = (char)(uint8_t)(N - length); }
+    };
+
+    // Hash state storage; the uncached variant is empty and computes the state on demand
+    template <bool Cached>
+    struct hash_cache;
+
+    template <>
+    struct hash_cache<true>
+    {
+        uint64_t hash_state; // Polynomial hash state of the characters
+
+        uint64_t get_hash_state(const char *, uint32_t) const { return hash_state; }
+        void cache_rebuild(const char *data, uint32_t length) { hash_state = sstr_hash_extend(0, data, length); }
+        void cache_extend(const char *data, uint32_t old_length, uint32_t length)
+        {
+            hash_state = sstr_hash_extend(hash_state, data + old_length, length - old_length);
+        }
+        // Must run before the characters past new_length are overwritten
+        void cache_truncate(const char *data, uint32_t length, uint32_t new_length)
+        {
+            hash_state = sstr_hash_remove_suffix(hash_state, data + new_length, length - new_length);
+        }
+        void cache_replace(const char *data, uint32_t length, uint32_t index, char old_char)
+        {
+            uint64_t weight = sstr_hash_pow(SSTR_HASH_BASE, length - 1 - index);
+            hash_state += ((uint64_t)(uint8_t)data[index] - (uint64_t)(uint8_t)old_char) * weight;
+        }
+    };
+
+    template <>
+    struct hash_cache<false>
+    {
+        uint64_t get_hash_state(const char *data, uint32_t length) const { return sstr_hash_extend(0, data, length); }
+        void cache_rebuild(const char *, uint32_t) {}
+        void cache_extend(const char *, uint32_t, uint32_t) {}
+        void cache_truncate(const char *, uint32_t, uint32_t) {}
+        void cache_replace(const char *, uint32_t, uint32_t, char) {}
+    };
+}
+
+// Range over the tokens of a StaticStringSplit, for use in range-based for loops
+class StaticStringSplitRange
+{
+public:
+    class iterator
+    {
+    public:
+        iterator() : done(true) { token.data = ""; token.length = 0; }
+        explicit iterator(const StaticStringSplit &state) : split(state), done(false) { ++*this; }
+
+        const StaticStringView &operator*() const { return token; }
+        const StaticStringView *operator->() const { return &token; }
+        iterator &operator++()
+        {
+            done = sstr_split_next(&split, &token) == 0;
+            return *this;
+        }
+        // Tokens of one input start at distinct positions, so the data pointer identifies them
+        bool operator==(const iterator &other) const { return done == other.done && (done || token.data == other.token.data); }
+        bool operator!=(const iterator &other) const { return !(*this == other); }
+
+    private:
+        StaticStringSplit split;
+        StaticStringView token;
+        bool done;
+    };
+
+    explicit StaticStringSplitRange(const StaticStringSplit &state) : split(state) {}
+
+    iterator begin() const { return iterator(split); }
+    iterator end() const { return iterator(); }
+
+private:
+    StaticStringSplit split;
+};
+
+inline StaticStringSplitRange sstr_split(StaticStringView input, char delimiter)
+{
+    StaticStringSplit split;
+    sstr_split_init(&split, input, delimiter);
+    return StaticStringSplitRange(split);
+}
+
+// An empty or NULL delimiter set yields the whole input as one token
+inline StaticStringSplitRange sstr_split_any(StaticStringView input, const char *delimiters)
+{
+    StaticStringSplit split;
+    if (!sstr_split_init_any(&split, input, delimiters))
+    {
+        sstr_split_reset(&split, input, SSTR_SPLIT_ANY);
+    }
+    return StaticStringSplitRange(split);
+}
+
+// An empty delimiter yields the whole input as one token
+inline StaticStringSplitRange sstr_split(StaticStringView input, StaticStringView delimiter)
+{
+    StaticStringSplit split;
+    if (!sstr_split_init_string(&split, input, delimiter))
+    {
+        sstr_split_reset(&split, input, SSTR_SPLIT_ANY);
+    }
+    return StaticStringSplitRange(split);
+}
+
+template <uint32_t N, typename LenT = typename sstr_detail::length_type<N>::type, int Layout = SSTR_LAYOUT_HEADER_FIRST,
+          bool CachedHash = false>
+class BasicStaticString : private sstr_detail::hash_cache<CachedHash>
+{
+    static_assert(N > 0, "BasicStaticString capacity must be at least 1");
+    static_assert(std::is_unsigned<LenT>::value, "BasicStaticString length type must be unsigned");
+    static_assert((uint64_t)N <= (uint64_t)(LenT)(-1), "BasicStaticString length type is too small for N");
+
+public:
+    typedef LenT length_type;
+    static const uint32_t max_length = N; // Maximum length excluding the null terminator
+    static const int layout = Layout;
+    static const bool cached_hash = CachedHash;
+
+    BasicStaticString() { init(); }
+    BasicStaticString(const char *cstr)
+    {
+        init();
+        from_cstr(cstr);
+    }
+
+    uint32_t init()
+    {
+        uint32_t len;
+        uint32_t result = sstr_core_init(storage.string_data, &len);
+        storage.set_length(len);
+        this->cache_rebuild(storage.string_data, len);
+        return result;
+    }
+
+    uint32_t from_cstr(const char *cstr, uint32_t *truncated = NULL) { return edit(sstr_core_from_cstr, cstr, truncated); }
+    uint32_t from_cstr_lowercase(const char *cstr, uint32_t *truncated = NULL) { return edit(sstr_core_from_cstr_lowercase, cstr, truncated); }
+    uint32_t from_cstr_uppercase(const char *cstr, uint32_t *truncated = NULL) { return edit(sstr_core_from_cstr_uppercase, cstr, truncated); }
+    uint32_t clear() { return edit(sstr_core_clear); }
+    uint32_t secure_wipe() { return edit(sstr_core_secure_wipe); }
+    uint32_t append(char character) { return append_edit(sstr_core_append, character); }
+    uint32_t append_cstr(const char *cstr, uint32_t *truncated = NULL) { return append_edit(sstr_core_append_cstr, cstr, truncated); }
+    uint32_t insert_char_at(uint32_t index, char character) { return edit(sstr_core_insert_char_at, index, character); }
+    uint32_t insert_cstr(uint32_t index, const char *cstr)
+    {
+        return cstr == NULL ? 0 : edit(sstr_core_insert, index, cstr, (uint32_t)strlen(cstr));
+    }
+    uint32_t insert(uint32_t index, StaticStringView src) { return edit(sstr_core_insert, index, src.data, src.length); }
+    template <uint32_t M, typename L, int Y, bool H>
+    uint32_t insert(uint32_t index, const BasicStaticString<M, L, Y, H> &src)
+    {
+        return edit(sstr_core_insert, index, src.data(), src.length());
+    }
+
+    uint32_t truncate(uint32_t new_length)
+    {
+        if (new_length > length())
+        {
+            return 0;
+        }
+        this->cache_truncate(storage.string_data, length(), new_length);
+        uint32_t len = length();
+        uint32_t result = sstr_core_truncate(storage.string_data, &len, N, new_length);
+        storage.set_length(len);
+        return result;
+    }
+
+    uint32_t replace_char_from_index(uint32_t index, char character)
+    {
+        char old_char = index < length() ? storage.string_data[index] : '\0';
+        uint32_t result = sstr_core_replace_char_from_index(storage.string_data, length(), N, index, character);
+        if (result)
+        {
+            this->cache_replace(storage.string_data, length(), index, old_char);
+        }
+        return result;
+    }
+    uint32_t replace_all_chars(char old_char, char new_char)
+    {
+        return rehash(sstr_core_replace_all_chars(storage.string_data, length(), old_char, new_char));
+    }
+
+    uint32_t remove_at(uint32_t index) { return edit_fixed(sstr_core_remove_at, index); }
+    uint32_t remove_range(uint32_t start, uint32_t end) { return edit_fixed(sstr_core_remove_range, start, end); }
+    uint32_t replace_range_cstr(uint32_t start, uint32_t end, const char *cstr)
+    {
+        return cstr == NULL ? 0 : edit(sstr_core_replace_range, start, end, cstr, (uint32_t)strlen(cstr));
+    }
+    uint32_t replace_range(uint32_t start, uint32_t end, StaticStringView src)
+    {
+        return edit(sstr_core_replace_range, start, end, src.data, src.length);
+    }
+    template <uint32_t M, typename L, int Y, bool H>
+    uint32_t replace_range(uint32_t start, uint32_t end, const BasicStaticString<M, L, Y, H> &src)
+    {
+        return edit(sstr_core_replace_range, start, end, src.data(), src.length());
+    }
+    // Replaces every occurrence of needle; truncated, if given, is set when the result was cut off at capacity
+    uint32_t replace_all(StaticStringView needle, StaticStringView replacement, uint32_t *truncated = NULL)
+    {
+        return edit(sstr_core_replace_all, needle.data, needle.length, replacement.data, replacement.length, truncated);
+    }
+    uint32_t replace_all_cstr(const char *needle, const char *replacement, uint32_t *truncated = NULL)
+    {
+        return replace_all(sstr_view_cstr(needle), sstr_view_cstr(replacement), truncated);
+    }
+    uint32_t trim_leading() { return edit_fixed(sstr_core_trim_leading); }
+    uint32_t trim_trailing() { return edit_fixed(sstr_core_trim_trailing); }
+    uint32_t trim() { return edit_fixed(sstr_core_trim); }
+    uint32_t trim_class(const StaticStringCharClass &cls) { return edit_fixed(sstr_core_trim_class, &cls); }
+    uint32_t strip_all_whitespace() { return edit_fixed(sstr_core_strip_all_whitespace); }
+    uint32_t strip_class(const StaticStringCharClass &cls) { return edit_fixed(sstr_core_strip_class, &cls); }
+    uint32_t strip_chars(const char *chars)
+    {
+        if (chars == NULL)
+        {
+            return 0;
+        }
+        StaticStringCharClass cls = sstr_char_class_make(chars);
+        return strip_class(cls);
+    }
+    uint32_t apply_edits(StaticStringEditScript *script)
+    {
+        return script == NULL ? 0 : edit(sstr_core_apply_edits, script->edits, script->count);
+    }
+
+    char pop()
+    {
+        uint32_t len = length();
+        if (len > 0)
+        {
+            this->cache_truncate(storage.string_data, len, len - 1);
+        }
+        char result = sstr_core_pop(storage.string_data, &len);
+        storage.set_length(len);
+        return result;
+    }
+
+    uint32_t reverse() { return rehash(sstr_core_reverse(storage.string_data, length())); }
+    uint32_t to_uppercase() { return rehash(sstr_core_to_uppercase(storage.string_data, length())); }
+    uint32_t to_lowercase() { return rehash(sstr_core_to_lowercase(storage.string_data, length())); }
+    uint32_t translate(const StaticStringTranslation &table) { return rehash(sstr_core_translate(storage.string_data, length(), &table)); }
+
+    // Copies or compares against a string of any capacity and layout
+    template <uint32_t M, typename L, int Y, bool H>
+    uint32_t copy(const BasicStaticString<M, L, Y, H> &other)
+    {
+        return copy_from(other.data(), other.length());
+    }
+    uint32_t copy(const StaticString *other)
+    {
+        return other == NULL ? 0 : copy_from(other->static_string, other->string_length);
+    }
+    uint32_t copy(StaticStringView other) { return copy_from(other.data, other.length); }
+
+    template <uint32_t M, typename L, int Y, bool H>
+    uint32_t substring(BasicStaticString<M, L, Y, H> &dest, uint32_t start, uint32_t end) const
+    {
+        return dest.substring_from(storage.string_data, length(), start, end);
+    }
+    template <uint32_t M, typename L, int Y, bool H>
+    uint32_t replace_all_copy(BasicStaticString<M, L, Y, H> &dest, StaticStringView needle, StaticStringView replacement,
+                              uint32_t *truncated = NULL) const
+    {
+        return dest.replace_all_from(storage.string_data, length(), needle, replacement, truncated);
+    }
+
+    template <uint32_t M, typename L, int Y, bool H>
+    uint32_t equals(const BasicStaticString<M, L, Y, H> &other) const
+    {
+        if (CachedHash && H && hash_state() != other.hash_state())
+        {
+            return 0;
+        }
+        return sstr_core_equals(storage.string_data, length(), other.data(), other.length());
+    }
+    uint32_t equals(const StaticString *other) const
+    {
+        return other == NULL ? 0 : sstr_core_equals(storage.string_data, length(), other->static_string, other->string_length);
+    }
+    uint32_t equals(StaticStringView other) const { return sstr_core_equals(storage.string_data, length(), other.data, other.length); }
+    uint32_t equals_cstr(const char *cstr) const { return sstr_core_equals_cstr(storage.string_data, length(), cstr); }
+
+    template <uint32_t M, typename L, int Y, bool H>
+    int32_t compare(const BasicStaticString<M, L, Y, H> &other) const
+    {
+        return sstr_core_compare(storage.string_data, length(), other.data(), other.length());
+    }
+    int32_t compare(const StaticString *other) const
+    {
+        return other == NULL ? 1 : sstr_core_compare(storage.string_data, length(), other->static_string, other->string_length);
+    }
+    int32_t compare(StaticStringView other) const { return sstr_core_compare(storage.string_data, length(), other.data, other.length); }
+
+    // Case-insensitive counterparts; ASCII letters only
+    template <uint32_t M, typename L, int Y, bool H>
+    uint32_t iequals(const BasicStaticString<M, L, Y, H> &other) const
+    {
+        return sstr_core_iequals(storage.string_data, length(), other.data(), other.length());
+    }
+    uint32_t iequals(StaticStringView other) const { return sstr_core_iequals(storage.string_data, length(), other.data, other.length); }
+    uint32_t iequals_cstr(const char *cstr) const { return sstr_core_iequals_cstr(storage.string_data, length(), cstr); }
+    template <uint32_t M, typename L, int Y, bool H>
+    int32_t icompare(const BasicStaticString<M, L, Y, H> &other) const
+    {
+        return sstr_core_icompare(storage.string_data, length(), other.data(), other.length());
+    }
+    int32_t icompare(StaticStringView other) const { return sstr_core_icompare(storage.string_data, length(), other.data, other.length); }
+    template <uint32_t M, typename L, int Y, bool H>
+    int32_t ifind(const BasicStaticString<M, L, Y, H> &needle, uint32_t start = 0) const
+    {
+        return sstr_core_ifind(storage.string_data, length(), needle.data(), needle.length(), start);
+    }
+    int32_t ifind(StaticStringView needle, uint32_t start = 0) const
+    {
+        return sstr_core_ifind(storage.string_data, length(), needle.data, needle.length, start);
+    }
+    int32_t ifind_cstr(const char *needle, uint32_t start = 0) const
+    {
+        return needle == NULL ? -1 : sstr_core_ifind(storage.string_data, length(), needle, (uint32_t)strlen(needle), start);
+    }
+    uint64_t ihash() const { return sstr_core_ihash(storage.string_data, length()); }
+
+    uint32_t contains(char ch) const { return sstr_core_contains(storage.string_data, length(), ch); }
+    int32_t first_index_of(char ch) const { return sstr_core_first_index_of(storage.string_data, length(), ch); }
+    int32_t last_index_of(char ch) const { return sstr_core_last_index_of(storage.string_data, length(), ch); }
+    int32_t index_of_from(char ch, uint32_t start) const { return sstr_core_index_of_from(storage.string_data, length(), ch, start); }
+    int32_t find_first_of(const StaticStringCharClass &cls) const { return sstr_core_find_first_of(storage.string_data, length(), &cls); }
+    int32_t find_first_not_of(const StaticStringCharClass &cls) const
+    {
+        return sstr_core_find_first_not_of(storage.string_data, length(), &cls);
+    }
+    uint32_t span(const StaticStringCharClass &cls) const { return sstr_core_span(storage.string_data, length(), &cls); }
+    uint32_t cspan(const StaticStringCharClass &cls) const { return sstr_core_cspan(storage.string_data, length(), &cls); }
+
+    template <uint32_t M, typename L, int Y, bool H>
+    int32_t find(const BasicStaticString<M, L, Y, H> &needle, uint32_t start = 0) const
+    {
+        return sstr_core_find(storage.string_data, length(), needle.data(), needle.length(), start);
+    }
+    int32_t find(StaticStringView needle, uint32_t start = 0) const
+    {
+        return sstr_core_find(storage.string_data, length(), needle.data, needle.length, start);
+    }
+    int32_t find_cstr(const char *needle, uint32_t start = 0) const
+    {
+        return needle == NULL ? -1 : sstr_core_find(storage.string_data, length(), needle, (uint32_t)strlen(needle), start);
+    }
+    template <uint32_t M, typename L, int Y, bool H>
+    int32_t rfind(const BasicStaticString<M, L, Y, H> &needle) const
+    {
+        return sstr_core_rfind(storage.string_data, length(), needle.data(), needle.length());
+    }
+    int32_t rfind(StaticStringView needle) const { return sstr_core_rfind(storage.string_data, length(), needle.data, needle.length); }
+    int32_t rfind_cstr(const char *needle) const
+    {
+        return needle == NULL ? -1 : sstr_core_rfind(storage.string_data, length(), needle, (uint32_t)strlen(needle));
+    }
+    template <uint32_t M, typename L, int Y, bool H>
+    uint32_t find_all(const BasicStaticString<M, L, Y, H> &needle, uint32_t *positions, uint32_t max_positions) const
+    {
+        return sstr_core_find_all(storage.string_data, length(), needle.data(), needle.length(), positions, max_positions);
+    }
+    uint32_t find_all(StaticStringView needle, uint32_t *positions, uint32_t max_positions) const
+    {
+        return sstr_core_find_all(storage.string_data, length(), needle.data, needle.length, positions, max_positions);
+    }
+    uint32_t find_all_cstr(const char *needle, uint32_t *positions, uint32_t max_positions) const
+    {
+        return needle == NULL ? 0 : sstr_core_find_all(storage.string_data, length(), needle, (uint32_t)strlen(needle), positions, max_positions);
+    }
+
+    // 64-bit hash, equal to sstr_hash() of a StaticString with the same characters
+    uint64_t hash() const { return sstr_hash_finalize(hash_state(), length()); }
+    // Unfinalized polynomial state; O(1) when CachedHash is set
+    uint64_t hash_state() const { return this->get_hash_state(storage.string_data, length()); }
+
+    // Zero-copy views; they are invalidated by any mutation of this string
+    StaticStringView view() const
+    {
+        StaticStringView result = {storage.string_data, length()};
+        return result;
+    }
+    uint32_t substring_view(uint32_t start, uint32_t end, StaticStringView *out) const
+    {
+        return sstr_view_slice(view(), start, end, out);
+    }
+    StaticStringView trimmed_view() const { return sstr_view_trim(view()); }
+
+    // Token ranges over this string; invalidated like view()
+    StaticStringSplitRange split(char delimiter) const { return sstr_split(view(), delimiter); }
+    StaticStringSplitRange split(StaticStringView delimiter) const { return sstr_split(view(), delimiter); }
+    StaticStringSplitRange split_any(const char *delimiters) const { return sstr_split_any(view(), delimiters); }
+
+    uint32_t length() const { return storage.get_length(); }
+    static uint32_t capacity() { return N; }
+    const char *data() const { return storage.string_data; }
+    const char *to_cstr() const { return storage.string_data; }
+
+    // Raw-buffer entry points used by other capacities; prefer copy() and substring()
+    uint32_t copy_from(const char *src, uint32_t src_length) { return edit(sstr_core_copy, src, src_length); }
+    uint32_t substring_from(const char *src, uint32_t src_length, uint32_t start, uint32_t end)
+    {
+        uint32_t len = length();
+        uint32_t result = sstr_core_substring(src, src_length, storage.string_data, &len, N, start, end);
+        storage.set_length(len);
+        return rehash(result);
+    }
+    uint32_t replace_all_from(const char *src, uint32_t src_length, StaticStringView needle, StaticStringView replacement,
+                              uint32_t *truncated)
+    {
+        if (src == storage.string_data)
+        {
+            return replace_all(needle, replacement, truncated);
+        }
+        uint32_t len = length();
+        uint32_t result = sstr_core_replace_all_copy(src, src_length, storage.string_data, &len, N, needle.data, needle.length,
+                                                     replacement.data, replacement.length, truncated);
+        storage.set_length(len);
+        return rehash(result, true);
+    }
+
+private:
+    // Runs a core function taking (data, length*, capacity, ...) and stores the new length back
+    template <typename Fn, typename... Args>
+    uint32_t edit(Fn fn, Args... args)
+    {
+        uint32_t old_length = length();
+        uint32_t len = old_length;
+        uint32_t result = fn(storage.string_data, &len, N, args...);
+        storage.set_length(len);
+        return rehash(result, len != old_length);
+    }
+
+    // Same as edit() for core functions that do not need the capacity
+    template <typename Fn, typename... Args>
+    uint32_t edit_fixed(Fn fn, Args... args)
+    {
+        uint32_t old_length = length();
+        uint32_t len = old_length;
+        uint32_t result = fn(storage.string_data, &len, args...);
+        storage.set_length(len);
+        return rehash(result, len != old_length);
+    }
+
+    // Same as edit() for core functions that only add characters at the end
+    template <typename Fn, typename... Args>
+    uint32_t append_edit(Fn fn, Args... args)
+    {
+        uint32_t old_length = length();
+        uint32_t len = old_length;
+        uint32_t result = fn(storage.string_data, &len, N, args...);
+        storage.set_length(len);
+        this->cache_extend(storage.string_data, old_length, len);
+        return result;
+    }
+
+    // Recomputes the cached hash after a mutation that reported a change or resized the string
+    uint32_t rehash(uint32_t result, bool resized = false)
+    {
+        if (result || resized)
+        {
+            this->cache_rebuild(storage.string_data, length());
+        }
+        return result;
+    }
+
+    sstr_detail::layout_storage<N, LenT, Layout> storage;
+};
+
+// Comparison operators so strings can be used as keys of ordered containers
+template <uint32_t N, typename L1, int Y1, bool H1, uint32_t M, typename L2, int Y2, bool H2>
+inline bool operator==(const BasicStaticString<N, L1, Y1, H1> &lhs, const BasicStaticString<M, L2, Y2, H2> &rhs)
+{
+    return lhs.equals(rhs) != 0;
+}
+
+template <uint32_t N, typename L1, int Y1, bool H1, uint32_t M, typename L2, int Y2, bool H2>
+inline bool operator!=(const BasicStaticString<N, L1, Y1, H1> &lhs, const BasicStaticString<M, L2, Y2, H2> &rhs)
+{
+    return lhs.equals(rhs) == 0;
+}
+
+template <uint32_t N, typename L1, int Y1, bool H1, uint32_t M, typename L2, int Y2, bool H2>
+inline bool operator<(const BasicStaticString<N, L1, Y1, H1> &lhs, const BasicStaticString<M, L2, Y2, H2> &rhs)
+{
+    return lhs.compare(rhs) < 0;
+}
+
+inline bool operator==(StaticStringView lhs, StaticStringView rhs)
+{
+    return sstr_view_equals(lhs, rhs) != 0;
+}
+
+inline bool operator!=(StaticStringView lhs, StaticStringView rhs)
+{
+    return sstr_view_equals(lhs, rhs) == 0;
+}
+
+inline bool operator<(StaticStringView lhs, StaticStringView rhs)
+{
+    return sstr_view_compare(lhs, rhs) < 0;
+}
+
+inline bool operator==(const StaticString &lhs, const StaticString &rhs)
+{
+    return sstr_equals(&lhs, &rhs) != 0;
+}
+
+inline bool operator!=(const StaticString &lhs, const StaticString &rhs)
+{
+    return sstr_equals(&lhs, &rhs) == 0;
+}
+
+inline bool operator<(const StaticString &lhs, const StaticString &rhs)
+{
+    return sstr_compare(&lhs, &rhs) < 0;
+}
+
+#endif // __cplusplus
+
+#endif
@@ -0,0 +1,643 @@
+#ifndef STATICSTRINGMAP_H
+#define STATICSTRINGMAP_H
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <random>
+#include <utility>
+
+#include "StaticString.h"
+
+/*
+ * ---------------------------------------------------------------------------
+ * StaticStringMap<V, N> C++ template
+ *
+ * Open-addressing hash map from strings of up to N characters to V. Keys are
+ * stored inline as BasicStaticString<N> next to their values in one slot
+ * array, so inserting a key never allocates; the table itself is a single
+ * allocation that only changes on growth, reserve() or rehash.
+ *
+ * Each slot has a control byte: kEmpty, kDeleted, or the low 7 bits of the
+ * key hash (h2) when full. Lookups start at a position taken from the upper
+ * hash bits (h1) and compare a whole group of control bytes against h2 at
+ * once (16 with SSE2, 8 with portable SWAR code), so only slots whose h2
+ * matches have their key compared. The first SSTR_MAP_GROUP_WIDTH control
+ * bytes are mirrored past the end, which lets a group start at any slot.
+ *
+ * Keys are not hashed with sstr_hash(): its polynomial has a public base, so
+ * colliding keys can be constructed (e.g. from Thue-Morse strings) and would
+ * all land on one probe sequence. Each map instead draws a random seed and
+ * hashes keys with a seeded multiply-mix hash; cached string hashes are not
+ * reused.
+ * ---------------------------------------------------------------------------
+ */
+
+#if SSTR_X86 && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)) && \
+    (!defined(SSTR_SIMD_LEVEL) || SSTR_SIMD_LEVEL > SSTR_SIMD_SCALAR)
+#define SSTR_MAP_SSE2 1
+#define SSTR_MAP_GROUP_WIDTH 16u
+#else
+#define SSTR_MAP_SSE2 0
+#define SSTR_MAP_GROUP_WIDTH 8u
+#endif
+
+namespace sstr_detail
+{
+    const int8_t kMapEmpty = -128; // 0b10000000
+    const int8_t kMapDeleted = -2; // 0b11111110, tombstone left by erase()
+    const uint32_t kMapMinCapacity = SSTR_MAP_GROUP_WIDTH;
+
+    // Index of the highest set bit; value must be non-zero
+    inline uint32_t map_highest_bit(uint64_t value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63u - (uint32_t)__builtin_clzll(value);
+#else
+        uint32_t index = 0;
+        while (value >>= 1)
+        {
+            index++;
+        }
+        return index;
+#endif
+    }
+
+    // Full 64x64-bit product folded to 64 bits
+    inline uint64_t map_mix(uint64_t a, uint64_t b)
+    {
+#if defined(__SIZEOF_INT128__)
+        unsigned __int128 product = (unsigned __int128)a * b;
+        return (uint64_t)product ^ (uint64_t)(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        uint64_t high;
+        uint64_t low = _umul128(a, b, &high);
+        return low ^ high;
+#else
+        uint64_t a_lo = (uint32_t)a, a_hi = a >> 32, b_lo = (uint32_t)b, b_hi = b >> 32;
+        uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo, lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+        uint64_t cross = (lo_lo >> 32) + (uint32_t)hi_lo + lo_hi;
+        uint64_t high = hi_hi + (hi_lo >> 32) + (cross >> 32);
+        return ((cross << 32) | (uint32_t)lo_lo) ^ high;
+#endif
+    }
+
+    /*
+     * Seeded key hash, 16 bytes per multiply. The seed enters both operands
+     * of every multiply, so a key cannot zero one of them without knowing it.
+     * The last 1 to 16 bytes are read with overlapping loads, which never
+     * leave the key.
+     */
+    inline uint64_t map_hash(const char *key, uint32_t length, uint64_t seed)
+    {
+        const uint64_t k0 = 0xA0761D6478BD642FULL;
+        const uint64_t k1 = 0xE7037ED1A0B428DBULL;
+        uint64_t h = seed ^ k0;
+        uint64_t a = 0, b = 0;
+        if (length > 16)
+        {
+            for (uint32_t i = 0; i + 16 < length; i += 16)
+            {
+                h = map_mix(sstr_load64(key + i) ^ seed, sstr_load64(key + i + 8) ^ h);
+            }
+            a = sstr_load64(key + length - 16);
+            b = sstr_load64(key + length - 8);
+        }
+        else if (length >= 4)
+        {
+            uint32_t middle = (length >> 3) << 2; // 4 when 8 or more bytes, else 0
+            a = ((uint64_t)sstr_load32(key) << 32) | sstr_load32(key + middle);
+            b = ((uint64_t)sstr_load32(key + length - 4) << 32) | sstr_load32(key + length - 4 - middle);
+        }
+        else if (length > 0)
+        {
+            a = ((uint64_t)(uint8_t)key[0] << 16) | ((uint64_t)(uint8_t)key[length >> 1] << 8) | (uint8_t)key[length - 1];
+        }
+        h = map_mix(a ^ seed, b ^ h);
+        return map_mix(h ^ k1, (uint64_t)length ^ seed ^ k0);
+    }
+
+    // Seed for a new map: a random per-process value, advanced and mixed for every map
+    inline uint64_t map_seed()
+    {
+        static const uint64_t base = []() {
+            std::random_device device;
+            return ((uint64_t)device() << 32) ^ device();
+        }();
+        static std::atomic<uint64_t> counter(0);
+        uint64_t count = counter.fetch_add(1, std::memory_order_relaxed);
+        return map_mix(base ^ (count * 0x9E3779B97F4A7C15ULL), 0xD6E8FEB86659FD93ULL) | 1;
+    }
+
+#if SSTR_MAP_SSE2
+    // 16 control bytes; masks have one bit per slot
+    struct map_group
+    {
+        static const uint32_t shift = 0; // Mask bit index to slot index
+
+        __m128i ctrl;
+
+        explicit map_group(const int8_t *pos) : ctrl(_mm_loadu_si128((const __m128i *)pos)) {}
+
+        uint64_t match(uint8_t h2) const
+        {
+            return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8((char)h2), ctrl));
+        }
+        uint64_t match_empty() const
+        {
+            return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(kMapEmpty), ctrl));
+        }
+        uint64_t match_empty_or_deleted() const
+        {
+            return (uint32_t)_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl));
+        }
+    };
+#else
+    // 8 control bytes in a word; masks have the top bit of each matching byte set
+    struct map_group
+    {
+        static const uint32_t shift = 3;
+
+        uint64_t ctrl;
+
+        explicit map_group(const int8_t *pos)
+        {
+#if SSTR_LITTLE_ENDIAN
+            ctrl = sstr_load64((const char *)pos);
+#else
+            ctrl = 0;
+            for (uint32_t i = 0; i < 8; i++)
+            {
+                ctrl |= (uint64_t)(uint8_t)pos[i] << (8 * i);
+            }
+#endif
+        }
+
+        // May report bytes above a real match as false positives; callers compare keys anyway
+        uint64_t match(uint8_t h2) const
+        {
+            const uint64_t lsbs = 0x0101010101010101ULL;
+            uint64_t x = ctrl ^ (lsbs * h2);
+            return (x - lsbs) & ~x & 0x8080808080808080ULL;
+        }
+        uint64_t match_empty() const { return ctrl & ~(ctrl << 6) & 0x8080808080808080ULL; }
+        uint64_t match_empty_or_deleted() const { return ctrl & ~(ctrl << 7) & 0x8080808080808080ULL; }
+    };
+#endif
+
+    // Iterator over the full slots of a StaticStringMap
+    template <typename Slot>
+    class map_iterator
+    {
+    public:
+        map_iterator() : ctrl(NULL), slot(NULL), end(NULL) {}
+        map_iterator(const int8_t *ctrl_, Slot *slot_, const int8_t *end_) : ctrl(ctrl_), slot(slot_), end(end_) { skip_free(); }
+
+        // Allows converting an iterator to a const_iterator
+        template <typename Other>
+        map_iterator(const map_iterator<Other> &other) : ctrl(other.ctrl), slot(other.slot), end(other.end) {}
+
+        Slot &operator*() const { return *slot; }
+        Slot *operator->() const { return slot; }
+        map_iterator &operator++()
+        {
+            ctrl++;
+            slot++;
+            skip_free();
+            return *this;
+        }
+        bool operator==(const map_iterator &other) const { return ctrl == other.ctrl; }
+        bool operator!=(const map_iterator &other) const { return ctrl != other.ctrl; }
+
+    private:
+        template <typename>
+        friend class map_iterator;
+
+        void skip_free()
+        {
+            while (ctrl != end && *ctrl < 0)
+            {
+                ctrl++;
+                slot++;
+            }
+        }
+
+        const int8_t *ctrl;
+        Slot *slot;
+        const int8_t *end;
+    };
+}
+
+template <typename V, uint32_t N = 31>
+class StaticStringMap
+{
+public:
+    typedef BasicStaticString<N> key_type;
+    typedef V mapped_type;
+
+    struct slot_type
+    {
+        key_type key;
+        V value;
+    };
+
+    typedef sstr_detail::map_iterator<slot_type> iterator;
+    typedef sstr_detail::map_iterator<const slot_type> const_iterator;
+
+    StaticStringMap() : slots(NULL), ctrl(NULL), slot_count(0), used(0), growth_left(0), seed(sstr_detail::map_seed()) {}
+    explicit StaticStringMap(uint32_t expected_size) : StaticStringMap() { reserve(expected_size); }
+
+    StaticStringMap(const StaticStringMap &other) : StaticStringMap()
+    {
+        reserve(other.used);
+        for (const_iterator it = other.begin(); it != other.end(); ++it)
+        {
+            insert(it->key, it->value);
+        }
+    }
+
+    StaticStringMap(StaticStringMap &&other) noexcept : StaticStringMap() { swap(other); }
+
+    StaticStringMap &operator=(StaticStringMap other)
+    {
+        swap(other);
+        return *this;
+    }
+
+    ~StaticStringMap()
+    {
+        destroy_values();
+        ::operator delete(slots);
+    }
+
+    void swap(StaticStringMap &other) noexcept
+    {
+        std::swap(slots, other.slots);
+        std::swap(ctrl, other.ctrl);
+        std::swap(slot_count, other.slot_count);
+        std::swap(used, other.used);
+        std::swap(growth_left, other.growth_left);
+        std::swap(seed, other.seed);
+    }
+
+    uint32_t size() const { return used; }
+    uint32_t empty() const { return used == 0; }
+    uint32_t capacity() const { return slot_count; } // Number of slots, of which at most 7/8 are used
+    static uint32_t max_key_length() { return N; }
+
+    /**
+     * @brief Grows the table so that expected_size keys fit without a rehash.
+     *
+     * @return uint32_t 1 if the table was rebuilt, 0 if it was large enough.
+     */
+    uint32_t reserve(uint32_t expected_size)
+    {
+        uint32_t needed = capacity_for(expected_size);
+        if (needed <= slot_count)
+        {
+            return 0;
+        }
+        rehash(needed);
+        return 1;
+    }
+
+    // Removes all keys; the slot array is kept
+    void clear()
+    {
+        destroy_values();
+        if (slot_count != 0)
+        {
+            memset(ctrl, (uint8_t)sstr_detail::kMapEmpty, slot_count + SSTR_MAP_GROUP_WIDTH);
+        }
+        used = 0;
+        growth_left = max_load(slot_count);
+    }
+
+    /**
+     * @brief Looks up a key.
+     *
+     * @return V* Pointer to the value stored for the key, or NULL if absent.
+     */
+    V *find(const char *key, uint32_t key_length) { return find_hashed(key, key_length, hash_of(key, key_length)); }
+    const V *find(const char *key, uint32_t key_length) const
+    {
+        return const_cast<StaticStringMap *>(this)->find(key, key_length);
+    }
+    V *find_cstr(const char *key) { return key == NULL ? NULL : find(key, (uint32_t)strlen(key)); }
+    const V *find_cstr(const char *key) const { return key == NULL ? NULL : find(key, (uint32_t)strlen(key)); }
+
+    template <uint32_t M, typename L, int Y, bool H>
+    V *find(const BasicStaticString<M, L, Y, H> &key)
+    {
+        return find(key.data(), key.length());
+    }
+    template <uint32_t M, typename L, int Y, bool H>
+    const V *find(const BasicStaticString<M, L, Y, H> &key) const
+    {
+        return const_cast<StaticStringMap *>(this)->find(key);
+    }
+    V *find(StaticStringView key) { return find(key.data, key.length); }
+    const V *find(StaticStringView key) const { return find(key.data, key.length); }
+    V *find(const StaticString *key) { return key == NULL ? NULL : find(key->static_string, key->string_length); }
+    const V *find(const StaticString *key) const { return const_cast<StaticStringMap *>(this)->find(key); }
+
+    template <typename K>
+    uint32_t contains(const K &key) const
+    {
+        return find(key) != NULL;
+    }
+    uint32_t contains_cstr(const char *key) const { return find_cstr(key) != NULL; }
+
+    /**
+     * @brief Inserts a key with a value if the key is not present yet.
+     *
+     * @return uint32_t 1 if inserted, 0 if the key was already present (its value
+     *         is left unchanged) or is longer than N characters.
+     */
+    uint32_t insert(const char *key, uint32_t key_length, const V &value)
+    {
+        uint32_t inserted = 0;
+        V *slot_value = find_or_insert_hashed(key, key_length, hash_of(key, key_length), &inserted, value);
+        return slot_value != NULL && inserted;
+    }
+    uint32_t insert(StaticStringView key, const V &value) { return insert(key.data, key.length, value); }
+    uint32_t insert_cstr(const char *key, const V &value) { return key == NULL ? 0 : insert(key, (uint32_t)strlen(key), value); }
+    template <uint32_t M, typename L, int Y, bool H>
+    uint32_t insert(const BasicStaticString<M, L, Y, H> &key, const V &value)
+    {
+        uint32_t inserted = 0;
+        V *slot_value = find_or_insert_hashed(key.data(), key.length(), hash_of(key.data(), key.length()), &inserted, value);
+        return slot_value != NULL && inserted;
+    }
+
+    /**
+     * @brief Inserts a key with a value, or overwrites the value of an existing key.
+     *
+     * @return uint32_t 1 if the value was stored, 0 if the key is longer than N characters.
+     */
+    uint32_t insert_or_assign(const char *key, uint32_t key_length, const V &value)
+    {
+        uint32_t inserted = 0;
+        V *slot_value = find_or_insert_hashed(key, key_length, hash_of(key, key_length), &inserted, value);
+        if (slot_value != NULL && !inserted)
+        {
+            *slot_value = value;
+        }
+        return slot_value != NULL;
+    }
+    uint32_t insert_or_assign_cstr(const char *key, const V &value)
+    {
+        return key == NULL ? 0 : insert_or_assign(key, (uint32_t)strlen(key), value);
+    }
+
+    /**
+     * @brief Returns the value of a key, inserting a value-initialized one if absent.
+     *
+     * @return V* Pointer to the value, or NULL if the key is longer than N characters.
+     */
+    V *find_or_insert(const char *key, uint32_t key_length)
+    {
+        uint32_t inserted = 0;
+        return find_or_insert_hashed(key, key_length, hash_of(key, key_length), &inserted, V());
+    }
+    V *find_or_insert_cstr(const char *key) { return key == NULL ? NULL : find_or_insert(key, (uint32_t)strlen(key)); }
+
+    /**
+     * @brief Removes a key and destroys its value.
+     *
+     * @return uint32_t 1 if the key was removed, 0 if it was not present.
+     */
+    uint32_t erase(const char *key, uint32_t key_length)
+    {
+        uint32_t index = find_index(key, key_length, hash_of(key, key_length));
+        if (index == slot_count)
+        {
+            return 0;
+        }
+        erase_at(index);
+        return 1;
+    }
+    uint32_t erase(StaticStringView key) { return erase(key.data, key.length); }
+    uint32_t erase_cstr(const char *key) { return key == NULL ? 0 : erase(key, (uint32_t)strlen(key)); }
+    template <uint32_t M, typename L, int Y, bool H>
+    uint32_t erase(const BasicStaticString<M, L, Y, H> &key)
+    {
+        uint32_t index = find_index(key.data(), key.length(), hash_of(key.data(), key.length()));
+        if (index == slot_count)
+        {
+            return 0;
+        }
+        erase_at(index);
+        return 1;
+    }
+
+    // Erases the entry at it and returns an iterator to the next entry
+    iterator erase(iterator it)
+    {
+        erase_at((uint32_t)(&*it - slots));
+        return ++it;
+    }
+
+    iterator begin() { return iterator(ctrl, slots, ctrl + slot_count); }
+    iterator end() { return iterator(ctrl + slot_count, slots + slot_count, ctrl + slot_count); }
+    const_iterator begin() const { return const_iterator(ctrl, slots, ctrl + slot_count); }
+    const_iterator end() const { return const_iterator(ctrl + slot_count, slots + slot_count, ctrl + slot_count); }
+
+private:
+    static uint32_t max_load(uint32_t count) { return count - count / 8; }
+
+    // Smallest power-of-two slot count that holds size keys under the 7/8 load limit
+    static uint32_t capacity_for(uint32_t size)
+    {
+        if (size == 0)
+        {
+            return 0;
+        }
+        uint32_t count = sstr_detail::kMapMinCapacity;
+        while (max_load(count) < size)
+        {
+            count *= 2;
+        }
+        return count;
+    }
+
+    uint64_t hash_of(const char *key, uint32_t key_length) const { return sstr_detail::map_hash(key, key_length, seed); }
+    static uint8_t h2_of(uint64_t hash) { return (uint8_t)(hash & 0x7F); }
+
+    void set_ctrl(uint32_t index, int8_t value)
+    {
+        ctrl[index] = value;
+        if (index < SSTR_MAP_GROUP_WIDTH)
+        {
+            ctrl[slot_count + index] = value; // Mirror read by groups that start near the end
+        }
+    }
+
+    // Index of the slot holding key, or slot_count if absent
+    uint32_t find_index(const char *key, uint32_t key_length, uint64_t hash) const
+    {
+        if (slot_count == 0 || key_length > N)
+        {
+            return slot_count;
+        }
+        const uint32_t mask = slot_count - 1;
+        const uint8_t h2 = h2_of(hash);
+        uint32_t pos = (uint32_t)(hash >> 7) & mask;
+        for (uint32_t stride = SSTR_MAP_GROUP_WIDTH;; stride += SSTR_MAP_GROUP_WIDTH)
+        {
+            sstr_detail::map_group group(ctrl + pos);
+            for (uint64_t match = group.match(h2); match != 0; match &= match - 1)
+            {
+                uint32_t index = (pos + (sstr_ctz64(match) >> sstr_detail::map_group::shift)) & mask;
+                const key_type &candidate = slots[index].key;
+                if (candidate.length() == key_length && sstr_core_equals(candidate.data(), key_length, key, key_length))
+                {
+                    return index;
+                }
+            }
+            if (group.match_empty() != 0)
+            {
+                return slot_count;
+            }
+            pos = (pos + stride) & mask; // Triangular probing visits every group of a power-of-two table
+        }
+    }
+
+    V *find_hashed(const char *key, uint32_t key_length, uint64_t hash)
+    {
+        uint32_t index = find_index(key, key_length, hash);
+        return index == slot_count ? NULL : &slots[index].value;
+    }
+
+    // First empty or deleted slot on the probe sequence of hash
+    uint32_t find_free(uint64_t hash) const
+    {
+        const uint32_t mask = slot_count - 1;
+        uint32_t pos = (uint32_t)(hash >> 7) & mask;
+        for (uint32_t stride = SSTR_MAP_GROUP_WIDTH;; stride += SSTR_MAP_GROUP_WIDTH)
+        {
+            uint64_t free = sstr_detail::map_group(ctrl + pos).match_empty_or_deleted();
+            if (free != 0)
+            {
+                return (pos + (sstr_ctz64(free) >> sstr_detail::map_group::shift)) & mask;
+            }
+            pos = (pos + stride) & mask;
+        }
+    }
+
+    V *find_or_insert_hashed(const char *key, uint32_t key_length, uint64_t hash, uint32_t *inserted, const V &value)
+    {
+        if (key_length > N)
+        {
+            return NULL;
+        }
+        uint32_t index = find_index(key, key_length, hash);
+        if (index != slot_count)
+        {
+            return &slots[index].value;
+        }
+        if (slot_count == 0)
+        {
+            rehash(sstr_detail::kMapMinCapacity);
+        }
+        index = find_free(hash);
+        if (growth_left == 0 && ctrl[index] != sstr_detail::kMapDeleted)
+        {
+            // Full: grow, or only drop tombstones when they take up most of the load
+            rehash(used < max_load(slot_count) / 2 ? slot_count : slot_count * 2);
+            index = find_free(hash);
+        }
+        if (ctrl[index] == sstr_detail::kMapEmpty)
+        {
+            growth_left--;
+        }
+        slot_type *slot = &slots[index];
+        new (&slot->key) key_type();
+        slot->key.copy_from(key, key_length);
+        new (&slot->value) V(value);
+        set_ctrl(index, (int8_t)h2_of(hash));
+        used++;
+        *inserted = 1;
+        return &slot->value;
+    }
+
+    void erase_at(uint32_t index)
+    {
+        slots[index].value.~V();
+        slots[index].key.~key_type();
+        used--;
+
+        // A slot can become empty again if no probe window of GROUP_WIDTH slots
+        // through it was ever full; otherwise later keys may have probed past it
+        const uint32_t mask = slot_count - 1;
+        uint64_t empty_after = sstr_detail::map_group(ctrl + index).match_empty();
+        uint64_t empty_before = sstr_detail::map_group(ctrl + ((index - SSTR_MAP_GROUP_WIDTH) & mask)).match_empty();
+        if (empty_after != 0 && empty_before != 0)
+        {
+            uint32_t full_after = sstr_ctz64(empty_after) >> sstr_detail::map_group::shift;
+            uint32_t full_before = SSTR_MAP_GROUP_WIDTH - 1 - (sstr_detail::map_highest_bit(empty_before) >> sstr_detail::map_group::shift);
+            if (full_after + full_before < SSTR_MAP_GROUP_WIDTH)
+            {
+                set_ctrl(index, sstr_detail::kMapEmpty);
+                growth_left++;
+                return;
+            }
+        }
+        set_ctrl(index, sstr_detail::kMapDeleted);
+    }
+
+    void destroy_values()
+    {
+        for (uint32_t i = 0; i < slot_count; i++)
+        {
+            if (ctrl[i] >= 0)
+            {
+                slots[i].value.~V();
+                slots[i].key.~key_type();
+            }
+        }
+    }
+
+    // Moves every entry into a fresh table of new_count slots
+    void rehash(uint32_t new_count)
+    {
+        slot_type *old_slots = slots;
+        int8_t *old_ctrl = ctrl;
+        uint32_t old_count = slot_count;
+
+        void *memory = ::operator new((size_t)new_count * sizeof(slot_type) + new_count + SSTR_MAP_GROUP_WIDTH);
+        slots = (slot_type *)memory;
+        ctrl = (int8_t *)(slots + new_count);
+        slot_count = new_count;
+        memset(ctrl, (uint8_t)sstr_detail::kMapEmpty, new_count + SSTR_MAP_GROUP_WIDTH);
+        growth_left = max_load(new_count) - used;
+
+        for (uint32_t i = 0; i < old_count; i++)
+        {
+            if (old_ctrl[i] < 0)
+            {
+                continue;
+            }
+            slot_type &old_slot = old_slots[i];
+            uint64_t hash = hash_of(old_slot.key.data(), old_slot.key.length());
+            uint32_t index = find_free(hash);
+            new (&slots[index].key) key_type(old_slot.key);
+            new (&slots[index].value) V(std::move(old_slot.value));
+            set_ctrl(index, (int8_t)h2_of(hash));
+            old_slot.value.~V();
+            old_slot.key.~key_type();
+        }
+        ::operator delete(old_slots);
+    }
+
+    static_assert(alignof(slot_type) <= alignof(std::max_align_t), "StaticStringMap values must not be over-aligned");
+
+    slot_type *slots;     // slot_count slots, followed by the control bytes in the same allocation
+    int8_t *ctrl;         // slot_count + SSTR_MAP_GROUP_WIDTH control bytes
+    uint32_t slot_count;  // 0 or a power of two >= kMapMinCapacity
+    uint32_t used;        // Number of full slots
+    uint32_t growth_left; // Empty slots that can still be filled before the next rehash
+    uint64_t seed;        // Key hash seed, see sstr_detail::map_hash()
+};
+
+#endif
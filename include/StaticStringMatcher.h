@@ -0,0 +1,587 @@
+#ifndef STATICSTRINGMATCHER_H
+#define STATICSTRINGMATCHER_H
+
+#include <algorithm>
+#include <vector>
+
+#include "StaticString.h"
+
+/*
+ * ---------------------------------------------------------------------------
+ * StaticStringMatcher
+ *
+ * Finds every occurrence of a set of patterns in one pass over a string.
+ * Patterns are added first, then compile() builds one of two engines:
+ *
+ * - Teddy, for up to SSTR_TEDDY_MAX_PATTERNS patterns on AVX2 and AVX-512BW.
+ *   The patterns are spread over 8 buckets, and their last one to three
+ *   bytes are recorded in nibble tables with one bit per bucket. Two pshufb
+ *   per fingerprint byte flag, for a whole vector of text positions, the
+ *   buckets that may have a pattern ending there; only those candidates are
+ *   compared with the patterns of their buckets.
+ * - Aho-Corasick, for larger sets and CPUs without byte shuffles. It is a
+ *   DFA over the classes of bytes that occur in the patterns, taking one
+ *   table lookup per input byte whatever the number of patterns.
+ *
+ * Both engines report hits in the same order: by end position, then from
+ * the longest pattern to the shortest, then by pattern index. Overlapping
+ * hits are all reported.
+ * ---------------------------------------------------------------------------
+ */
+
+#define SSTR_MATCHER_AUTO 0          // Teddy for small sets on AVX2 and above, Aho-Corasick otherwise
+#define SSTR_MATCHER_TEDDY 1         // Forces Teddy; runs a scalar loop on CPUs without AVX2
+#define SSTR_MATCHER_AHO_CORASICK 2  // Forces Aho-Corasick
+#define SSTR_TEDDY_MAX_PATTERNS 32   // Larger sets share buckets more and produce too many false candidates
+#define SSTR_TEDDY_BUCKETS 8         // One bit per bucket in a byte lane
+#define SSTR_TEDDY_MAX_FINGERPRINT 3 // Pattern bytes, counted from the end, checked before verification
+
+typedef struct
+{
+    uint32_t pattern; // Index of the pattern, in the order it was added
+    uint32_t start;   // Index of the first character of the hit
+    uint32_t end;     // Index one past the last character of the hit
+} StaticStringMatch;
+
+namespace sstr_detail
+{
+    const uint32_t kMatcherNone = 0xFFFFFFFFu; // No state, used for missing trie edges and dictionary links
+}
+
+class StaticStringMatcher
+{
+public:
+    StaticStringMatcher() : engine_kind(0), min_length(0), fingerprint(0), stride(0), match_from(0) {}
+
+    /**
+     * @brief Adds a pattern; its index is the number of patterns added before it.
+     *
+     * The compiled engine is discarded until the next compile(), and views
+     * returned by pattern() are invalidated.
+     *
+     * @return uint32_t 1 if the pattern was added, 0 if it is NULL or empty.
+     */
+    uint32_t add(const char *pattern, uint32_t length)
+    {
+        if (pattern == NULL || length == 0)
+        {
+            return 0;
+        }
+        offsets.push_back((uint32_t)chars.size());
+        lengths.push_back(length);
+        chars.insert(chars.end(), pattern, pattern + length);
+        engine_kind = 0;
+        return 1;
+    }
+    uint32_t add(StaticStringView pattern) { return add(pattern.data, pattern.length); }
+    uint32_t add_cstr(const char *pattern) { return pattern == NULL ? 0 : add(pattern, (uint32_t)strlen(pattern)); }
+    template <uint32_t M, typename L, int Y, bool H>
+    uint32_t add(const BasicStaticString<M, L, Y, H> &pattern)
+    {
+        return add(pattern.data(), pattern.length());
+    }
+
+    uint32_t size() const { return (uint32_t)lengths.size(); }
+    StaticStringView pattern(uint32_t index) const
+    {
+        StaticStringView view = {"", 0};
+        if (index < size())
+        {
+            view.data = chars.data() + offsets[index];
+            view.length = lengths[index];
+        }
+        return view;
+    }
+
+    /**
+     * @brief Builds the search engine for the patterns added so far.
+     *
+     * @param engine SSTR_MATCHER_AUTO, or SSTR_MATCHER_TEDDY or
+     *        SSTR_MATCHER_AHO_CORASICK to choose the engine.
+     *
+     * @return uint32_t The engine built, or 0 if there are no patterns.
+     */
+    uint32_t compile(uint32_t engine = SSTR_MATCHER_AUTO)
+    {
+        engine_kind = 0;
+        if (lengths.empty())
+        {
+            return 0;
+        }
+        min_length = *std::min_element(lengths.begin(), lengths.end());
+        if (engine == SSTR_MATCHER_AUTO)
+        {
+            engine = SSTR_MATCHER_AHO_CORASICK;
+#if SSTR_HAS_X86_KERNELS
+            if (size() <= SSTR_TEDDY_MAX_PATTERNS && sstr_kernels()->level >= SSTR_SIMD_AVX2)
+            {
+                engine = SSTR_MATCHER_TEDDY;
+            }
+#endif
+        }
+        if (engine == SSTR_MATCHER_TEDDY)
+        {
+            build_teddy();
+        }
+        else
+        {
+            engine = SSTR_MATCHER_AHO_CORASICK;
+            build_aho_corasick();
+        }
+        engine_kind = engine;
+        return engine;
+    }
+
+    // SSTR_MATCHER_TEDDY or SSTR_MATCHER_AHO_CORASICK, or 0 if not compiled
+    uint32_t engine() const { return engine_kind; }
+
+    /**
+     * @brief Reports every hit of every pattern in a text.
+     *
+     * on_match is called with a const StaticStringMatch & for each hit, in the
+     * order described above, and returns true to continue or false to stop.
+     *
+     * @return uint32_t The number of hits reported, 0 if the matcher is not compiled.
+     */
+    template <typename Fn>
+    uint32_t scan(const char *text, uint32_t length, Fn on_match) const
+    {
+        if (text == NULL || length < min_length)
+        {
+            return 0;
+        }
+        if (engine_kind == SSTR_MATCHER_TEDDY)
+        {
+            return scan_teddy(text, length, on_match);
+        }
+        if (engine_kind == SSTR_MATCHER_AHO_CORASICK)
+        {
+            return scan_aho_corasick(text, length, on_match);
+        }
+        return 0;
+    }
+    template <typename Fn>
+    uint32_t scan(StaticStringView text, Fn on_match) const
+    {
+        return scan(text.data, text.length, on_match);
+    }
+
+    /**
+     * @brief Collects the hits of every pattern in a text.
+     *
+     * @param matches Array receiving the first max_matches hits; may be NULL if max_matches is 0.
+     *
+     * @return uint32_t The total number of hits, which may exceed max_matches.
+     */
+    uint32_t find_all(const char *text, uint32_t length, StaticStringMatch *matches, uint32_t max_matches) const
+    {
+        uint32_t stored = 0;
+        return scan(text, length, [&](const StaticStringMatch &match) {
+            if (stored < max_matches)
+            {
+                matches[stored++] = match;
+            }
+            return true;
+        });
+    }
+    uint32_t find_all(StaticStringView text, StaticStringMatch *matches, uint32_t max_matches) const
+    {
+        return find_all(text.data, text.length, matches, max_matches);
+    }
+    uint32_t find_all(const StaticString *text, StaticStringMatch *matches, uint32_t max_matches) const
+    {
+        return text == NULL ? 0 : find_all(text->static_string, text->string_length, matches, max_matches);
+    }
+    template <uint32_t M, typename L, int Y, bool H>
+    uint32_t find_all(const BasicStaticString<M, L, Y, H> &text, StaticStringMatch *matches, uint32_t max_matches) const
+    {
+        return find_all(text.data(), text.length(), matches, max_matches);
+    }
+
+    // 1 if any pattern occurs in the text; stops at the first hit
+    uint32_t contains_any(const char *text, uint32_t length) const
+    {
+        return scan(text, length, [](const StaticStringMatch &) { return false; }) != 0;
+    }
+    uint32_t contains_any(StaticStringView text) const { return contains_any(text.data, text.length); }
+    uint32_t contains_any(const StaticString *text) const
+    {
+        return text == NULL ? 0 : contains_any(text->static_string, text->string_length);
+    }
+    template <uint32_t M, typename L, int Y, bool H>
+    uint32_t contains_any(const BasicStaticString<M, L, Y, H> &text) const
+    {
+        return contains_any(text.data(), text.length());
+    }
+
+private:
+    // Reports one hit; returns false if the callback asked to stop
+    template <typename Fn>
+    static bool report(Fn &on_match, uint32_t pattern, uint32_t end, uint32_t length, uint32_t &count)
+    {
+        StaticStringMatch match = {pattern, end - length, end};
+        count++;
+        return on_match(match) ? true : false;
+    }
+
+    /*
+     * Teddy. Patterns are sorted from the longest to the shortest and dealt
+     * to the buckets in that order, so walking the candidate buckets in order
+     * yields the hits at one end position longest first.
+     */
+
+    void build_teddy()
+    {
+        std::vector<uint32_t> order(size());
+        for (uint32_t i = 0; i < size(); i++)
+        {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return lengths[a] > lengths[b]; });
+
+        fingerprint = min_length < SSTR_TEDDY_MAX_FINGERPRINT ? min_length : SSTR_TEDDY_MAX_FINGERPRINT;
+        memset(teddy_low, 0, sizeof(teddy_low));
+        memset(teddy_high, 0, sizeof(teddy_high));
+        bucket_patterns = order;
+        uint32_t per_bucket = (size() + SSTR_TEDDY_BUCKETS - 1) / SSTR_TEDDY_BUCKETS;
+        for (uint32_t bucket = 0; bucket <= SSTR_TEDDY_BUCKETS; bucket++)
+        {
+            bucket_begin[bucket] = std::min(bucket * per_bucket, size());
+        }
+        for (uint32_t bucket = 0; bucket < SSTR_TEDDY_BUCKETS; bucket++)
+        {
+            for (uint32_t i = bucket_begin[bucket]; i < bucket_begin[bucket + 1]; i++)
+            {
+                const char *pattern = chars.data() + offsets[order[i]];
+                uint32_t length = lengths[order[i]];
+                for (uint32_t k = 0; k < fingerprint; k++)
+                {
+                    uint8_t c = (uint8_t)pattern[length - 1 - k];
+                    teddy_low[k][c & 15] |= (uint8_t)(1u << bucket);
+                    teddy_high[k][c >> 4] |= (uint8_t)(1u << bucket);
+                }
+            }
+        }
+    }
+
+    // Buckets that may have a pattern ending at text[end]; end >= fingerprint - 1
+    uint32_t teddy_candidates(const char *text, uint32_t end) const
+    {
+        uint32_t buckets = 0xFF;
+        for (uint32_t k = 0; k < fingerprint; k++)
+        {
+            uint8_t c = (uint8_t)text[end - k];
+            buckets &= teddy_low[k][c & 15] & teddy_high[k][c >> 4];
+        }
+        return buckets;
+    }
+
+    // Compares the patterns of the candidate buckets ending at text[end]
+    template <typename Fn>
+    bool teddy_verify(const char *text, uint32_t end, uint32_t buckets, Fn &on_match, uint32_t &count) const
+    {
+        for (; buckets != 0; buckets &= buckets - 1)
+        {
+            uint32_t bucket = sstr_ctz64(buckets);
+            for (uint32_t i = bucket_begin[bucket]; i < bucket_begin[bucket + 1]; i++)
+            {
+                uint32_t pattern = bucket_patterns[i];
+                uint32_t length = lengths[pattern];
+                if (length <= end + 1 && memcmp(text + end + 1 - length, chars.data() + offsets[pattern], length) == 0 &&
+                    !report(on_match, pattern, end + 1, length, count))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    template <typename Fn>
+    uint32_t scan_teddy(const char *text, uint32_t length, Fn &on_match) const
+    {
+        uint32_t count = 0;
+        uint32_t end = fingerprint - 1;
+#if SSTR_HAS_X86_KERNELS
+        bool stopped = false;
+        int level = sstr_kernels()->level;
+        if (level >= SSTR_SIMD_AVX512BW)
+        {
+            end = fingerprint == 1   ? teddy_avx512bw<1>(text, length, end, on_match, count, stopped)
+                  : fingerprint == 2 ? teddy_avx512bw<2>(text, length, end, on_match, count, stopped)
+                                     : teddy_avx512bw<3>(text, length, end, on_match, count, stopped);
+        }
+        else if (level >= SSTR_SIMD_AVX2)
+        {
+            end = fingerprint == 1   ? teddy_avx2<1>(text, length, end, on_match, count, stopped)
+                  : fingerprint == 2 ? teddy_avx2<2>(text, length, end, on_match, count, stopped)
+                                     : teddy_avx2<3>(text, length, end, on_match, count, stopped);
+        }
+        if (stopped)
+        {
+            return count;
+        }
+#endif
+        for (; end < length; end++)
+        {
+            uint32_t buckets = teddy_candidates(text, end);
+            if (buckets != 0 && !teddy_verify(text, end, buckets, on_match, count))
+            {
+                break;
+            }
+        }
+        return count;
+    }
+
+#if SSTR_HAS_X86_KERNELS
+    // Checks the end positions [end, end + 32) per iteration; returns the first end left to check
+    template <uint32_t F, typename Fn>
+    SSTR_TARGET("avx2,popcnt")
+    uint32_t teddy_avx2(const char *text, uint32_t length, uint32_t end, Fn &on_match, uint32_t &count, bool &stopped) const
+    {
+        const __m256i nibble = _mm256_set1_epi8(0x0F);
+        __m256i low[F], high[F];
+        for (uint32_t k = 0; k < F; k++)
+        {
+            low[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)teddy_low[k]));
+            high[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)teddy_high[k]));
+        }
+        for (; end + 32 <= length; end += 32)
+        {
+            __m256i buckets = _mm256_set1_epi8((char)0xFF);
+            for (uint32_t k = 0; k < F; k++)
+            {
+                // Lane j holds the k-th byte before the end position end + j
+                __m256i v = _mm256_loadu_si256((const __m256i *)(text + end - k));
+                __m256i lo = _mm256_shuffle_epi8(low[k], _mm256_and_si256(v, nibble));
+                __m256i hi = _mm256_shuffle_epi8(high[k], _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+                buckets = _mm256_and_si256(buckets, _mm256_and_si256(lo, hi));
+            }
+            uint32_t mask = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(buckets, _mm256_setzero_si256()));
+            if (mask != 0)
+            {
+                uint8_t lanes[32];
+                _mm256_storeu_si256((__m256i *)lanes, buckets);
+                for (; mask != 0; mask &= mask - 1)
+                {
+                    uint32_t lane = sstr_ctz64(mask);
+                    if (!teddy_verify(text, end + lane, lanes[lane], on_match, count))
+                    {
+                        stopped = true;
+                        return end;
+                    }
+                }
+            }
+        }
+        return end;
+    }
+
+    // Same as teddy_avx2() with 64 end positions per iteration
+    template <uint32_t F, typename Fn>
+    SSTR_TARGET("avx512bw,popcnt")
+    uint32_t teddy_avx512bw(const char *text, uint32_t length, uint32_t end, Fn &on_match, uint32_t &count, bool &stopped) const
+    {
+        const __m512i nibble = _mm512_set1_epi8(0x0F);
+        __m512i low[F], high[F];
+        for (uint32_t k = 0; k < F; k++)
+        {
+            low[k] = sstr_broadcast128_avx512bw(_mm_loadu_si128((const __m128i *)teddy_low[k]));
+            high[k] = sstr_broadcast128_avx512bw(_mm_loadu_si128((const __m128i *)teddy_high[k]));
+        }
+        for (; end + 64 <= length; end += 64)
+        {
+            __m512i buckets = _mm512_set1_epi8((char)0xFF);
+            for (uint32_t k = 0; k < F; k++)
+            {
+                __m512i v = _mm512_loadu_si512((const void *)(text + end - k));
+                __m512i lo = _mm512_shuffle_epi8(low[k], _mm512_and_si512(v, nibble));
+                __m512i hi = _mm512_shuffle_epi8(high[k], _mm512_and_si512(_mm512_srli_epi16(v, 4), nibble));
+                buckets = _mm512_and_si512(buckets, _mm512_and_si512(lo, hi));
+            }
+            uint64_t mask = _mm512_test_epi8_mask(buckets, buckets);
+            if (mask != 0)
+            {
+                uint8_t lanes[64];
+                _mm512_storeu_si512((void *)lanes, buckets);
+                for (; mask != 0; mask &= mask - 1)
+                {
+                    uint32_t lane = sstr_ctz64(mask);
+                    if (!teddy_verify(text, end + lane, lanes[lane], on_match, count))
+                    {
+                        stopped = true;
+                        return end;
+                    }
+                }
+            }
+        }
+        return end;
+    }
+#endif
+
+    /*
+     * Aho-Corasick. Bytes that occur in no pattern share class 0. After the
+     * breadth-first construction every state has a transition for every
+     * class, stored premultiplied by the class count. States that end a
+     * pattern (directly or through a suffix) are numbered last, so one
+     * compare per byte detects a hit.
+     */
+
+    void build_aho_corasick()
+    {
+        uint32_t classes = 1;
+        memset(byte_class, 0, sizeof(byte_class));
+        for (size_t i = 0; i < chars.size(); i++)
+        {
+            uint8_t c = (uint8_t)chars[i];
+            if (byte_class[c] == 0)
+            {
+                byte_class[c] = classes++;
+            }
+        }
+        stride = classes;
+
+        // Trie of the patterns; node 0 is the root
+        std::vector<uint32_t> next(stride, sstr_detail::kMatcherNone);
+        std::vector<uint32_t> node_of(size());
+        for (uint32_t p = 0; p < size(); p++)
+        {
+            uint32_t node = 0;
+            const char *pattern = chars.data() + offsets[p];
+            for (uint32_t i = 0; i < lengths[p]; i++)
+            {
+                uint32_t slot = node * stride + byte_class[(uint8_t)pattern[i]];
+                if (next[slot] == sstr_detail::kMatcherNone)
+                {
+                    next[slot] = (uint32_t)(next.size() / stride);
+                    next.resize(next.size() + stride, sstr_detail::kMatcherNone);
+                }
+                node = next[slot];
+            }
+            node_of[p] = node;
+        }
+        const uint32_t node_count = (uint32_t)(next.size() / stride);
+        std::vector<uint32_t> own(node_count + 1, 0);
+        for (uint32_t p = 0; p < size(); p++)
+        {
+            own[node_of[p]]++;
+        }
+
+        // Breadth-first: failure links, dictionary links and missing transitions
+        std::vector<uint32_t> fail(node_count, 0), dict(node_count, sstr_detail::kMatcherNone), queue;
+        queue.reserve(node_count);
+        queue.push_back(0);
+        for (size_t head = 0; head < queue.size(); head++)
+        {
+            uint32_t node = queue[head];
+            for (uint32_t c = 0; c < stride; c++)
+            {
+                uint32_t child = next[node * stride + c];
+                uint32_t fallback = node == 0 ? 0 : next[fail[node] * stride + c];
+                if (child == sstr_detail::kMatcherNone)
+                {
+                    next[node * stride + c] = fallback;
+                    continue;
+                }
+                fail[child] = fallback;
+                dict[child] = own[fallback] != 0 ? fallback : dict[fallback];
+                queue.push_back(child);
+            }
+        }
+
+        // Renumber: states without hits first, in breadth-first order
+        std::vector<uint32_t> renamed(node_count);
+        uint32_t quiet = 0;
+        for (uint32_t i = 0; i < node_count; i++)
+        {
+            if (own[queue[i]] == 0 && dict[queue[i]] == sstr_detail::kMatcherNone)
+            {
+                renamed[queue[i]] = quiet++;
+            }
+        }
+        uint32_t id = quiet;
+        for (uint32_t i = 0; i < node_count; i++)
+        {
+            if (own[queue[i]] != 0 || dict[queue[i]] != sstr_detail::kMatcherNone)
+            {
+                renamed[queue[i]] = id++;
+            }
+        }
+        match_from = quiet * stride;
+
+        transitions.assign(next.size(), 0);
+        dict_link.assign(node_count, sstr_detail::kMatcherNone);
+        output_begin.assign(node_count + 1, 0);
+        for (uint32_t node = 0; node < node_count; node++)
+        {
+            uint32_t to = renamed[node];
+            for (uint32_t c = 0; c < stride; c++)
+            {
+                transitions[to * stride + c] = renamed[next[node * stride + c]] * stride;
+            }
+            dict_link[to] = dict[node] == sstr_detail::kMatcherNone ? sstr_detail::kMatcherNone : renamed[dict[node]];
+            output_begin[to + 1] = own[node];
+        }
+        for (uint32_t node = 0; node < node_count; node++)
+        {
+            output_begin[node + 1] += output_begin[node];
+        }
+        outputs.assign(size(), 0);
+        std::vector<uint32_t> fill(output_begin.begin(), output_begin.end() - 1);
+        for (uint32_t p = 0; p < size(); p++)
+        {
+            outputs[fill[renamed[node_of[p]]]++] = p; // Ascending pattern index within a state
+        }
+    }
+
+    template <typename Fn>
+    uint32_t scan_aho_corasick(const char *text, uint32_t length, Fn &on_match) const
+    {
+        const uint32_t *delta = transitions.data();
+        uint32_t count = 0;
+        uint32_t state = 0;
+        for (uint32_t i = 0; i < length; i++)
+        {
+            state = delta[state + byte_class[(uint8_t)text[i]]];
+            if (state < match_from)
+            {
+                continue;
+            }
+            // The state's own patterns all have its depth; each dictionary link is shorter
+            for (uint32_t node = state / stride; node != sstr_detail::kMatcherNone; node = dict_link[node])
+            {
+                for (uint32_t o = output_begin[node]; o < output_begin[node + 1]; o++)
+                {
+                    if (!report(on_match, outputs[o], i + 1, lengths[outputs[o]], count))
+                    {
+                        return count;
+                    }
+                }
+            }
+        }
+        return count;
+    }
+
+    std::vector<char> chars;       // Characters of all patterns, back to back
+    std::vector<uint32_t> offsets; // Start of each pattern in chars
+    std::vector<uint32_t> lengths; // Length of each pattern
+    uint32_t engine_kind;          // Engine built by compile(), or 0
+    uint32_t min_length;           // Length of the shortest pattern
+
+    // Teddy
+    uint32_t fingerprint;                                                    // Bytes checked per candidate, min(min_length, 3)
+    uint8_t teddy_low[SSTR_TEDDY_MAX_FINGERPRINT][16];                       // Bit b of [k][c & 15] set if bucket b has byte c k bytes before a pattern end
+    uint8_t teddy_high[SSTR_TEDDY_MAX_FINGERPRINT][16];                      // Same for c >> 4
+    uint32_t bucket_begin[SSTR_TEDDY_BUCKETS + 1];                           // Bucket b holds bucket_patterns[bucket_begin[b] .. bucket_begin[b + 1])
+    std::vector<uint32_t> bucket_patterns;                                   // Pattern indices, longest first
+
+    // Aho-Corasick
+    uint32_t byte_class[256];           // Class of each byte value; 0 for bytes in no pattern
+    uint32_t stride;                    // Number of classes
+    uint32_t match_from;                // Premultiplied states at or above this end a pattern
+    std::vector<uint32_t> transitions;  // [state * stride + class] -> premultiplied next state
+    std::vector<uint32_t> output_begin; // Patterns ending at state s are outputs[output_begin[s] .. output_begin[s + 1])
+    std::vector<uint32_t> outputs;      // Pattern indices
+    std::vector<uint32_t> dict_link;    // Nearest proper suffix state with patterns, or sstr_detail::kMatcherNone
+};
+
+#endif
@@ -64,6 +64,13 @@ int main()
     sstr_reverse(&s1);
     print_static_string(s1, "After sstr_reverse");
 
+    // Per-instance capacity with the C++ template
+    BasicStaticString<8> ticker("MSFT");
+    BasicStaticString<120> line("Ticker: ");
+    line.append_cstr(ticker.to_cstr());
+    cout << "BasicStaticString<8>: \"" << ticker.to_cstr() << "\" (sizeof=" << sizeof(ticker) << ")" << endl;
+    cout << "BasicStaticString<120>: \"" << line.to_cstr() << "\" (sizeof=" << sizeof(line) << ")" << endl;
+
     cout << flush;
     
     getchar();
@@ -0,0 +1,105 @@
+#ifndef STATICSTRING_TEST_H
+#define STATICSTRING_TEST_H
+
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+
+#include "StaticString.h"
+
+/*
+ * Helpers shared by the differential tests. Each test binary is built once
+ * per forced SSTR_SIMD_LEVEL and compares the library against a plain
+ * reference (std::string, std::unordered_map or a brute-force loop). A test
+ * exits with 0 when every check passed, 1 on failures, and 77, which ctest
+ * reports as skipped, when the CPU lacks the level it was built for.
+ */
+
+#define TEST_SKIPPED 77         // Exit code ctest treats as a skipped test
+#define TEST_MAX_REPORTED 20    // Failures printed before the rest are only counted
+
+struct TestState
+{
+    uint64_t checks = 0;
+    uint64_t failures = 0;
+};
+
+inline TestState &test_state()
+{
+    static TestState state;
+    return state;
+}
+
+// Records a failed check; format describes the case so it can be reproduced
+inline void test_fail(const char *file, int line, const char *condition, const char *format, ...)
+{
+    if (++test_state().failures > TEST_MAX_REPORTED)
+    {
+        return;
+    }
+    std::printf("%s:%d: check failed: %s (", file, line, condition);
+    va_list args;
+    va_start(args, format);
+    std::vprintf(format, args);
+    va_end(args);
+    std::printf(")\n");
+}
+
+// Checks a condition; the remaining arguments are a printf description of the case
+#define TEST_CHECK(condition, ...)                                         \
+    do                                                                     \
+    {                                                                      \
+        test_state().checks++;                                             \
+        if (!(condition))                                                  \
+        {                                                                  \
+            test_fail(__FILE__, __LINE__, #condition, __VA_ARGS__);        \
+        }                                                                  \
+    } while (0)
+
+/**
+ * @brief Whether this CPU can run the SIMD level the test was built for.
+ *
+ * Prints a note and returns false when it cannot; main() should then return
+ * TEST_SKIPPED.
+ */
+inline bool test_level_supported(const char *name)
+{
+    static const char *const levels[] = {"scalar", "sse2", "avx2", "avx512bw"};
+    int level = sstr_kernels()->level;
+#if SSTR_HAS_X86_KERNELS
+    if (sstr_cpu_simd_level() < level)
+    {
+        std::printf("%s: skipped, the CPU does not support %s\n", name, levels[level]);
+        return false;
+    }
+#endif
+    std::printf("%s: %s kernels\n", name, levels[level]);
+    return true;
+}
+
+// Prints the totals and returns the exit code for main()
+inline int test_finish(const char *name)
+{
+    std::printf("%s: %llu checks, %llu failed\n", name, (unsigned long long)test_state().checks,
+                (unsigned long long)test_state().failures);
+    return test_state().failures == 0 ? 0 : 1;
+}
+
+// Lengths around every vector width the kernels use, plus a few odd ones
+static const uint32_t kTestLengths[] = {0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 23, 31, 32, 33, 47, 48, 49,
+                                        63, 64, 65, 66, 95, 96, 97, 127, 128, 129, 191, 192, 193, 255, 256, 257};
+
+// Random text over the first alphabet_size characters of alphabet; small alphabets give many partial matches
+inline std::string test_random_text(std::mt19937 &rng, uint32_t length, const char *alphabet, uint32_t alphabet_size)
+{
+    std::string text(length, '\0');
+    for (uint32_t i = 0; i < length; i++)
+    {
+        text[i] = alphabet[rng() % alphabet_size];
+    }
+    return text;
+}
+
+#endif
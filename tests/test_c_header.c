@@ -0,0 +1,66 @@
+#include "StaticString.h"
+
+/*
+ * Compile check: StaticString.h must stay a C header. This file is built as
+ * C11 with warnings as errors, once per SSTR_SIMD_LEVEL and once with the
+ * level chosen through CPUID, and only calls the sstr_* C API. It is compiled,
+ * not run; the behaviour is covered by the C++ tests.
+ */
+
+uint32_t c_header_edit(StaticString *sstr, const StaticString *other)
+{
+    uint32_t truncated = 0;
+    uint32_t result = sstr_from_cstr(sstr, "  Hello, C world  ");
+    result += sstr_append_cstr(sstr, "!");
+    result += sstr_insert(sstr, 2, other);
+    result += sstr_replace_all_cstr(sstr, "l", "L");
+    result += sstr_replace_all_cstr_checked(sstr, "o", "00", &truncated);
+    result += sstr_trim(sstr);
+    result += sstr_strip_class(sstr, sstr_char_class_whitespace());
+    result += sstr_to_uppercase(sstr);
+    result += sstr_from_cstr_lowercase(sstr, "MIXED Case");
+    return result + truncated;
+}
+
+int32_t c_header_search(const StaticString *sstr, const StaticString *needle)
+{
+    StaticStringCharClass vowels;
+    sstr_char_class_init(&vowels, "aeiou");
+    int32_t result = sstr_find(sstr, needle) + sstr_ifind_cstr(sstr, "LL");
+    result += sstr_first_index_of(sstr, 'l') + sstr_last_index_of(sstr, 'l') + sstr_index_of_from(sstr, 'o', 3);
+    result += sstr_find_first_of(sstr, &vowels) + sstr_find_first_not_of(sstr, &vowels);
+    result += (int32_t)(sstr_span(sstr, &vowels) + sstr_cspan(sstr, &vowels) + sstr_contains(sstr, 'l'));
+    result += sstr_icompare(sstr, needle) + (int32_t)sstr_iequals_cstr(sstr, "hello");
+    return result + (int32_t)(sstr_hash(sstr) & 0xFF);
+}
+
+uint32_t c_header_tools(StaticString *sstr)
+{
+    StaticStringTranslation table = sstr_translation_make(",", ";");
+    uint32_t result = sstr_translate(sstr, &table);
+
+    StaticStringSplit split;
+    StaticStringView token;
+    sstr_split_init_any(&split, sstr_view(sstr), ",;");
+    while (sstr_split_next(&split, &token))
+    {
+        result += token.length;
+    }
+
+    StaticStringEdit storage[2];
+    StaticStringEditScript script;
+    sstr_edit_script_init(&script, storage, 2);
+    sstr_edit_script_insert_cstr(&script, 0, "<");
+    sstr_edit_script_replace_cstr(&script, 1, 1, ">");
+    result += sstr_apply_edits(sstr, &script);
+
+    StaticStringGapBuffer gap;
+    if (!sstr_gap_init(&gap, sstr))
+    {
+        return 0;
+    }
+    sstr_gap_set_cursor(&gap, 1);
+    sstr_gap_insert_cstr(&gap, "gap");
+    sstr_gap_backspace(&gap);
+    return result + (sstr_gap_to_cstr(&gap) != NULL);
+}
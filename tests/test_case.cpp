@@ -0,0 +1,234 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "test.h"
+
+/*
+ * ASCII case conversion against a byte-by-byte reference: to_uppercase and
+ * to_lowercase in place, from_cstr_lowercase and from_cstr_uppercase while
+ * copying, at every length around the vector widths and every alignment.
+ * Texts mix letters with the bytes next to the letter ranges ('@', '[', '`',
+ * '{') and bytes above 0x7F, including letters with the top bit set, which
+ * must all be left alone.
+ *
+ * iequals, iequals_cstr and the sign of icompare against folding both strings
+ * to lowercase and comparing bytes as unsigned. The second string differs
+ * from the first in the case of its letters and, often, at one position,
+ * including by 0x20 between bytes that are not letters, like '@' and '`'.
+ */
+
+namespace
+{
+    // Letters, their neighbours and high bytes; no '\0', so the texts are C strings too
+    const char kCaseAlphabet[] = "aAzZmM@[`{\xC1\xE1\xDA\xFA\x80\xFF\x7F 0";
+
+    std::string random_case_text(std::mt19937 &rng, uint32_t length)
+    {
+        std::string text(length, '\0');
+        for (uint32_t i = 0; i < length; i++)
+        {
+            text[i] = rng() % 4 == 0 ? (char)(1 + rng() % 255) : kCaseAlphabet[rng() % (sizeof(kCaseAlphabet) - 1)];
+        }
+        return text;
+    }
+
+    char reference_upper(char ch)
+    {
+        return ch >= 'a' && ch <= 'z' ? (char)(ch - 'a' + 'A') : ch;
+    }
+
+    char reference_lower(char ch)
+    {
+        return ch >= 'A' && ch <= 'Z' ? (char)(ch - 'A' + 'a') : ch;
+    }
+
+    std::string reference_convert(const std::string &text, bool upper)
+    {
+        std::string result = text;
+        std::transform(result.begin(), result.end(), result.begin(), upper ? reference_upper : reference_lower);
+        return result;
+    }
+
+    uint32_t changed_count(const std::string &before, const std::string &after)
+    {
+        uint32_t count = 0;
+        for (size_t i = 0; i < before.size(); i++)
+        {
+            count += before[i] != after[i];
+        }
+        return count;
+    }
+
+    // In place, with lowercase and uppercase letters around the string that must stay as they are
+    void check_in_place(const std::string &text, uint32_t align, bool upper)
+    {
+        std::string expected = reference_convert(text, upper);
+        std::vector<char> buffer(align + text.size() + 64, upper ? 'q' : 'Q');
+        std::copy(text.begin(), text.end(), buffer.begin() + align);
+        char *data = buffer.data() + align;
+        uint32_t length = (uint32_t)text.size();
+        uint32_t count = upper ? sstr_core_to_uppercase(data, length) : sstr_core_to_lowercase(data, length);
+        TEST_CHECK(count == changed_count(text, expected) && std::equal(expected.begin(), expected.end(), data),
+                   "%s: length %u align %u", upper ? "to_uppercase" : "to_lowercase", length, align);
+        char guard = upper ? 'q' : 'Q';
+        TEST_CHECK(std::count(buffer.begin(), buffer.begin() + align, guard) == align &&
+                       std::count(buffer.begin() + align + length, buffer.end(), guard) == 64,
+                   "%s: length %u align %u wrote outside the string", upper ? "to_uppercase" : "to_lowercase", length, align);
+    }
+
+    // Copying from a C string at any alignment into a capacity below, at or above its length; the source continues past its terminator
+    void check_from_cstr(const std::string &text, uint32_t align, uint32_t capacity, bool upper)
+    {
+        std::vector<char> source(align + text.size() + 1 + 64, 'a');
+        std::copy(text.begin(), text.end(), source.begin() + align);
+        source[align + text.size()] = '\0';
+
+        uint32_t kept = std::min((uint32_t)text.size(), capacity);
+        std::string expected = reference_convert(text.substr(0, kept), upper);
+        std::vector<char> dest(capacity + 1 + 64, '#');
+        uint32_t length = 0xFFFFFFFFu;
+        uint32_t truncated = 2;
+        uint32_t result = upper ? sstr_core_from_cstr_uppercase(dest.data(), &length, capacity, source.data() + align, &truncated)
+                                : sstr_core_from_cstr_lowercase(dest.data(), &length, capacity, source.data() + align, &truncated);
+        TEST_CHECK(result == 1 && length == kept && truncated == (uint32_t)(text.size() > capacity) &&
+                       std::equal(expected.begin(), expected.end(), dest.begin()) && dest[kept] == '\0',
+                   "%s: length %u align %u capacity %u", upper ? "from_cstr_uppercase" : "from_cstr_lowercase", (uint32_t)text.size(),
+                   align, capacity);
+        // Whole vectors may be stored up to the capacity, never past the capacity + 1 bytes of the buffer
+        TEST_CHECK(std::count(dest.begin() + capacity + 1, dest.end(), '#') == 64, "%s: length %u capacity %u wrote past the buffer",
+                   upper ? "from_cstr_uppercase" : "from_cstr_lowercase", (uint32_t)text.size(), capacity);
+    }
+
+    void check_conversions(std::mt19937 &rng)
+    {
+        for (size_t l = 0; l < sizeof(kTestLengths) / sizeof(kTestLengths[0]); l++)
+        {
+            uint32_t length = kTestLengths[l];
+            for (uint32_t align = 0; align < 64; align++)
+            {
+                std::string text = random_case_text(rng, length);
+                bool upper = (align & 1) != 0;
+                check_in_place(text, align, upper);
+                uint32_t capacity = align % 3 == 0 ? length : align % 3 == 1 ? length + 1 + rng() % 64 : rng() % (length + 1);
+                check_from_cstr(text, align, capacity, upper);
+            }
+        }
+    }
+
+    int32_t reference_icompare(const std::string &a, const std::string &b)
+    {
+        std::string lower_a = reference_convert(a, false);
+        std::string lower_b = reference_convert(b, false);
+        int order = memcmp(lower_a.data(), lower_b.data(), std::min(a.size(), b.size()));
+        if (order == 0)
+        {
+            return a.size() == b.size() ? 0 : a.size() < b.size() ? -1 : 1;
+        }
+        return order < 0 ? -1 : 1;
+    }
+
+    void check_compare_pair(const std::string &a, const std::string &b, uint32_t align)
+    {
+        std::vector<char> buffer_a(align + a.size() + 1, '\0');
+        std::vector<char> buffer_b(64 - align + b.size() + 1, '\0');
+        std::copy(a.begin(), a.end(), buffer_a.begin() + align);
+        std::copy(b.begin(), b.end(), buffer_b.begin() + (64 - align));
+        const char *data_a = buffer_a.data() + align;
+        const char *data_b = buffer_b.data() + (64 - align);
+        uint32_t length_a = (uint32_t)a.size();
+        uint32_t length_b = (uint32_t)b.size();
+
+        int32_t expected = reference_icompare(a, b);
+        TEST_CHECK(sstr_core_icompare(data_a, length_a, data_b, length_b) == expected &&
+                       sstr_core_icompare(data_b, length_b, data_a, length_a) == -expected,
+                   "icompare: lengths %u and %u align %u, expected %d", length_a, length_b, align, expected);
+        TEST_CHECK(sstr_core_iequals(data_a, length_a, data_b, length_b) == (uint32_t)(expected == 0),
+                   "iequals: lengths %u and %u align %u", length_a, length_b, align);
+        TEST_CHECK(sstr_core_iequals_cstr(data_a, length_a, data_b) == (uint32_t)(expected == 0),
+                   "iequals_cstr: lengths %u and %u align %u", length_a, length_b, align);
+    }
+
+    void check_compare(std::mt19937 &rng)
+    {
+        const char kNotLetters[] = "@`[{\xC1\xE1\xDA\xFA";
+        for (size_t l = 0; l < sizeof(kTestLengths) / sizeof(kTestLengths[0]); l++)
+        {
+            uint32_t length = kTestLengths[l];
+            for (uint32_t align = 0; align < 64; align++)
+            {
+                std::string a = random_case_text(rng, length);
+                std::string b = a;
+                for (uint32_t i = 0; i < length; i++)
+                {
+                    if (((b[i] | 0x20) >= 'a' && (b[i] | 0x20) <= 'z') && rng() % 2 == 0)
+                    {
+                        b[i] ^= 0x20;
+                    }
+                }
+                // Equal ignoring case, one byte changed, one byte off by 0x20 without being a letter, or a prefix
+                uint32_t kind = align % 4;
+                uint32_t position = length == 0 ? 0 : rng() % length;
+                if (kind == 1 && length > 0)
+                {
+                    b[position] = random_case_text(rng, 1)[0];
+                }
+                else if (kind == 2 && length > 0)
+                {
+                    a[position] = kNotLetters[rng() % (sizeof(kNotLetters) - 1)];
+                    b[position] = (char)(a[position] ^ 0x20);
+                }
+                else if (kind == 3)
+                {
+                    b.resize(position);
+                }
+                check_compare_pair(a, b, align);
+            }
+        }
+    }
+
+    // The StaticString functions, every byte value, and NULL
+    void check_edges()
+    {
+        static StaticString sstr;
+        std::string bytes;
+        for (uint32_t c = 1; c < 256; c++)
+        {
+            bytes += (char)c;
+        }
+        sstr_from_cstr(&sstr, bytes.c_str());
+        TEST_CHECK(sstr_to_uppercase(&sstr) == 26 && sstr.static_string == reference_convert(bytes, true), "every byte to uppercase");
+        TEST_CHECK(sstr_to_lowercase(&sstr) == 52 && sstr.static_string == reference_convert(bytes, false), "every byte to lowercase");
+        TEST_CHECK(sstr_from_cstr_uppercase(&sstr, bytes.c_str()) == 1 && sstr.string_length == 255 &&
+                       sstr.static_string == reference_convert(bytes, true),
+                   "every byte through from_cstr_uppercase");
+        TEST_CHECK(sstr_from_cstr_lowercase(&sstr, "Hello, World@[`{") == 1 && strcmp(sstr.static_string, "hello, world@[`{") == 0,
+                   "from_cstr_lowercase");
+        TEST_CHECK(sstr_to_uppercase(NULL) == 0 && sstr_to_lowercase(NULL) == 0 && sstr_from_cstr_uppercase(NULL, "a") == 0 &&
+                       sstr_from_cstr_lowercase(&sstr, NULL) == 0,
+                   "NULL pointers");
+
+        static StaticString other;
+        sstr_from_cstr(&sstr, "Hello@World");
+        sstr_from_cstr(&other, "hELLO`world");
+        TEST_CHECK(sstr_iequals(&sstr, &other) == 0 && sstr_icompare(&sstr, &other) == -1 && sstr_icompare(&other, &sstr) == 1,
+                   "'@' and '`' differ by case bit only");
+        sstr_from_cstr(&other, "hELLO@wORLD");
+        TEST_CHECK(sstr_iequals(&sstr, &other) == 1 && sstr_icompare(&sstr, &other) == 0 && sstr_iequals_cstr(&sstr, "HELLO@WORLD") == 1 &&
+                       sstr_iequals_cstr(&sstr, "HELLO@WORL") == 0,
+                   "equal ignoring case");
+    }
+}
+
+int main()
+{
+    if (!test_level_supported("case"))
+    {
+        return TEST_SKIPPED;
+    }
+    std::mt19937 rng(19);
+    check_edges();
+    check_conversions(rng);
+    check_compare(rng);
+    return test_finish("case");
+}
@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "test.h"
+
+/*
+ * Single-character search against std::string: first_index_of,
+ * last_index_of, index_of_from and the count behind sstr_contains at every
+ * length around the vector widths and every alignment. The bytes around the
+ * string are the searched character, so a masked or overlapping tail that
+ * reads outside the string reports a hit it must not.
+ */
+
+namespace
+{
+    int32_t reference_result(size_t index)
+    {
+        return index == std::string::npos ? -1 : (int32_t)index;
+    }
+
+    void check_text(const std::string &text, const std::vector<char> &buffer, uint32_t align, char ch)
+    {
+        const SStrKernels *kernels = sstr_kernels();
+        const char *data = buffer.data() + align;
+        uint32_t length = (uint32_t)text.size();
+        uint32_t c = (uint8_t)ch;
+
+        int32_t first = reference_result(text.find(ch));
+        int32_t last = reference_result(text.rfind(ch));
+        TEST_CHECK(sstr_core_first_index_of(data, length, ch) == first &&
+                       kernels->find_char(data, length, ch) == (first < 0 ? length : (uint32_t)first),
+                   "first 0x%02X in length %u align %u", c, length, align);
+        TEST_CHECK(sstr_core_last_index_of(data, length, ch) == last &&
+                       kernels->find_char_reverse(data, length, ch) == (last < 0 ? length : (uint32_t)last),
+                   "last 0x%02X in length %u align %u", c, length, align);
+        TEST_CHECK(sstr_core_contains(data, length, ch) == (uint32_t)std::count(text.begin(), text.end(), ch),
+                   "count 0x%02X in length %u align %u", c, length, align);
+
+        uint32_t step = length < 70 ? 1 : length / 23;
+        for (uint32_t start = 0; start <= length + 2; start += step)
+        {
+            int32_t expected = start >= length ? -1 : reference_result(text.find(ch, start));
+            TEST_CHECK(sstr_core_index_of_from(data, length, ch, start) == expected, "0x%02X from %u in length %u align %u", c, start,
+                       length, align);
+        }
+    }
+
+    void check_lengths(std::mt19937 &rng)
+    {
+        const char targets[] = {'x', '\0', (char)0x80, (char)0xFF};
+        for (size_t l = 0; l < sizeof(kTestLengths) / sizeof(kTestLengths[0]); l++)
+        {
+            uint32_t length = kTestLengths[l];
+            for (uint32_t align = 0; align < 64; align++)
+            {
+                char ch = targets[(l + align) % 4];
+                std::string text = test_random_text(rng, length, "abcd", 4);
+                // No hit, one hit, a hit at either end, or many
+                uint32_t kind = rng() % 5;
+                if (length > 0 && kind == 1)
+                {
+                    text[rng() % length] = ch;
+                }
+                else if (length > 0 && kind == 2)
+                {
+                    text[0] = ch;
+                    text[length - 1] = ch;
+                }
+                else if (kind == 3)
+                {
+                    for (uint32_t i = 0; i < length; i += 1 + rng() % 9)
+                    {
+                        text[i] = ch;
+                    }
+                }
+
+                std::vector<char> buffer(align + length + 64, ch);
+                std::copy(text.begin(), text.end(), buffer.begin() + align);
+                check_text(text, buffer, align, ch);
+                check_text(text, buffer, align, 'a');
+            }
+        }
+    }
+
+    // The StaticString functions on the empty string, past the end and with NULL
+    void check_edges()
+    {
+        static StaticString sstr;
+        sstr_init(&sstr);
+        TEST_CHECK(sstr_first_index_of(&sstr, 'a') == -1 && sstr_last_index_of(&sstr, 'a') == -1 &&
+                       sstr_index_of_from(&sstr, 'a', 0) == -1 && sstr_contains(&sstr, 'a') == 0,
+                   "empty string");
+        TEST_CHECK(sstr_last_index_of(&sstr, '\0') == -1 && sstr_first_index_of(&sstr, '\0') == -1, "terminator of the empty string");
+        sstr_from_cstr(&sstr, "abcabc");
+        TEST_CHECK(sstr_last_index_of(&sstr, 'a') == 3 && sstr_index_of_from(&sstr, 'a', 1) == 3 && sstr_index_of_from(&sstr, 'c', 5) == 5,
+                   "\"abcabc\"");
+        TEST_CHECK(sstr_index_of_from(&sstr, 'a', 6) == -1 && sstr_index_of_from(&sstr, 'a', 7) == -1 &&
+                       sstr_index_of_from(&sstr, 'a', 0xFFFFFFFFu) == -1,
+                   "start past the end");
+        TEST_CHECK(sstr_last_index_of(&sstr, 'z') == -1 && sstr_contains(&sstr, 'b') == 2, "absent and repeated characters");
+        TEST_CHECK(sstr_first_index_of(NULL, 'a') == -1 && sstr_last_index_of(NULL, 'a') == -1 &&
+                       sstr_index_of_from(NULL, 'a', 0) == -1 && sstr_contains(NULL, 'a') == 0,
+                   "NULL string");
+    }
+}
+
+int main()
+{
+    if (!test_level_supported("chars"))
+    {
+        return TEST_SKIPPED;
+    }
+    std::mt19937 rng(21);
+    check_edges();
+    check_lengths(rng);
+    return test_finish("chars");
+}
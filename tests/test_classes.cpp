@@ -0,0 +1,260 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "test.h"
+
+/*
+ * Character class search against std::string::find_first_of and
+ * find_first_not_of: find_first_of, find_first_not_of, span and cspan, plus
+ * the span_class_reverse and class_mask kernels, at every length around the
+ * vector widths and every alignment. Classes mix bytes below and above 0x80,
+ * so both nibble tables are read, and some share low nibbles across the two
+ * halves. The bytes around the string extend the run being measured, so a
+ * tail that reads outside the string reports a result it must not.
+ *
+ * sstr_strip_class and sstr_strip_all_whitespace, through the compact_class
+ * kernels, against erasing the class members from a std::string: strings
+ * made only of members, with none, and with every density in between, at
+ * lengths that end in a partial vector.
+ */
+
+namespace
+{
+    struct TestClass
+    {
+        std::string members;    // Every byte in the class, once
+        std::string complement; // Every byte outside it
+        StaticStringCharClass cls;
+    };
+
+    TestClass make_class(const std::vector<uint32_t> &bytes)
+    {
+        TestClass result;
+        sstr_char_class_init(&result.cls, NULL);
+        for (size_t i = 0; i < bytes.size(); i++)
+        {
+            sstr_char_class_add(&result.cls, (char)bytes[i]);
+        }
+        for (uint32_t c = 0; c < 256; c++)
+        {
+            (sstr_char_class_contains(&result.cls, (char)c) ? result.members : result.complement) += (char)c;
+        }
+        return result;
+    }
+
+    TestClass make_range_class(uint32_t first, uint32_t last)
+    {
+        std::vector<uint32_t> bytes;
+        for (uint32_t c = first; c <= last; c++)
+        {
+            bytes.push_back(c);
+        }
+        return make_class(bytes);
+    }
+
+    std::vector<TestClass> test_classes(std::mt19937 &rng)
+    {
+        std::vector<TestClass> classes;
+        classes.push_back(make_class(std::vector<uint32_t>(1, ',')));
+        classes.push_back(make_class(std::vector<uint32_t>(1, 0xFF)));
+        classes.push_back(make_class({' ', '\t', '\n', '\r'}));
+        classes.push_back(make_range_class('a', 'z'));
+        classes.push_back(make_range_class(0x80, 0xFF));
+        classes.push_back(make_class({0x00, 0x0A, 0x8A, 0x3A, 0xBA, 0x7F, 0xF0})); // The same low nibbles in both tables
+        classes.push_back(make_class({0x8A}));                                     // Only in the upper table, a low nibble 0x0A misses
+        classes.push_back(make_class(std::vector<uint32_t>()));
+        classes.push_back(make_range_class(0x00, 0xFF));
+        for (uint32_t i = 0; i < 6; i++)
+        {
+            std::vector<uint32_t> bytes;
+            for (uint32_t count = 1 + rng() % (i < 3 ? 8 : 200); count > 0; count--)
+            {
+                bytes.push_back(rng() % 256);
+            }
+            classes.push_back(make_class(bytes));
+        }
+        return classes;
+    }
+
+    // A random byte of set, or of every byte value when set is empty
+    char random_byte(std::mt19937 &rng, const std::string &set)
+    {
+        return set.empty() ? (char)(rng() % 256) : set[rng() % set.size()];
+    }
+
+    uint32_t reference_index(size_t index, uint32_t length)
+    {
+        return index == std::string::npos ? length : (uint32_t)index;
+    }
+
+    void check_text(const TestClass &test, const std::string &text, const std::vector<char> &buffer, uint32_t align, uint32_t c)
+    {
+        const SStrKernels *kernels = sstr_kernels();
+        const StaticStringCharClass *cls = &test.cls;
+        const char *data = buffer.data() + align;
+        uint32_t length = (uint32_t)text.size();
+
+        uint32_t first_of = reference_index(text.find_first_of(test.members), length);
+        uint32_t first_not_of = reference_index(text.find_first_not_of(test.members), length);
+        size_t last_not_of = text.find_last_not_of(test.members);
+        uint32_t trailing = last_not_of == std::string::npos ? length : length - 1 - (uint32_t)last_not_of;
+
+        TEST_CHECK(sstr_core_cspan(data, length, cls) == first_of &&
+                       sstr_core_find_first_of(data, length, cls) == (first_of < length ? (int32_t)first_of : -1),
+                   "class %u: first of in length %u align %u", c, length, align);
+        TEST_CHECK(sstr_core_span(data, length, cls) == first_not_of &&
+                       sstr_core_find_first_not_of(data, length, cls) == (first_not_of < length ? (int32_t)first_not_of : -1),
+                   "class %u: first not of in length %u align %u", c, length, align);
+        TEST_CHECK(kernels->span_class_reverse(data, length, cls) == trailing, "class %u: trailing span in length %u align %u", c, length,
+                   align);
+
+        uint64_t expected_mask = 0;
+        for (uint32_t i = 0; i < length && i < 64; i++)
+        {
+            expected_mask |= (uint64_t)sstr_char_class_contains(cls, text[i]) << i;
+        }
+        TEST_CHECK(kernels->class_mask(data, length, cls) == expected_mask, "class %u: mask in length %u align %u", c, length, align);
+    }
+
+    /**
+     * @brief Runs of one side of the class broken by a byte of the other.
+     *
+     * The string starts and ends with runs of fill bytes whose lengths fall
+     * anywhere in the string, with the other side in between, and the buffer
+     * around it holds fill bytes too.
+     */
+    void check_lengths(std::mt19937 &rng, const std::vector<TestClass> &classes)
+    {
+        for (uint32_t c = 0; c < classes.size(); c++)
+        {
+            const TestClass &test = classes[c];
+            for (size_t l = 0; l < sizeof(kTestLengths) / sizeof(kTestLengths[0]); l++)
+            {
+                uint32_t length = kTestLengths[l];
+                for (uint32_t align = 0; align < 64; align++)
+                {
+                    bool inside = (align & 1) == 0;
+                    const std::string &fill = inside ? test.members : test.complement;
+                    const std::string &other = inside ? test.complement : test.members;
+
+                    uint32_t head = rng() % (length + 1);
+                    uint32_t tail = rng() % (length - head + 1);
+                    std::string text(length, '\0');
+                    for (uint32_t i = 0; i < length; i++)
+                    {
+                        bool mixed = i >= head && i < length - tail;
+                        text[i] = random_byte(rng, mixed && rng() % 4 == 0 ? other : fill);
+                    }
+                    if (head < length && !other.empty())
+                    {
+                        text[head] = random_byte(rng, other);
+                    }
+
+                    std::vector<char> buffer(align + length + 64, random_byte(rng, fill));
+                    std::copy(text.begin(), text.end(), buffer.begin() + align);
+                    check_text(test, text, buffer, align, c);
+                }
+            }
+        }
+    }
+
+    // The kept bytes in order, the terminator after them, and nothing written past the original terminator
+    void check_strip_text(const TestClass &test, const std::string &text, uint32_t c)
+    {
+        std::string expected = text;
+        expected.erase(std::remove_if(expected.begin(), expected.end(),
+                                      [&](char ch) { return sstr_char_class_contains(&test.cls, ch) != 0; }),
+                       expected.end());
+
+        std::vector<char> buffer(text.begin(), text.end());
+        buffer.resize(text.size() + 1 + 64, '#');
+        buffer[text.size()] = '\0';
+        uint32_t length = (uint32_t)text.size();
+        uint32_t removed = sstr_core_strip_class(buffer.data(), &length, &test.cls);
+        TEST_CHECK(removed == text.size() - expected.size() && length == expected.size() &&
+                       std::equal(expected.begin(), expected.end(), buffer.begin()) && buffer[length] == '\0',
+                   "class %u: strip in length %u, %u kept", c, (uint32_t)text.size(), (uint32_t)expected.size());
+        TEST_CHECK(std::count(buffer.begin() + text.size() + 1, buffer.end(), '#') == 64, "class %u: strip in length %u wrote past the end",
+                   c, (uint32_t)text.size());
+    }
+
+    void check_strip(std::mt19937 &rng, const std::vector<TestClass> &classes)
+    {
+        static StaticString sstr;
+        for (uint32_t c = 0; c < classes.size(); c++)
+        {
+            const TestClass &test = classes[c];
+            for (size_t l = 0; l < sizeof(kTestLengths) / sizeof(kTestLengths[0]); l++)
+            {
+                uint32_t length = kTestLengths[l];
+                for (uint32_t round = 0; round < 12; round++)
+                {
+                    // Only members, no members, then members at random densities
+                    uint32_t percent = round == 0 ? 100 : round == 1 ? 0 : rng() % 101;
+                    std::string text(length, '\0');
+                    for (uint32_t i = 0; i < length; i++)
+                    {
+                        text[i] = random_byte(rng, rng() % 100 < percent ? test.members : test.complement);
+                    }
+                    check_strip_text(test, text, c);
+                }
+            }
+        }
+
+        // The StaticString functions, with the whitespace class spelled out in the header
+        StaticStringCharClass whitespace = sstr_char_class_make(SSTR_WHITESPACE_CHARS);
+        TEST_CHECK(memcmp(&whitespace, sstr_char_class_whitespace(), sizeof(whitespace)) == 0, "whitespace class");
+        for (uint32_t length = 0; length <= SSTR_MAX_LENGTH; length += 1 + length / 16)
+        {
+            std::string text = test_random_text(rng, length, " \t\n\rab\x80\xA0\x89", 9);
+            std::string expected = text;
+            expected.erase(std::remove_if(expected.begin(), expected.end(), [](char ch) { return IS_WHITESPACE(ch); }), expected.end());
+            StaticStringView view = {text.data(), length};
+            sstr_from_view(&sstr, view);
+            TEST_CHECK(sstr_strip_all_whitespace(&sstr) == length - expected.size() && sstr.string_length == expected.size() &&
+                           memcmp(sstr.static_string, expected.data(), expected.size()) == 0 && sstr.static_string[expected.size()] == '\0',
+                       "strip_all_whitespace in length %u", length);
+            sstr_from_view(&sstr, view);
+            TEST_CHECK(sstr_strip_class(&sstr, &whitespace) == length - expected.size() && sstr.string_length == expected.size() &&
+                           memcmp(sstr.static_string, expected.data(), expected.size()) == 0,
+                       "strip_class in length %u", length);
+        }
+        TEST_CHECK(sstr_strip_class(NULL, &whitespace) == 0 && sstr_strip_class(&sstr, NULL) == 0 && sstr_strip_all_whitespace(NULL) == 0,
+                   "NULL pointers");
+    }
+
+    // The StaticString functions on the empty string, a whole string inside the class and NULL
+    void check_edges()
+    {
+        static StaticString sstr;
+        StaticStringCharClass vowels = sstr_char_class_make("aeiou");
+        sstr_init(&sstr);
+        TEST_CHECK(sstr_find_first_of(&sstr, &vowels) == -1 && sstr_find_first_not_of(&sstr, &vowels) == -1 &&
+                       sstr_span(&sstr, &vowels) == 0 && sstr_cspan(&sstr, &vowels) == 0,
+                   "empty string");
+        sstr_from_cstr(&sstr, "queue");
+        TEST_CHECK(sstr_find_first_of(&sstr, &vowels) == 1 && sstr_find_first_not_of(&sstr, &vowels) == 0 &&
+                       sstr_span(&sstr, &vowels) == 0 && sstr_cspan(&sstr, &vowels) == 1,
+                   "\"queue\"");
+        sstr_from_cstr(&sstr, "eau");
+        TEST_CHECK(sstr_find_first_not_of(&sstr, &vowels) == -1 && sstr_span(&sstr, &vowels) == 3, "string inside the class");
+        TEST_CHECK(sstr_find_first_of(NULL, &vowels) == -1 && sstr_find_first_not_of(&sstr, NULL) == -1 && sstr_span(NULL, &vowels) == 0 &&
+                       sstr_cspan(&sstr, NULL) == 0,
+                   "NULL pointers");
+    }
+}
+
+int main()
+{
+    if (!test_level_supported("classes"))
+    {
+        return TEST_SKIPPED;
+    }
+    std::mt19937 rng(22);
+    check_edges();
+    std::vector<TestClass> classes = test_classes(rng);
+    check_lengths(rng, classes);
+    check_strip(rng, classes);
+    return test_finish("classes");
+}
@@ -0,0 +1,292 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "test.h"
+
+/*
+ * The memmove-based edits against std::string: splice (insert and
+ * replace_range) with the source outside the string and at every overlap with
+ * it, single-character inserts and removals, range removal and trimming, with
+ * lengths around every vector width and results that exactly fill or
+ * overflow the capacity. Edit scripts are checked against applying their
+ * edits one at a time.
+ */
+
+namespace
+{
+    // A core buffer of capacity + 1 bytes next to its expected contents
+    struct Buffer
+    {
+        std::vector<char> data;
+        uint32_t length;
+        uint32_t capacity;
+
+        Buffer(const std::string &text, uint32_t capacity_) : data(capacity_ + 1, '#'), length((uint32_t)text.size()), capacity(capacity_)
+        {
+            text.copy(data.data(), text.size());
+            data[length] = '\0';
+        }
+
+        std::string str() const { return std::string(data.data(), length); }
+        bool terminated() const { return data[length] == '\0'; }
+    };
+
+    // Every index, count, source offset and source length of short strings, so every overlap case of the splice is hit
+    void check_splice_aliasing()
+    {
+        for (uint32_t length = 0; length <= 12; length++)
+        {
+            std::string text;
+            for (uint32_t i = 0; i < length; i++)
+            {
+                text += (char)('a' + i);
+            }
+            for (uint32_t index = 0; index <= length; index++)
+            {
+                for (uint32_t count = 0; index + count <= length; count++)
+                {
+                    for (uint32_t offset = 0; offset <= length; offset++)
+                    {
+                        for (uint32_t src_length = 0; offset + src_length <= length; src_length++)
+                        {
+                            std::string expected = text.substr(0, index) + text.substr(offset, src_length) + text.substr(index + count);
+                            const uint32_t capacities[] = {(uint32_t)expected.size(), (uint32_t)expected.size() + 7};
+                            for (uint32_t c = 0; c < 2; c++)
+                            {
+                                uint32_t capacity = capacities[c] < length ? length : capacities[c];
+                                Buffer buffer(text, capacity);
+                                uint32_t fits = expected.size() <= capacity;
+                                uint32_t result = sstr_core_splice(buffer.data.data(), &buffer.length, capacity, index, count,
+                                                                   buffer.data.data() + offset, src_length);
+                                TEST_CHECK(result == fits && buffer.str() == (fits ? expected : text) && buffer.terminated(),
+                                           "\"%s\" splice index %u count %u offset %u length %u capacity %u", text.c_str(), index, count,
+                                           offset, src_length, capacity);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    std::string random_source(std::mt19937 &rng, const std::string &text, bool *aliased, uint32_t *offset)
+    {
+        *aliased = !text.empty() && rng() % 2 == 0;
+        if (*aliased)
+        {
+            *offset = rng() % (uint32_t)text.size();
+            return text.substr(*offset, rng() % (text.size() - *offset + 1));
+        }
+        return test_random_text(rng, rng() % 140, "xyz", 3);
+    }
+
+    // Random edit sequences over long strings, applied to a core buffer and to std::string side by side
+    void check_random_edits(std::mt19937 &rng)
+    {
+        const uint32_t capacities[] = {64, 65, 128, 300};
+        for (uint32_t round = 0; round < 400; round++)
+        {
+            uint32_t capacity = capacities[round % 4];
+            uint32_t start_length = kTestLengths[round % (sizeof(kTestLengths) / sizeof(kTestLengths[0]))];
+            std::string expected = test_random_text(rng, start_length < capacity ? start_length : capacity, "abcd \t", 6);
+            Buffer buffer(expected, capacity);
+            for (uint32_t step = 0; step < 40; step++)
+            {
+                std::string before = expected;
+                uint32_t length = (uint32_t)expected.size();
+                uint32_t op = rng() % 7;
+                uint32_t result = 0;
+                uint32_t wanted = 0;
+                if (op <= 1)
+                {
+                    // insert, from outside the string or from a range inside it
+                    bool aliased;
+                    uint32_t offset = 0;
+                    std::string src = random_source(rng, expected, &aliased, &offset);
+                    uint32_t index = rng() % (length + 1);
+                    const char *from = aliased ? buffer.data.data() + offset : src.data();
+                    result = sstr_core_insert(buffer.data.data(), &buffer.length, capacity, index, from, (uint32_t)src.size());
+                    wanted = length + src.size() <= capacity;
+                    if (wanted)
+                    {
+                        expected.insert(index, src);
+                    }
+                }
+                else if (op == 2 && length > 0)
+                {
+                    bool aliased;
+                    uint32_t offset = 0;
+                    std::string src = random_source(rng, expected, &aliased, &offset);
+                    uint32_t start = rng() % length;
+                    uint32_t end = start + rng() % (length - start);
+                    const char *from = aliased ? buffer.data.data() + offset : src.data();
+                    result = sstr_core_replace_range(buffer.data.data(), &buffer.length, capacity, start, end, from, (uint32_t)src.size());
+                    wanted = length - (end - start + 1) + src.size() <= capacity;
+                    if (wanted)
+                    {
+                        expected.replace(start, end - start + 1, src);
+                    }
+                }
+                else if (op == 3)
+                {
+                    uint32_t index = rng() % (length + 2); // Sometimes out of bounds
+                    result = sstr_core_insert_char_at(buffer.data.data(), &buffer.length, capacity, index, 'q') != 0;
+                    wanted = index <= length && length < capacity;
+                    if (wanted)
+                    {
+                        expected.insert(expected.begin() + index, 'q');
+                    }
+                }
+                else if (op == 4 && length > 0)
+                {
+                    uint32_t start = rng() % length;
+                    uint32_t end = start + rng() % (length - start);
+                    result = sstr_core_remove_range(buffer.data.data(), &buffer.length, start, end) == length - (end - start + 1);
+                    wanted = 1;
+                    expected.erase(start, end - start + 1);
+                }
+                else if (op == 5 && length > 0)
+                {
+                    uint32_t index = rng() % length;
+                    result = sstr_core_remove_at(buffer.data.data(), &buffer.length, index) == length - 1;
+                    wanted = 1;
+                    expected.erase(index, 1);
+                }
+                else
+                {
+                    uint32_t which = rng() % 3;
+                    size_t first = expected.find_first_not_of(SSTR_WHITESPACE_CHARS);
+                    size_t last = expected.find_last_not_of(SSTR_WHITESPACE_CHARS);
+                    uint32_t removed;
+                    if (which == 0)
+                    {
+                        removed = sstr_core_trim_leading(buffer.data.data(), &buffer.length);
+                        expected = first == std::string::npos ? "" : expected.substr(first);
+                    }
+                    else if (which == 1)
+                    {
+                        removed = sstr_core_trim_trailing(buffer.data.data(), &buffer.length);
+                        expected = last == std::string::npos ? "" : expected.substr(0, last + 1);
+                    }
+                    else
+                    {
+                        removed = sstr_core_trim(buffer.data.data(), &buffer.length);
+                        expected = first == std::string::npos ? "" : expected.substr(first, last - first + 1);
+                    }
+                    result = removed == length - expected.size();
+                    wanted = 1;
+                }
+                TEST_CHECK(result == wanted && buffer.str() == expected && buffer.terminated(), "round %u step %u op %u on \"%s\"", round,
+                           step, op, before.c_str());
+                if (buffer.str() != expected)
+                {
+                    break; // Later steps would only repeat the same failure
+                }
+                if (expected.size() + 16 > capacity && rng() % 4 == 0)
+                {
+                    // Stay near the capacity limit without sticking to it
+                    expected.erase(0, expected.size() / 2);
+                    buffer = Buffer(expected, capacity);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Applies an edit script to a copy of text the slow way.
+     *
+     * Walks the edits in offset order, keeping queued order at equal offsets,
+     * and copies the kept characters and insertions one edit at a time.
+     *
+     * @return bool false if the edits overlap or fall outside the text.
+     */
+    bool reference_apply(const std::string &text, std::vector<StaticStringEdit> edits, std::string *out)
+    {
+        std::stable_sort(edits.begin(), edits.end(),
+                         [](const StaticStringEdit &a, const StaticStringEdit &b) { return a.offset < b.offset; });
+        std::string result;
+        size_t position = 0;
+        for (size_t i = 0; i < edits.size(); i++)
+        {
+            if (edits[i].offset < position || (size_t)edits[i].offset + edits[i].delete_length > text.size())
+            {
+                return false;
+            }
+            result.append(text, position, edits[i].offset - position);
+            result.append(edits[i].insert.data, edits[i].insert.length);
+            position = edits[i].offset + edits[i].delete_length;
+        }
+        result.append(text, position, std::string::npos);
+        *out = result;
+        return true;
+    }
+
+    void check_edit_scripts(std::mt19937 &rng)
+    {
+        std::vector<std::string> inserts;
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            inserts.push_back(test_random_text(rng, i < 2 ? 0 : rng() % 70, "XYZ", 3));
+        }
+        const uint32_t capacities[] = {32, 64, 300};
+        for (uint32_t round = 0; round < 6000; round++)
+        {
+            uint32_t capacity = capacities[round % 3];
+            uint32_t length = kTestLengths[round % (sizeof(kTestLengths) / sizeof(kTestLengths[0]))];
+            std::string text = test_random_text(rng, length < capacity ? length : capacity, "abcdef", 6);
+            length = (uint32_t)text.size();
+            Buffer buffer(text, capacity);
+
+            // Mostly disjoint edits in random order, sometimes overlapping, out of range or aliasing the string
+            std::vector<StaticStringEdit> edits(rng() % 10);
+            for (size_t i = 0; i < edits.size(); i++)
+            {
+                const std::string &insert = inserts[rng() % inserts.size()];
+                edits[i].offset = rng() % (length + (round % 50 == 0 ? 3 : 1));
+                edits[i].delete_length = rng() % 4 == 0 ? 0 : rng() % (1 + (length + 1) / (uint32_t)(2 * edits.size() + 1));
+                edits[i].insert.data = insert.data();
+                edits[i].insert.length = (uint32_t)insert.size();
+            }
+            bool aliased = length > 4 && !edits.empty() && round % 97 == 0;
+            if (aliased)
+            {
+                edits[0].insert.data = buffer.data.data() + 1;
+                edits[0].insert.length = 3;
+            }
+
+            std::string expected;
+            uint32_t wanted = reference_apply(text, edits, &expected) && expected.size() <= capacity && !aliased;
+            std::vector<StaticStringEdit> applied = edits;
+            uint32_t result = sstr_core_apply_edits(buffer.data.data(), &buffer.length, capacity, applied.data(), (uint32_t)applied.size());
+            TEST_CHECK(result == wanted && buffer.str() == (wanted ? expected : text) && buffer.terminated(),
+                       "round %u: %u edits on \"%s\" capacity %u", round, (unsigned)edits.size(), text.c_str(), capacity);
+        }
+
+        // Edits queued at one offset keep their order; the last of them removes
+        StaticString sstr;
+        sstr_from_cstr(&sstr, "0123456789");
+        StaticStringEdit storage[4];
+        StaticStringEditScript script;
+        sstr_edit_script_init(&script, storage, 4);
+        sstr_edit_script_replace_cstr(&script, 7, 2, "<>");
+        sstr_edit_script_insert_cstr(&script, 2, "a");
+        sstr_edit_script_insert_cstr(&script, 2, "b");
+        sstr_edit_script_remove(&script, 2, 3);
+        TEST_CHECK(sstr_apply_edits(&sstr, &script) == 1 && sstr_equals_cstr(&sstr, "01ab56<>9"), "queued order at one offset");
+        TEST_CHECK(sstr_edit_script_insert_cstr(&script, 0, "full") == 0, "edit script capacity");
+    }
+}
+
+int main()
+{
+    if (!test_level_supported("edit"))
+    {
+        return TEST_SKIPPED;
+    }
+    std::mt19937 rng(14);
+    check_splice_aliasing();
+    check_random_edits(rng);
+    check_edit_scripts(rng);
+    return test_finish("edit");
+}
@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "test.h"
+
+/*
+ * The gap buffer against a std::string model with a cursor: random sequences
+ * of cursor moves in both directions, inserts, C string inserts up to and
+ * past the capacity, backspaces and deletes, each followed by the same edit on
+ * the model. Every few steps the text is read back with sstr_gap_char_at and
+ * sstr_gap_to_cstr, and editing continues after each sstr_gap_to_cstr, so the
+ * gap is closed and reopened in the middle of a session.
+ */
+
+namespace
+{
+    struct Model
+    {
+        std::string text;
+        uint32_t cursor;
+    };
+
+    // Every character through sstr_gap_char_at, plus the length, the cursor and an index past the end
+    void check_contents(const StaticStringGapBuffer &gap, const Model &model, uint32_t step)
+    {
+        bool same = sstr_gap_length(&gap) == model.text.size() && sstr_gap_cursor(&gap) == model.cursor;
+        for (uint32_t i = 0; same && i < model.text.size(); i++)
+        {
+            same = sstr_gap_char_at(&gap, i) == model.text[i];
+        }
+        TEST_CHECK(same && sstr_gap_char_at(&gap, (uint32_t)model.text.size()) == '\0',
+                   "step %u: length %u cursor %u, expected length %u cursor %u", step, sstr_gap_length(&gap), sstr_gap_cursor(&gap),
+                   (uint32_t)model.text.size(), model.cursor);
+    }
+
+    // Closes the gap; the StaticString must then hold the text, with its hash, and editing goes on from the same cursor
+    void check_to_cstr(StaticStringGapBuffer &gap, StaticString &sstr, const Model &model, uint32_t step)
+    {
+        static StaticString fresh;
+        const char *cstr = sstr_gap_to_cstr(&gap);
+        StaticStringView view = {model.text.data(), (uint32_t)model.text.size()};
+        sstr_from_view(&fresh, view);
+        TEST_CHECK(cstr == sstr.static_string && sstr.string_length == model.text.size() &&
+                       memcmp(cstr, model.text.data(), model.text.size()) == 0 && cstr[model.text.size()] == '\0' &&
+                       sstr_hash(&sstr) == sstr_hash(&fresh),
+                   "step %u: to_cstr of length %u", step, (uint32_t)model.text.size());
+        check_contents(gap, model, step);
+    }
+
+    void check_session(std::mt19937 &rng, const std::string &initial, uint32_t steps)
+    {
+        static StaticString sstr;
+        StaticStringView view = {initial.data(), (uint32_t)initial.size()};
+        sstr_from_view(&sstr, view);
+        StaticStringGapBuffer gap;
+        TEST_CHECK(sstr_gap_init(&gap, &sstr) == 1, "init");
+        Model model = {initial, (uint32_t)initial.size()};
+
+        for (uint32_t step = 0; step < steps; step++)
+        {
+            uint32_t length = (uint32_t)model.text.size();
+            uint32_t room = SSTR_MAX_LENGTH - length;
+            uint32_t op = rng() % 10;
+            if (op <= 2)
+            {
+                // Mostly a short hop either way, sometimes anywhere, sometimes past the end
+                uint32_t target = rng() % 4 == 0 ? rng() % (length + 3) : (uint32_t)std::max(0, (int)model.cursor + (int)(rng() % 17) - 8);
+                bool valid = target <= length;
+                TEST_CHECK(sstr_gap_set_cursor(&gap, target) == (uint32_t)valid, "step %u: cursor to %u of %u", step, target, length);
+                if (valid)
+                {
+                    model.cursor = target;
+                }
+            }
+            else if (op == 3)
+            {
+                char ch = "abcxyz\x80\xFF"[rng() % 8];
+                TEST_CHECK(sstr_gap_insert(&gap, ch) == (uint32_t)(room > 0), "step %u: insert into %u free", step, room);
+                if (room > 0)
+                {
+                    model.text.insert(model.cursor++, 1, ch);
+                }
+            }
+            else if (op == 4)
+            {
+                // Short strings, or exactly the free space, or one more than that
+                uint32_t kind = rng() % 4;
+                uint32_t count = kind == 0 ? room : kind == 1 ? room + 1 : rng() % 12;
+                std::string insert = test_random_text(rng, count, "DEFGH", 5);
+                bool fits = count <= room;
+                TEST_CHECK(sstr_gap_insert_cstr(&gap, insert.c_str()) == (uint32_t)fits, "step %u: insert %u into %u free", step, count,
+                           room);
+                if (fits)
+                {
+                    model.text.insert(model.cursor, insert);
+                    model.cursor += count;
+                }
+            }
+            else if (op <= 6)
+            {
+                TEST_CHECK(sstr_gap_backspace(&gap) == (uint32_t)(model.cursor > 0), "step %u: backspace at %u", step, model.cursor);
+                if (model.cursor > 0)
+                {
+                    model.text.erase(--model.cursor, 1);
+                }
+            }
+            else if (op <= 8)
+            {
+                TEST_CHECK(sstr_gap_delete(&gap) == (uint32_t)(model.cursor < length), "step %u: delete at %u of %u", step, model.cursor,
+                           length);
+                if (model.cursor < length)
+                {
+                    model.text.erase(model.cursor, 1);
+                }
+            }
+            else
+            {
+                check_to_cstr(gap, sstr, model, step);
+            }
+            if (step % 16 == 0)
+            {
+                check_contents(gap, model, step);
+            }
+        }
+        check_to_cstr(gap, sstr, model, steps);
+    }
+
+    // An insert that fills the buffer exactly in the middle of the text, then edits at both ends of a full buffer
+    void check_full()
+    {
+        static StaticString sstr;
+        sstr_from_cstr(&sstr, "headtail");
+        StaticStringGapBuffer gap;
+        sstr_gap_init(&gap, &sstr);
+        sstr_gap_set_cursor(&gap, 4);
+        std::string middle(SSTR_MAX_LENGTH - 8, 'm');
+        TEST_CHECK(sstr_gap_insert_cstr(&gap, middle.c_str()) == 1 && sstr_gap_length(&gap) == SSTR_MAX_LENGTH &&
+                       sstr_gap_cursor(&gap) == SSTR_MAX_LENGTH - 4,
+                   "insert filling the buffer");
+        TEST_CHECK(sstr_gap_insert(&gap, 'x') == 0 && sstr_gap_insert_cstr(&gap, "x") == 0 && sstr_gap_insert_cstr(&gap, "") == 1,
+                   "inserts into a full buffer");
+        std::string expected = "head" + middle + "tail";
+        TEST_CHECK(sstr_gap_to_cstr(&gap) == expected, "full buffer contents");
+        TEST_CHECK(sstr_gap_set_cursor(&gap, 0) == 1 && sstr_gap_delete(&gap) == 1 && sstr_gap_insert(&gap, 'H') == 1 &&
+                       sstr_gap_set_cursor(&gap, SSTR_MAX_LENGTH) == 1 && sstr_gap_backspace(&gap) == 1 && sstr_gap_insert(&gap, 'L') == 1,
+                   "edits at both ends of a full buffer");
+        expected[0] = 'H';
+        expected[SSTR_MAX_LENGTH - 1] = 'L';
+        TEST_CHECK(sstr_gap_to_cstr(&gap) == expected && sstr.string_length == SSTR_MAX_LENGTH, "full buffer after edits at both ends");
+
+        TEST_CHECK(sstr_gap_init(NULL, &sstr) == 0 && sstr_gap_init(&gap, NULL) == 0 && sstr_gap_to_cstr(NULL) == NULL &&
+                       sstr_gap_insert(NULL, 'a') == 0 && sstr_gap_insert_cstr(&gap, NULL) == 0 && sstr_gap_char_at(NULL, 0) == '\0',
+                   "NULL pointers");
+    }
+}
+
+int main()
+{
+    if (!test_level_supported("gap"))
+    {
+        return TEST_SKIPPED;
+    }
+    std::mt19937 rng(16);
+    check_full();
+    for (uint32_t session = 0; session < 200; session++)
+    {
+        uint32_t length = kTestLengths[session % (sizeof(kTestLengths) / sizeof(kTestLengths[0]))];
+        check_session(rng, test_random_text(rng, std::min(length, (uint32_t)SSTR_MAX_LENGTH), "abc", 3), 2000);
+    }
+    return test_finish("gap");
+}
@@ -0,0 +1,189 @@
+#include <string>
+
+#include "test.h"
+
+/*
+ * Hash consistency. Built once with SSTR_CACHED_HASH=0 and once with 1: after
+ * every mutating function, sstr_hash() must equal the hash computed from the
+ * characters, so a stale cached hash shows up at the operation that left it
+ * behind. Cached-hash BasicStaticStrings are run through the same edits next
+ * to uncached ones. Equality, which rejects on the cached hash, is checked
+ * against comparing the characters.
+ */
+
+namespace
+{
+    typedef BasicStaticString<255, uint8_t, SSTR_LAYOUT_HEADER_FIRST, true> Cached;
+    typedef BasicStaticString<255, uint8_t, SSTR_LAYOUT_HEADER_FIRST, false> Plain;
+    typedef BasicStaticString<255, uint8_t, SSTR_LAYOUT_COMPACT, true> CachedCompact;
+
+    std::string contents(const StaticString &sstr)
+    {
+        return std::string(sstr.static_string, sstr.string_length);
+    }
+
+    // Runs one random mutating function of the C API; returns its name
+    const char *mutate(std::mt19937 &rng, StaticString *sstr, StaticString *other)
+    {
+        std::string text = test_random_text(rng, rng() % 90, "ab \tAB", 6);
+        const char *cstr = text.c_str();
+        uint32_t length = sstr->string_length;
+        uint32_t index = length == 0 ? 0 : rng() % length;
+        uint32_t end = length == 0 ? 0 : index + rng() % (length - index);
+        uint32_t truncated;
+        sstr_from_cstr(other, test_random_text(rng, rng() % 4, "ab", 2).c_str());
+
+        switch (rng() % 36)
+        {
+        case 0: sstr_from_cstr(sstr, cstr); return "sstr_from_cstr";
+        case 1: sstr_from_cstr_checked(sstr, cstr, &truncated); return "sstr_from_cstr_checked";
+        case 2: sstr_clear(sstr); return "sstr_clear";
+        case 3: sstr_secure_wipe(sstr); return "sstr_secure_wipe";
+        case 4: sstr_append(sstr, 'c'); return "sstr_append";
+        case 5: sstr_append_cstr(sstr, cstr); return "sstr_append_cstr";
+        case 6: sstr_append_cstr_checked(sstr, cstr, &truncated); return "sstr_append_cstr_checked";
+        case 7: sstr_replace_char_from_index(sstr, index, 'z'); return "sstr_replace_char_from_index";
+        case 8: sstr_replace_all_chars(sstr, 'a', 'b'); return "sstr_replace_all_chars";
+        case 9: sstr_insert_char_at(sstr, index, 'i'); return "sstr_insert_char_at";
+        case 10: sstr_remove_at(sstr, index); return "sstr_remove_at";
+        case 11: sstr_remove_range(sstr, index, end); return "sstr_remove_range";
+        case 12: sstr_insert(sstr, index, other); return "sstr_insert";
+        case 13: sstr_insert_cstr(sstr, index, cstr); return "sstr_insert_cstr";
+        case 14: sstr_replace_range(sstr, index, end, other); return "sstr_replace_range";
+        case 15: sstr_replace_range_cstr(sstr, index, end, cstr); return "sstr_replace_range_cstr";
+        case 16: sstr_replace_all(sstr, other, other); return "sstr_replace_all";
+        case 17: sstr_replace_all_cstr_checked(sstr, "a", "xyz", &truncated); return "sstr_replace_all_cstr_checked";
+        case 18: sstr_replace_all_cstr(sstr, "ab", ""); return "sstr_replace_all_cstr";
+        case 19: sstr_replace_all_copy(other, sstr, "b", "BB", &truncated); sstr_copy(sstr, other); return "sstr_replace_all_copy";
+        case 20: sstr_substring(sstr, other, index, end); sstr_copy(sstr, other); return "sstr_substring";
+        case 21: sstr_trim(sstr); return "sstr_trim";
+        case 22: sstr_trim_leading(sstr); return "sstr_trim_leading";
+        case 23: sstr_trim_trailing(sstr); return "sstr_trim_trailing";
+        case 24: sstr_strip_all_whitespace(sstr); return "sstr_strip_all_whitespace";
+        case 25: sstr_strip_chars(sstr, "aB"); return "sstr_strip_chars";
+        case 26: sstr_pop(sstr); return "sstr_pop";
+        case 27: sstr_truncate(sstr, end); return "sstr_truncate";
+        case 28: sstr_reverse(sstr); return "sstr_reverse";
+        case 29: sstr_to_uppercase(sstr); return "sstr_to_uppercase";
+        case 30: sstr_to_lowercase(sstr); return "sstr_to_lowercase";
+        case 31:
+        {
+            StaticStringTranslation table = sstr_translation_make("ab", "ba");
+            sstr_translate(sstr, &table);
+            return "sstr_translate";
+        }
+        case 32: sstr_from_cstr_uppercase(sstr, cstr); return "sstr_from_cstr_uppercase";
+        case 33: sstr_from_view(sstr, sstr_view_cstr(cstr)); return "sstr_from_view";
+        case 34:
+        {
+            StaticStringEdit storage[2];
+            StaticStringEditScript script;
+            sstr_edit_script_init(&script, storage, 2);
+            sstr_edit_script_insert_cstr(&script, length, "end");
+            sstr_edit_script_replace_cstr(&script, 0, length > 0, "S");
+            sstr_apply_edits(sstr, &script);
+            return "sstr_apply_edits";
+        }
+        default:
+        {
+            StaticStringGapBuffer gap;
+            sstr_gap_init(&gap, sstr);
+            sstr_gap_set_cursor(&gap, index);
+            sstr_gap_insert_cstr(&gap, "gap");
+            sstr_gap_backspace(&gap);
+            sstr_gap_delete(&gap);
+            sstr_gap_to_cstr(&gap);
+            return "sstr_gap_to_cstr";
+        }
+        }
+    }
+
+    void check_struct(std::mt19937 &rng)
+    {
+        static StaticString sstr, other, before, copy;
+        sstr_init(&sstr);
+        sstr_init(&other);
+        for (uint32_t step = 0; step < 60000; step++)
+        {
+            if (sstr.string_length > SSTR_MAX_LENGTH - 20 && rng() % 2 == 0)
+            {
+                sstr_truncate(&sstr, rng() % 40);
+            }
+            sstr_copy(&before, &sstr);
+            const char *name = mutate(rng, &sstr, &other);
+            std::string now = contents(sstr);
+            TEST_CHECK(sstr_hash(&sstr) == sstr_core_hash(sstr.static_string, sstr.string_length), "%s at step %u left \"%s\"", name,
+                       step, now.c_str());
+            TEST_CHECK(sstr_hash(&other) == sstr_core_hash(other.static_string, other.string_length), "%s at step %u", name, step);
+
+            // A fresh copy must hash and compare equal; the string before the edit only if nothing changed
+            sstr_from_view(&copy, sstr_view(&sstr));
+            TEST_CHECK(sstr_hash(&copy) == sstr_hash(&sstr) && sstr_equals(&copy, &sstr) == 1, "%s at step %u", name, step);
+            TEST_CHECK(sstr_equals(&before, &sstr) == (uint32_t)(contents(before) == now), "%s at step %u", name, step);
+            TEST_CHECK(sstr_ihash(&sstr) == sstr_core_ihash(sstr.static_string, sstr.string_length), "%s at step %u", name, step);
+        }
+    }
+
+    // Applies the same random edit to every string in the pack
+    template <typename S>
+    void mutate_template(uint32_t op, S &s, const std::string &text)
+    {
+        uint32_t length = s.length();
+        switch (op)
+        {
+        case 0: s.from_cstr(text.c_str()); break;
+        case 1: s.append('c'); break;
+        case 2: s.append_cstr(text.c_str()); break;
+        case 3: s.insert_cstr(length / 2, text.c_str()); break;
+        case 4: s.remove_range(length / 3, length / 2); break;
+        case 5: s.replace_range_cstr(length / 3, length / 2, text.c_str()); break;
+        case 6: s.replace_all_cstr("a", "xy"); break;
+        case 7: s.pop(); break;
+        case 8: s.truncate(length / 2); break;
+        case 9: s.trim(); break;
+        case 10: s.strip_all_whitespace(); break;
+        case 11: s.to_uppercase(); break;
+        case 12: s.reverse(); break;
+        case 13: s.replace_char_from_index(length / 2, 'q'); break;
+        case 14: s.replace_all_chars('b', 'a'); break;
+        case 15: s.insert_char_at(length / 2, 'i'); break;
+        case 16: s.remove_at(length / 2); break;
+        case 17: s.clear(); break;
+        default: s.copy(sstr_view_cstr(text.c_str())); break;
+        }
+    }
+
+    void check_template(std::mt19937 &rng)
+    {
+        Cached cached;
+        Plain plain;
+        CachedCompact compact;
+        for (uint32_t step = 0; step < 30000; step++)
+        {
+            uint32_t op = rng() % 19;
+            std::string text = test_random_text(rng, rng() % 40, "ab \tAB", 6);
+            Cached before = cached;
+            mutate_template(op, cached, text);
+            mutate_template(op, plain, text);
+            mutate_template(op, compact, text);
+            TEST_CHECK(cached.equals(plain) && compact.equals(plain), "op %u at step %u", op, step);
+            TEST_CHECK(cached.hash() == plain.hash() && compact.hash() == plain.hash() &&
+                           plain.hash() == sstr_core_hash(plain.data(), plain.length()),
+                       "op %u at step %u left \"%s\"", op, step, plain.to_cstr());
+            TEST_CHECK(before.equals(cached) == (uint32_t)(std::string(before.data(), before.length()) == plain.to_cstr()), "op %u at step %u",
+                       op, step);
+        }
+    }
+}
+
+int main()
+{
+    if (!test_level_supported(SSTR_CACHED_HASH ? "hash_cached" : "hash"))
+    {
+        return TEST_SKIPPED;
+    }
+    std::mt19937 rng(7);
+    check_struct(rng);
+    check_template(rng);
+    return test_finish(SSTR_CACHED_HASH ? "hash_cached" : "hash");
+}
@@ -0,0 +1,314 @@
+#include <iterator>
+#include <string>
+#include <unordered_map>
+
+#include "StaticStringMap.h"
+#include "test.h"
+
+/*
+ * StaticStringMap against std::unordered_map under insert/erase churn: keys
+ * come and go so erased slots pile up as tombstones, forcing same-size
+ * rehashes next to growth. After every operation the sizes agree; every few
+ * hundred the iteration order is walked and every reference key looked up.
+ * Built at SSTR_SIMD_LEVEL 0 the map probes 8-slot SWAR groups instead of
+ * 16-slot SSE2 groups.
+ */
+
+namespace
+{
+    typedef StaticStringMap<std::string, 20> Map;
+    typedef std::unordered_map<std::string, std::string> Reference;
+
+    // Slot count reserve() would pick for size keys under the 7/8 load limit
+    uint32_t slots_for(uint32_t size)
+    {
+        uint32_t count = SSTR_MAP_GROUP_WIDTH;
+        while (count - count / 8 < size)
+        {
+            count *= 2;
+        }
+        return count;
+    }
+
+    // Iteration visits every key exactly once, and every reference key is found with its value
+    void check_contents(const Map &map, const Reference &reference, const char *phase, uint32_t step)
+    {
+        Reference seen;
+        uint32_t visited = 0;
+        for (Map::const_iterator it = map.begin(); it != map.end(); ++it)
+        {
+            std::string key(it->key.data(), it->key.length());
+            Reference::const_iterator expected = reference.find(key);
+            TEST_CHECK(expected != reference.end() && expected->second == it->value && seen.count(key) == 0,
+                       "%s step %u: iterated key \"%s\"", phase, step, key.c_str());
+            seen[key] = it->value;
+            visited++;
+        }
+        TEST_CHECK(visited == reference.size() && map.size() == reference.size(), "%s step %u: %u iterated, %u stored, %u expected", phase,
+                   step, visited, map.size(), (uint32_t)reference.size());
+        for (Reference::const_iterator it = reference.begin(); it != reference.end(); ++it)
+        {
+            const std::string *value = map.find(it->first.data(), (uint32_t)it->first.size());
+            TEST_CHECK(value != NULL && *value == it->second, "%s step %u: key \"%s\"", phase, step, it->first.c_str());
+        }
+    }
+
+    /**
+     * @brief Runs random operations on a map and a reference side by side.
+     *
+     * The live key count swings between empty and target, so each cycle
+     * erases most keys and leaves tombstones for the next cycle to reuse or
+     * rehash away. Keys up to 24 characters long include ones the map must
+     * reject.
+     */
+    void check_churn(std::mt19937 &rng, uint32_t target, uint32_t steps, const char *alphabet, uint32_t alphabet_size)
+    {
+        Map map;
+        Reference reference;
+        uint32_t peak = 0;
+        bool growing = true;
+        for (uint32_t step = 0; step < steps; step++)
+        {
+            std::string key = test_random_text(rng, rng() % 25, alphabet, alphabet_size);
+            if (rng() % 3 == 0 && !reference.empty())
+            {
+                // An existing key, so erases and assigns hit as often as they miss
+                Reference::const_iterator it = reference.begin();
+                for (uint32_t skip = rng() % 8; skip > 0 && std::next(it) != reference.end(); skip--)
+                {
+                    ++it;
+                }
+                key = it->first;
+            }
+            const char *data = key.data();
+            uint32_t length = (uint32_t)key.size();
+            bool fits = length <= Map::max_key_length();
+            std::string value = std::to_string(step);
+            bool present = reference.count(key) != 0;
+
+            if (growing && reference.size() >= target)
+            {
+                growing = false;
+            }
+            else if (!growing && reference.size() <= target / 8)
+            {
+                growing = true;
+            }
+
+            uint32_t op = rng() % 8;
+            if (op < 3 && !growing)
+            {
+                op += 3; // Erase more than insert while shrinking
+            }
+            if (op == 0)
+            {
+                TEST_CHECK(map.insert(data, length, value) == (uint32_t)(fits && !present), "insert \"%s\" at step %u", key.c_str(), step);
+                if (fits && !present)
+                {
+                    reference[key] = value;
+                }
+            }
+            else if (op == 1)
+            {
+                TEST_CHECK(map.insert_or_assign(data, length, value) == (uint32_t)fits, "insert_or_assign \"%s\" at step %u", key.c_str(),
+                           step);
+                if (fits)
+                {
+                    reference[key] = value;
+                }
+            }
+            else if (op == 2)
+            {
+                std::string *slot = map.find_or_insert(data, length);
+                TEST_CHECK((slot != NULL) == fits && (slot == NULL || *slot == (present ? reference[key] : std::string())),
+                           "find_or_insert \"%s\" at step %u", key.c_str(), step);
+                if (slot != NULL)
+                {
+                    *slot = value;
+                    reference[key] = value;
+                }
+            }
+            else if (op <= 5)
+            {
+                TEST_CHECK(map.erase(data, length) == (uint32_t)present, "erase \"%s\" at step %u", key.c_str(), step);
+                reference.erase(key);
+            }
+            else if (op == 6 && !map.empty())
+            {
+                // Erase through an iterator, which must land on the next entry
+                Map::iterator it = map.begin();
+                Map::iterator following = it;
+                ++following;
+                std::string erased(it->key.data(), it->key.length());
+                TEST_CHECK(map.erase(it) == following, "erase(iterator) at step %u", step);
+                reference.erase(erased);
+            }
+            else
+            {
+                const std::string *found = map.find(data, length);
+                TEST_CHECK((found != NULL) == present && (found == NULL || *found == reference[key]), "find \"%s\" at step %u", key.c_str(),
+                           step);
+            }
+
+            peak = reference.size() > peak ? (uint32_t)reference.size() : peak;
+            TEST_CHECK(map.size() == reference.size(), "size after op %u at step %u", op, step);
+            // Tombstones are rehashed away in place rather than by growing, so churn at a steady size cannot grow the table
+            TEST_CHECK(map.capacity() <= 4 * slots_for(peak), "capacity %u with at most %u keys at step %u", map.capacity(), peak, step);
+            if (step % 512 == 0)
+            {
+                check_contents(map, reference, "churn", step);
+            }
+        }
+        check_contents(map, reference, "churn end", steps);
+
+        Map copy(map);
+        check_contents(copy, reference, "copy", steps);
+        Map assigned;
+        assigned = copy;
+        map.clear();
+        TEST_CHECK(map.empty() && map.begin() == map.end() && (assigned.empty() || map.find(assigned.begin()->key) == NULL), "clear");
+        check_contents(assigned, reference, "assigned", steps);
+    }
+
+    /**
+     * @brief Erases from tables filled to the load limit, where most probe windows have no empty slot.
+     *
+     * Erasing such a slot must leave a tombstone, or keys that probed past it
+     * become unreachable, so every remaining key is looked up after each
+     * erase. The table is then refilled through the tombstones.
+     */
+    void check_dense_erase(std::mt19937 &rng)
+    {
+        for (uint32_t slots = SSTR_MAP_GROUP_WIDTH; slots <= 512; slots *= 2)
+        {
+            for (uint32_t trial = 0; trial < 8; trial++)
+            {
+                Map map;
+                Reference reference;
+                map.reserve(slots - slots / 8);
+                uint32_t next_key = 0;
+                while (map.size() < slots - slots / 8)
+                {
+                    std::string key = "k" + std::to_string(next_key++);
+                    map.insert(key.data(), (uint32_t)key.size(), key);
+                    reference[key] = key;
+                }
+                TEST_CHECK(map.capacity() == slots, "%u slots filled to the load limit became %u", slots, map.capacity());
+
+                for (uint32_t round = 0; round < 2; round++)
+                {
+                    while (reference.size() > (slots - slots / 8) / 4)
+                    {
+                        Reference::iterator victim = reference.begin();
+                        for (uint32_t skip = rng() % 16; skip > 0 && std::next(victim) != reference.end(); skip--)
+                        {
+                            ++victim;
+                        }
+                        TEST_CHECK(map.erase(victim->first.data(), (uint32_t)victim->first.size()) == 1, "%u slots: erase \"%s\"", slots,
+                                   victim->first.c_str());
+                        reference.erase(victim);
+                        for (Reference::const_iterator it = reference.begin(); it != reference.end(); ++it)
+                        {
+                            TEST_CHECK(map.find(it->first.data(), (uint32_t)it->first.size()) != NULL, "%u slots trial %u: \"%s\" lost",
+                                       slots, trial, it->first.c_str());
+                        }
+                    }
+                    while (reference.size() < slots - slots / 8)
+                    {
+                        std::string key = "k" + std::to_string(next_key++);
+                        map.insert(key.data(), (uint32_t)key.size(), key);
+                        reference[key] = key;
+                    }
+                    check_contents(map, reference, "dense refill", slots);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Replaces keys one for one at a fixed size.
+     *
+     * Every insert is a new key, so tombstones use up the empty slots and the
+     * table has to be rebuilt again and again. Below half the load limit that
+     * rebuild keeps the slot count; growing instead would double it each time.
+     */
+    void check_steady_churn(std::mt19937 &rng)
+    {
+        const uint32_t sizes[] = {5, 100, 1000};
+        for (uint32_t s = 0; s < 3; s++)
+        {
+            uint32_t size = sizes[s];
+            Map map;
+            Reference reference;
+            uint32_t next_key = 0;
+            for (uint32_t step = 0; step < 100000; step++)
+            {
+                std::string key = "s" + std::to_string(next_key++);
+                TEST_CHECK(map.insert(key.data(), (uint32_t)key.size(), key) == 1, "size %u: insert \"%s\"", size, key.c_str());
+                reference[key] = key;
+                if (reference.size() > size)
+                {
+                    Reference::iterator victim = reference.begin();
+                    for (uint32_t skip = rng() % 8; skip > 0 && std::next(victim) != reference.end(); skip--)
+                    {
+                        ++victim;
+                    }
+                    TEST_CHECK(map.erase(victim->first.data(), (uint32_t)victim->first.size()) == 1, "size %u: erase \"%s\"", size,
+                               victim->first.c_str());
+                    reference.erase(victim);
+                }
+                TEST_CHECK(map.capacity() <= slots_for(2 * size + 2), "size %u step %u: %u slots", size, step, map.capacity());
+            }
+            check_contents(map, reference, "steady churn", size);
+        }
+    }
+
+    // A reserved table takes the promised keys without a rehash, and keys longer than N are never stored
+    void check_reserve_and_limits(std::mt19937 &rng)
+    {
+        for (uint32_t size = 0; size <= 300; size += 1 + size / 4)
+        {
+            Map map;
+            Reference reference;
+            TEST_CHECK(map.reserve(size) == (uint32_t)(size > 0) && map.capacity() == (size == 0 ? 0 : slots_for(size)), "reserve %u", size);
+            uint32_t slots = map.capacity();
+            while (reference.size() < size)
+            {
+                std::string key = test_random_text(rng, 1 + rng() % 20, "abcdefgh", 8);
+                if (map.insert(key.data(), (uint32_t)key.size(), key))
+                {
+                    reference[key] = key;
+                }
+            }
+            TEST_CHECK(map.capacity() == slots && map.reserve(size) == 0, "reserved %u keys, %u slots became %u", size, slots, map.capacity());
+            check_contents(map, reference, "reserve", size);
+        }
+
+        Map map;
+        std::string longest(Map::max_key_length(), 'k');
+        std::string too_long(Map::max_key_length() + 1, 'k');
+        TEST_CHECK(map.insert_cstr(longest.c_str(), "v") == 1 && map.find_cstr(longest.c_str()) != NULL, "key of N characters");
+        TEST_CHECK(map.insert_cstr(too_long.c_str(), "v") == 0 && map.insert_or_assign_cstr(too_long.c_str(), "v") == 0 &&
+                       map.find_or_insert_cstr(too_long.c_str()) == NULL && map.find_cstr(too_long.c_str()) == NULL &&
+                       map.erase_cstr(too_long.c_str()) == 0 && map.size() == 1,
+                   "key of N + 1 characters");
+        TEST_CHECK(map.insert("", 0, "empty") == 1 && *map.find("", 0) == "empty" && map.size() == 2, "empty key");
+        TEST_CHECK(map.insert("a\0b", 3, "nul") == 1 && map.find("a", 1) == NULL && *map.find("a\0b", 3) == "nul", "key with a null byte");
+    }
+}
+
+int main()
+{
+    if (!test_level_supported("map"))
+    {
+        return TEST_SKIPPED;
+    }
+    std::mt19937 rng(8);
+    check_reserve_and_limits(rng);
+    check_dense_erase(rng);
+    check_steady_churn(rng);
+    check_churn(rng, 6, 20000, "ab", 2);
+    check_churn(rng, 40, 60000, "abc", 3);
+    check_churn(rng, 2000, 120000, "abcdefgh", 8);
+    return test_finish("map");
+}
@@ -0,0 +1,171 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "StaticStringMatcher.h"
+#include "test.h"
+
+/*
+ * StaticStringMatcher against comparing every pattern at every end position.
+ * Teddy and Aho-Corasick must both report the same hits in the documented
+ * order: by end position, then longest pattern first, then by pattern index.
+ * Texts sit at every alignment with lengths around the 32- and 64-byte Teddy
+ * blocks, and callbacks stop the scan at every hit in turn.
+ */
+
+namespace
+{
+    const uint32_t kEngines[] = {SSTR_MATCHER_TEDDY, SSTR_MATCHER_AHO_CORASICK};
+
+    std::vector<StaticStringMatch> reference_matches(const std::vector<std::string> &patterns, const std::string &text)
+    {
+        uint32_t longest = 0;
+        for (size_t p = 0; p < patterns.size(); p++)
+        {
+            longest = std::max(longest, (uint32_t)patterns[p].size());
+        }
+        std::vector<StaticStringMatch> matches;
+        for (uint32_t end = 1; end <= text.size(); end++)
+        {
+            for (uint32_t length = std::min(longest, end); length > 0; length--)
+            {
+                for (uint32_t p = 0; p < patterns.size(); p++)
+                {
+                    if (patterns[p].size() == length && text.compare(end - length, length, patterns[p]) == 0)
+                    {
+                        StaticStringMatch match = {p, end - length, end};
+                        matches.push_back(match);
+                    }
+                }
+            }
+        }
+        return matches;
+    }
+
+    bool same_match(const StaticStringMatch &a, const StaticStringMatch &b)
+    {
+        return a.pattern == b.pattern && a.start == b.start && a.end == b.end;
+    }
+
+    // Random text over a few letters and a few bytes above 0x7F, which index the upper nibble tables
+    std::string random_bytes(std::mt19937 &rng, uint32_t length, uint32_t alphabet)
+    {
+        std::string text(length, '\0');
+        for (uint32_t i = 0; i < length; i++)
+        {
+            text[i] = rng() % 4 == 0 ? (char)(0xC8 + rng() % alphabet) : (char)('a' + rng() % alphabet);
+        }
+        return text;
+    }
+
+    void check_text(const StaticStringMatcher &matcher, const std::vector<std::string> &patterns, const std::string &text, uint32_t align,
+                    uint32_t round)
+    {
+        std::vector<StaticStringMatch> expected = reference_matches(patterns, text);
+        std::vector<char> buffer(align + text.size() + 1);
+        std::copy(text.begin(), text.end(), buffer.begin() + align);
+        const char *data = buffer.data() + align;
+        uint32_t length = (uint32_t)text.size();
+
+        std::vector<StaticStringMatch> found(expected.size() + 4);
+        uint32_t count = matcher.find_all(data, length, found.data(), (uint32_t)found.size());
+        bool same = count == expected.size();
+        for (uint32_t i = 0; same && i < count; i++)
+        {
+            same = same_match(found[i], expected[i]);
+        }
+        TEST_CHECK(same, "round %u engine %u: %u patterns, text length %u align %u, %u hits for %u expected", round, matcher.engine(),
+                   (uint32_t)patterns.size(), length, align, count, (uint32_t)expected.size());
+        TEST_CHECK(matcher.contains_any(data, length) == (uint32_t)!expected.empty(), "round %u engine %u: contains_any", round,
+                   matcher.engine());
+
+        // A short output array still gets the total, and its first entries
+        if (expected.size() > 1)
+        {
+            StaticStringMatch first = {0, 0, 0};
+            TEST_CHECK(matcher.find_all(data, length, &first, 1) == expected.size() && same_match(first, expected[0]),
+                       "round %u engine %u: find_all into one slot", round, matcher.engine());
+        }
+
+        // Stopping after k hits reports exactly the first k, whether the stop lands in a vector block or the scalar tail
+        for (uint32_t stop = 1; stop <= expected.size() && stop <= 40; stop += 1 + stop / 8)
+        {
+            uint32_t seen = 0;
+            bool in_order = true;
+            uint32_t reported = matcher.scan(data, length, [&](const StaticStringMatch &match) {
+                in_order = in_order && same_match(match, expected[seen]);
+                return ++seen < stop;
+            });
+            TEST_CHECK(reported == stop && seen == stop && in_order, "round %u engine %u: stop after %u of %u hits", round,
+                       matcher.engine(), stop, (uint32_t)expected.size());
+        }
+    }
+
+    void check_random(std::mt19937 &rng)
+    {
+        for (uint32_t round = 0; round < 1500; round++)
+        {
+            // Mostly within the Teddy limit, sometimes far over it so buckets hold many patterns
+            uint32_t alphabet = 2 + rng() % 6;
+            uint32_t pattern_count = 1 + rng() % (round % 5 == 0 ? 300 : SSTR_TEDDY_MAX_PATTERNS + 8);
+            std::vector<std::string> patterns;
+            StaticStringMatcher matcher;
+            for (uint32_t p = 0; p < pattern_count; p++)
+            {
+                uint32_t length = 1 + rng() % (1 + rng() % (round % 7 == 0 ? 70 : 8));
+                if (p > 0 && rng() % 16 == 0)
+                {
+                    patterns.push_back(patterns[rng() % p]); // Duplicates are reported once per index
+                }
+                else
+                {
+                    patterns.push_back(random_bytes(rng, length, alphabet));
+                }
+                matcher.add(patterns.back().data(), (uint32_t)patterns.back().size());
+            }
+
+            uint32_t text_length = round < 700 ? kTestLengths[round % (sizeof(kTestLengths) / sizeof(kTestLengths[0]))] : rng() % 400;
+            std::string text = random_bytes(rng, text_length, alphabet);
+            uint32_t align = rng() % 64;
+            for (uint32_t e = 0; e < 2; e++)
+            {
+                TEST_CHECK(matcher.compile(kEngines[e]) == kEngines[e] && matcher.engine() == kEngines[e], "round %u: compile %u", round,
+                           kEngines[e]);
+                check_text(matcher, patterns, text, align, round);
+            }
+        }
+    }
+
+    // Empty patterns are refused, an uncompiled matcher finds nothing, and adding a pattern needs a new compile()
+    void check_lifecycle()
+    {
+        StaticStringMatcher matcher;
+        TEST_CHECK(matcher.add("", 0) == 0 && matcher.add_cstr(NULL) == 0 && matcher.size() == 0, "empty patterns");
+        TEST_CHECK(matcher.compile() == 0 && matcher.find_all("abc", 3, NULL, 0) == 0, "no patterns");
+        matcher.add_cstr("he");
+        matcher.add_cstr("she");
+        matcher.add_cstr("hers");
+        std::vector<std::string> patterns = {"he", "she", "hers"};
+        for (uint32_t e = 0; e < 2; e++)
+        {
+            matcher.compile(kEngines[e]);
+            check_text(matcher, patterns, "ushers", 0, 0);
+            TEST_CHECK(matcher.find_all("ushers", 6, NULL, 0) == 3, "engine %u: \"ushers\"", kEngines[e]);
+        }
+        matcher.add_cstr("us");
+        TEST_CHECK(matcher.engine() == 0 && matcher.contains_any("us", 2) == 0, "add() discards the engine");
+        TEST_CHECK(matcher.compile() != 0 && matcher.contains_any("us", 2) == 1, "recompiled");
+    }
+}
+
+int main()
+{
+    if (!test_level_supported("matcher"))
+    {
+        return TEST_SKIPPED;
+    }
+    std::mt19937 rng(25);
+    check_lifecycle();
+    check_random(rng);
+    return test_finish("matcher");
+}
@@ -0,0 +1,123 @@
+#include <string>
+#include <vector>
+
+#include "test.h"
+
+/*
+ * Substring replace_all, in place and into a second buffer, against
+ * replacing every match of a std::string and cutting the result at capacity.
+ * Growing replacements are checked at capacities that clip the result at
+ * every position: inside a kept run, at a match and inside a replacement.
+ */
+
+namespace
+{
+    struct Expected
+    {
+        std::string text;   // Result cut at capacity
+        uint32_t count;     // Occurrences whose replacement starts before the cut
+        uint32_t truncated; // Whether the full result is longer than capacity
+    };
+
+    Expected reference_replace_all(const std::string &text, const std::string &needle, const std::string &replacement, uint32_t capacity)
+    {
+        std::string full;
+        uint32_t count = 0;
+        size_t read = 0;
+        for (size_t match = text.find(needle); !needle.empty() && match != std::string::npos; match = text.find(needle, read))
+        {
+            full.append(text, read, match - read);
+            // An empty replacement exactly at the cut loses nothing, so it still counts
+            if (full.size() < capacity || (full.size() == capacity && replacement.empty()))
+            {
+                count++;
+            }
+            full += replacement;
+            read = match + needle.size();
+        }
+        full.append(text, read, std::string::npos);
+        Expected expected = {full.substr(0, capacity), count, full.size() > capacity};
+        return expected;
+    }
+
+    void check_case(const std::string &text, const std::string &needle, const std::string &replacement, uint32_t capacity)
+    {
+        Expected expected = reference_replace_all(text, needle, replacement, capacity);
+
+        if (text.size() <= capacity && !needle.empty())
+        {
+            std::vector<char> data(capacity + 1, '#');
+            text.copy(data.data(), text.size());
+            data[text.size()] = '\0';
+            uint32_t length = (uint32_t)text.size();
+            uint32_t truncated = 2;
+            uint32_t count = sstr_core_replace_all(data.data(), &length, capacity, needle.data(), (uint32_t)needle.size(), replacement.data(),
+                                                   (uint32_t)replacement.size(), &truncated);
+            TEST_CHECK(count == expected.count && truncated == expected.truncated && std::string(data.data(), length) == expected.text &&
+                           data[length] == '\0',
+                       "in place: \"%s\" needle \"%s\" replacement \"%s\" capacity %u: %u replaced", text.c_str(), needle.c_str(),
+                       replacement.c_str(), capacity, count);
+        }
+
+        std::vector<char> dest(capacity + 1, '#');
+        uint32_t dest_length = 0;
+        uint32_t truncated = 2;
+        uint32_t count = sstr_core_replace_all_copy(text.data(), (uint32_t)text.size(), dest.data(), &dest_length, capacity, needle.data(),
+                                                    (uint32_t)needle.size(), replacement.data(), (uint32_t)replacement.size(), &truncated);
+        TEST_CHECK(count == expected.count && truncated == expected.truncated && std::string(dest.data(), dest_length) == expected.text &&
+                       dest[dest_length] == '\0',
+                   "copy: \"%s\" needle \"%s\" replacement \"%s\" capacity %u: %u replaced", text.c_str(), needle.c_str(),
+                   replacement.c_str(), capacity, count);
+    }
+
+    void check_random(std::mt19937 &rng)
+    {
+        const char *const needles[] = {"a", "b", "ab", "aa", "aba", "abab", "bbbbbbbbbbbbbbbbbbbb"};
+        const char *const replacements[] = {"", "x", "xy", "ab", "xyz", "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx"};
+        for (uint32_t round = 0; round < 1500; round++)
+        {
+            uint32_t length = kTestLengths[round % (sizeof(kTestLengths) / sizeof(kTestLengths[0]))];
+            std::string text = test_random_text(rng, length, "abc", 2 + round % 2);
+            std::string needle = needles[rng() % (sizeof(needles) / sizeof(needles[0]))];
+            std::string replacement = replacements[rng() % (sizeof(replacements) / sizeof(replacements[0]))];
+            Expected unclipped = reference_replace_all(text, needle, replacement, 0xFFFFFFFFu);
+            uint32_t full = (uint32_t)unclipped.text.size();
+
+            // Every cut around the end of the replaced string, and a few random ones before it
+            for (uint32_t capacity = full > 8 ? full - 8 : 0; capacity <= full + 2; capacity++)
+            {
+                check_case(text, needle, replacement, capacity);
+            }
+            for (uint32_t i = 0; i < 8; i++)
+            {
+                check_case(text, needle, replacement, rng() % (full + 1));
+            }
+        }
+    }
+
+    // Matches that sit exactly at the cut, for both growing and empty replacements
+    void check_cut_at_match()
+    {
+        check_case("aXa", "X", "YYYY", 1);
+        check_case("aXa", "X", "YYYY", 2);
+        check_case("aXXa", "X", "", 1);
+        check_case("XXXX", "X", "", 0);
+        check_case("aXXb", "X", "", 1);
+        check_case("XXXX", "X", "YY", 4);
+        check_case("XXXX", "X", "YY", 5);
+        check_case("", "X", "YY", 0);
+        check_case("abc", "", "YY", 3);
+    }
+}
+
+int main()
+{
+    if (!test_level_supported("replace"))
+    {
+        return TEST_SKIPPED;
+    }
+    std::mt19937 rng(23);
+    check_cut_at_match();
+    check_random(rng);
+    return test_finish("replace");
+}
@@ -0,0 +1,189 @@
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <vector>
+
+#include "test.h"
+
+/*
+ * Substring search against std::string: the find_pair prefilter kernels at
+ * every vector boundary and alignment, then find, rfind, ifind and find_all
+ * on random, periodic and adversarial inputs that push the search into its
+ * Two-Way fallback.
+ */
+
+namespace
+{
+    uint32_t reference_find_pair(const std::string &data, char first, char last, uint32_t distance, bool reverse, bool fold)
+    {
+        uint32_t length = (uint32_t)data.size();
+        if (distance >= length)
+        {
+            return length;
+        }
+        for (uint32_t n = 0; n < length - distance; n++)
+        {
+            uint32_t i = reverse ? length - distance - 1 - n : n;
+            char a = fold ? (char)tolower((unsigned char)data[i]) : data[i];
+            char b = fold ? (char)tolower((unsigned char)data[i + distance]) : data[i + distance];
+            if (a == first && b == last)
+            {
+                return i;
+            }
+        }
+        return length;
+    }
+
+    std::string lowercase(std::string text)
+    {
+        for (size_t i = 0; i < text.size(); i++)
+        {
+            text[i] = (char)tolower((unsigned char)text[i]);
+        }
+        return text;
+    }
+
+    int32_t reference_result(size_t index)
+    {
+        return index == std::string::npos ? -1 : (int32_t)index;
+    }
+
+    void check_find_pair(std::mt19937 &rng)
+    {
+        const SStrKernels *kernels = sstr_kernels();
+        std::vector<char> buffer(512 + 64);
+        for (size_t l = 0; l < sizeof(kTestLengths) / sizeof(kTestLengths[0]); l++)
+        {
+            uint32_t length = kTestLengths[l];
+            for (uint32_t align = 0; align < 64; align += 7)
+            {
+                // Rare hits, so the kernels scan whole vectors before matching in the tail
+                std::string text = test_random_text(rng, length, "abcdefgh", 8);
+                for (uint32_t p = rng() % 3; p > 0 && length > 0; p--)
+                {
+                    text[rng() % length] = 'x';
+                }
+                std::copy(text.begin(), text.end(), buffer.begin() + align);
+                const char *data = buffer.data() + align;
+                std::string folded = lowercase(text);
+                for (uint32_t distance = 0; distance <= length + 1 && distance < 80; distance++)
+                {
+                    TEST_CHECK(kernels->find_pair(data, length, 'x', 'x', distance) == reference_find_pair(text, 'x', 'x', distance, false, false),
+                               "length %u align %u distance %u", length, align, distance);
+                    TEST_CHECK(kernels->find_pair_reverse(data, length, 'x', 'x', distance) ==
+                                   reference_find_pair(text, 'x', 'x', distance, true, false),
+                               "length %u align %u distance %u", length, align, distance);
+                    TEST_CHECK(kernels->find_pair(data, length, 'a', 'b', distance) == reference_find_pair(text, 'a', 'b', distance, false, false),
+                               "length %u align %u distance %u", length, align, distance);
+                    TEST_CHECK(kernels->find_pair_reverse(data, length, 'a', 'b', distance) ==
+                                   reference_find_pair(text, 'a', 'b', distance, true, false),
+                               "length %u align %u distance %u", length, align, distance);
+                    TEST_CHECK(kernels->ifind_pair(data, length, 'x', 'x', distance) == reference_find_pair(folded, 'x', 'x', distance, false, true),
+                               "length %u align %u distance %u", length, align, distance);
+                }
+            }
+        }
+    }
+
+    // Compares every search function for one haystack and needle
+    void check_search(const std::string &haystack, const std::string &needle)
+    {
+        const char *h = haystack.data();
+        const char *n = needle.data();
+        uint32_t hl = (uint32_t)haystack.size();
+        uint32_t nl = (uint32_t)needle.size();
+
+        TEST_CHECK(sstr_core_rfind(h, hl, n, nl) == reference_result(haystack.rfind(needle)), "haystack \"%s\" needle \"%s\"",
+                   haystack.c_str(), needle.c_str());
+        uint32_t step = hl < 80 ? 1 : hl / 40;
+        for (uint32_t start = 0; start <= hl + 1; start += step)
+        {
+            int32_t expected = start > hl ? -1 : reference_result(haystack.find(needle, start));
+            TEST_CHECK(sstr_core_find(h, hl, n, nl, start) == expected, "haystack \"%s\" needle \"%s\" start %u", haystack.c_str(),
+                       needle.c_str(), start);
+        }
+
+        std::string folded = lowercase(haystack);
+        std::string folded_needle = lowercase(needle);
+        TEST_CHECK(sstr_core_ifind(h, hl, n, nl, 0) == reference_result(folded.find(folded_needle)), "haystack \"%s\" needle \"%s\"",
+                   haystack.c_str(), needle.c_str());
+
+        if (nl > 0)
+        {
+            std::vector<uint32_t> expected;
+            for (size_t at = haystack.find(needle); at != std::string::npos; at = haystack.find(needle, at + nl))
+            {
+                expected.push_back((uint32_t)at);
+            }
+            std::vector<uint32_t> positions(expected.size() + 1);
+            uint32_t count = sstr_core_find_all(h, hl, n, nl, positions.data(), (uint32_t)positions.size());
+            positions.resize(std::min<size_t>(count, expected.size()));
+            TEST_CHECK(count == expected.size() && positions == expected, "haystack \"%s\" needle \"%s\"", haystack.c_str(), needle.c_str());
+        }
+    }
+
+    void check_random_search(std::mt19937 &rng)
+    {
+        for (uint32_t round = 0; round < 3000; round++)
+        {
+            uint32_t length = round < 600 ? kTestLengths[round % (sizeof(kTestLengths) / sizeof(kTestLengths[0]))] : rng() % 600;
+            uint32_t alphabet = 2 + rng() % 3;
+            std::string haystack = test_random_text(rng, length, "abcAB", alphabet);
+
+            uint32_t needle_length = 1 + rng() % (round % 4 == 0 ? 80 : 12);
+            std::string needle;
+            if (rng() % 2 == 0 && needle_length <= length)
+            {
+                needle = haystack.substr(rng() % (length - needle_length + 1), needle_length); // At least one hit
+            }
+            else
+            {
+                needle = test_random_text(rng, needle_length, "abcAB", alphabet);
+            }
+            check_search(haystack, needle);
+        }
+        check_search("", "");
+        check_search("abc", "");
+        check_search("", "a");
+    }
+
+    // Inputs where almost every candidate passes the prefilter and then fails verification
+    void check_adversarial()
+    {
+        const uint32_t lengths[] = {63, 64, 65, 255, 1024, 4096};
+        for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++)
+        {
+            std::string haystack(lengths[l], 'a');
+            for (uint32_t needle_length = 2; needle_length <= 130; needle_length += 8)
+            {
+                std::string needle(needle_length, 'a');
+                needle[needle_length / 2] = 'b';
+                check_search(haystack, needle);
+                haystack[lengths[l] / 3] = 'b'; // Now there is exactly one place the needle can match
+                check_search(haystack, needle);
+                haystack[lengths[l] / 3] = 'a';
+
+                std::string periodic;
+                while (periodic.size() < haystack.size())
+                {
+                    periodic += "aab";
+                }
+                std::string periodic_needle = periodic.substr(1, needle_length) + "a";
+                check_search(periodic, periodic_needle);
+            }
+        }
+    }
+}
+
+int main()
+{
+    if (!test_level_supported("search"))
+    {
+        return TEST_SKIPPED;
+    }
+    std::mt19937 rng(6);
+    check_find_pair(rng);
+    check_random_search(rng);
+    check_adversarial();
+    return test_finish("search");
+}
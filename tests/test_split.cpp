@@ -0,0 +1,241 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "test.h"
+
+/*
+ * The split iterator against splitting a std::string by hand, in all three
+ * modes: a single character, any character of a set (up to
+ * SSTR_SPLIT_MAX_MASKED_SET characters matched one mask each, larger sets
+ * through a character class) and a multi-character delimiter matched left to
+ * right without overlap. Texts run past several 64-character blocks with
+ * delimiters straddling block edges, consecutive delimiters and delimiters at
+ * both ends; the StaticStringSplitRange wrappers must give the same tokens.
+ */
+
+namespace
+{
+    struct Token
+    {
+        uint32_t start;
+        uint32_t length;
+    };
+
+    bool same_tokens(const std::vector<Token> &a, const std::vector<Token> &b)
+    {
+        if (a.size() != b.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); i++)
+        {
+            if (a[i].start != b[i].start || a[i].length != b[i].length)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Tokens between the bytes of text found in set; N delimiters give N + 1 tokens
+    std::vector<Token> reference_split_any(const std::string &text, const std::string &set)
+    {
+        std::vector<Token> tokens;
+        uint32_t start = 0;
+        for (uint32_t i = 0; i < text.size(); i++)
+        {
+            if (set.find(text[i]) != std::string::npos)
+            {
+                Token token = {start, i - start};
+                tokens.push_back(token);
+                start = i + 1;
+            }
+        }
+        Token last = {start, (uint32_t)text.size() - start};
+        tokens.push_back(last);
+        return tokens;
+    }
+
+    std::vector<Token> reference_split_string(const std::string &text, const std::string &delimiter)
+    {
+        std::vector<Token> tokens;
+        uint32_t start = 0;
+        for (size_t found = text.find(delimiter); found != std::string::npos; found = text.find(delimiter, start))
+        {
+            Token token = {start, (uint32_t)found - start};
+            tokens.push_back(token);
+            start = (uint32_t)found + (uint32_t)delimiter.size();
+        }
+        Token last = {start, (uint32_t)text.size() - start};
+        tokens.push_back(last);
+        return tokens;
+    }
+
+    std::vector<Token> collect(StaticStringSplit &split, const char *data)
+    {
+        std::vector<Token> tokens;
+        StaticStringView token;
+        while (sstr_split_next(&split, &token) && tokens.size() <= 1000)
+        {
+            Token entry = {(uint32_t)(token.data - data), token.length};
+            tokens.push_back(entry);
+        }
+        return tokens;
+    }
+
+    std::vector<Token> collect(const StaticStringSplitRange &range, const char *data)
+    {
+        std::vector<Token> tokens;
+        for (StaticStringSplitRange::iterator it = range.begin(); it != range.end() && tokens.size() <= 1000; ++it)
+        {
+            Token entry = {(uint32_t)(it->data - data), it->length};
+            tokens.push_back(entry);
+        }
+        return tokens;
+    }
+
+    /**
+     * @brief Text over a few filler letters and the delimiter bytes.
+     *
+     * Delimiters are sprinkled at a random density, then written next to
+     * and across the edges of the first blocks (ending at 63, starting at 63,
+     * 64 and 127), at the start and, twice in a row, at the end.
+     */
+    std::string random_split_text(std::mt19937 &rng, uint32_t length, const std::string &delimiter, bool whole)
+    {
+        std::string text = test_random_text(rng, length, "xyab", 4);
+        uint32_t percent = rng() % 40;
+        for (uint32_t i = 0; i < length; i++)
+        {
+            if (rng() % 100 < percent)
+            {
+                text[i] = delimiter[rng() % delimiter.size()];
+            }
+        }
+        uint32_t width = whole ? (uint32_t)delimiter.size() : 1;
+        const uint32_t edges[] = {64 - width, 63, 64, 127, 0, length - width, length - 2 * width};
+        for (uint32_t e = 0; e < sizeof(edges) / sizeof(edges[0]); e++)
+        {
+            if (rng() % 2 == 0 && edges[e] <= length && width <= length - edges[e])
+            {
+                text.replace(edges[e], width, whole ? delimiter : delimiter.substr(rng() % delimiter.size(), 1));
+            }
+        }
+        return text;
+    }
+
+    void check_char(std::mt19937 &rng, uint32_t length, uint32_t align)
+    {
+        const char delimiters[] = {',', '\0', (char)0x80, 'a'};
+        char delimiter = delimiters[align % 4];
+        std::string text = random_split_text(rng, length, std::string(1, delimiter), false);
+        std::vector<char> buffer(align + length + 64, delimiter);
+        std::copy(text.begin(), text.end(), buffer.begin() + align);
+        StaticStringView view = {buffer.data() + align, length};
+
+        std::vector<Token> expected = reference_split_any(text, std::string(1, delimiter));
+        StaticStringSplit split;
+        TEST_CHECK(sstr_split_init(&split, view, delimiter) == 1, "init");
+        TEST_CHECK(same_tokens(collect(split, view.data), expected), "char 0x%02X: length %u align %u, %u tokens expected",
+                   (uint8_t)delimiter, length, align, (uint32_t)expected.size());
+        StaticStringView token;
+        TEST_CHECK(sstr_split_next(&split, &token) == 0, "char: a token after the last one");
+        TEST_CHECK(same_tokens(collect(sstr_split(view, delimiter), view.data), expected), "char range: length %u align %u", length, align);
+    }
+
+    void check_any(std::mt19937 &rng, uint32_t length, uint32_t align)
+    {
+        // Sets around SSTR_SPLIT_MAX_MASKED_SET, with duplicates and bytes above 0x7F
+        const char *const sets[] = {",", ",;", ",;\t|", ",;\t|:", ",;,;\t", "\x80,\xFF;\x01", ",;\t|: -_/\\\x7F\x80\xC1\xE1\xFF"};
+        std::string set = sets[align % 7];
+        std::string text = random_split_text(rng, length, set, false);
+        std::vector<char> buffer(align + length + 64, set[0]);
+        std::copy(text.begin(), text.end(), buffer.begin() + align);
+        StaticStringView view = {buffer.data() + align, length};
+
+        std::vector<Token> expected = reference_split_any(text, set);
+        StaticStringSplit split;
+        TEST_CHECK(sstr_split_init_any(&split, view, set.c_str()) == 1, "init_any");
+        TEST_CHECK(same_tokens(collect(split, view.data), expected), "any of %u: length %u align %u, %u tokens expected",
+                   (uint32_t)set.size(), length, align, (uint32_t)expected.size());
+        TEST_CHECK(same_tokens(collect(sstr_split_any(view, set.c_str()), view.data), expected), "any range: length %u align %u", length,
+                   align);
+    }
+
+    void check_string(std::mt19937 &rng, uint32_t length, uint32_t align)
+    {
+        // Delimiters that overlap themselves, so matching must skip past a whole match
+        const char *const delimiters[] = {"ab", "aa", "aab", "::", "x\x80y", "abab", "-->"};
+        std::string delimiter = delimiters[align % 7];
+        std::string text = random_split_text(rng, length, delimiter, align % 2 == 0);
+        std::vector<char> buffer(align + length + 64, delimiter[0]);
+        std::copy(text.begin(), text.end(), buffer.begin() + align);
+        StaticStringView view = {buffer.data() + align, length};
+        StaticStringView delimiter_view = {delimiter.data(), (uint32_t)delimiter.size()};
+
+        std::vector<Token> expected = reference_split_string(text, delimiter);
+        StaticStringSplit split;
+        TEST_CHECK(sstr_split_init_string(&split, view, delimiter_view) == 1, "init_string");
+        TEST_CHECK(same_tokens(collect(split, view.data), expected), "string \"%s\": length %u align %u, %u tokens expected",
+                   delimiter.c_str(), length, align, (uint32_t)expected.size());
+        TEST_CHECK(same_tokens(collect(sstr_split(view, delimiter_view), view.data), expected), "string range: length %u align %u", length,
+                   align);
+    }
+
+    void check_lengths(std::mt19937 &rng)
+    {
+        const uint32_t longer[] = {300, 383, 384, 385, 700};
+        std::vector<uint32_t> lengths(kTestLengths, kTestLengths + sizeof(kTestLengths) / sizeof(kTestLengths[0]));
+        lengths.insert(lengths.end(), longer, longer + sizeof(longer) / sizeof(longer[0]));
+        for (size_t l = 0; l < lengths.size(); l++)
+        {
+            for (uint32_t align = 0; align < 64; align++)
+            {
+                check_char(rng, lengths[l], align);
+                check_any(rng, lengths[l], align);
+                check_string(rng, lengths[l], align);
+            }
+        }
+    }
+
+    // Fixed inputs, sstr_split_find on its own, and the arguments the init functions refuse
+    void check_edges()
+    {
+        StaticStringView text = sstr_view_cstr(",a,,b,");
+        StaticStringSplit split;
+        sstr_split_init(&split, text, ',');
+        TEST_CHECK(sstr_split_find(&split) == 0, "find the leading delimiter");
+        split.position = 1;
+        TEST_CHECK(sstr_split_find(&split) == 2, "find from inside the text");
+        split.position = 4;
+        TEST_CHECK(sstr_split_find(&split) == 5, "find after consecutive delimiters");
+        split.position = 6;
+        TEST_CHECK(sstr_split_find(&split) == 6, "find at the end");
+
+        const Token expected[] = {{0, 0}, {1, 1}, {3, 0}, {4, 1}, {6, 0}};
+        TEST_CHECK(same_tokens(collect(sstr_split(text, ','), text.data), std::vector<Token>(expected, expected + 5)), "\",a,,b,\"");
+        StaticStringView empty = sstr_view_cstr("");
+        TEST_CHECK(collect(sstr_split(empty, ','), empty.data).size() == 1, "the empty string is one empty token");
+
+        TEST_CHECK(sstr_split_init(NULL, text, ',') == 0 && sstr_split_init_any(&split, text, "") == 0 &&
+                       sstr_split_init_any(&split, text, NULL) == 0 && sstr_split_init_string(&split, text, empty) == 0,
+                   "refused arguments");
+        TEST_CHECK(collect(sstr_split_any(text, ""), text.data).size() == 1 && collect(sstr_split(text, empty), text.data).size() == 1,
+                   "ranges with an empty delimiter yield the whole input");
+        StaticStringView token;
+        TEST_CHECK(sstr_split_next(NULL, &token) == 0 && sstr_split_next(&split, NULL) == 0, "NULL pointers");
+    }
+}
+
+int main()
+{
+    if (!test_level_supported("split"))
+    {
+        return TEST_SKIPPED;
+    }
+    std::mt19937 rng(10);
+    check_edges();
+    check_lengths(rng);
+    return test_finish("split");
+}
@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "test.h"
+
+/*
+ * sstr_translate against looking every byte up in table.map: tables changing
+ * 1, 8, 9 and 16 rows, on either side of the 8 rows above which the AVX2
+ * kernel hands over to the scalar loop, at every length around the vector
+ * widths and every alignment. Mapped bytes often land in another changed row,
+ * so a byte mapped twice where vectors overlap shows up. Also built with the
+ * level chosen through CPUID, which runs the AVX-512 VBMI kernel on CPUs
+ * that have it.
+ */
+
+namespace
+{
+    // A table whose map differs from the identity in row_count random rows
+    StaticStringTranslation random_table(std::mt19937 &rng, uint32_t row_count)
+    {
+        StaticStringTranslation table;
+        sstr_translation_init(&table);
+        std::vector<uint32_t> rows;
+        for (uint32_t row = 0; row < 16; row++)
+        {
+            rows.push_back(row);
+        }
+        std::shuffle(rows.begin(), rows.end(), rng);
+        for (uint32_t r = 0; r < row_count; r++)
+        {
+            uint32_t first = 16 * rows[r];
+            for (uint32_t c = first; c < first + 16; c++)
+            {
+                table.map[c] = rng() % 3 == 0 ? (uint8_t)(rng() % 256) : (uint8_t)c;
+            }
+            uint32_t changed = first + rng() % 16;
+            table.map[changed] = (uint8_t)(changed ^ (1 + rng() % 255));
+        }
+        sstr_translation_update_rows(&table);
+        return table;
+    }
+
+    // Bytes of the changed rows half of the time, so most vectors need every row lookup
+    std::string random_bytes(std::mt19937 &rng, uint32_t length, const StaticStringTranslation &table)
+    {
+        std::vector<uint8_t> changed;
+        for (uint32_t c = 0; c < 256; c++)
+        {
+            if (table.map[c] != c)
+            {
+                changed.push_back((uint8_t)c);
+            }
+        }
+        std::string text(length, '\0');
+        for (uint32_t i = 0; i < length; i++)
+        {
+            text[i] = (char)(rng() % 2 == 0 && !changed.empty() ? changed[rng() % changed.size()] : rng() % 256);
+        }
+        return text;
+    }
+
+    void check_text(const StaticStringTranslation &table, const std::string &text, uint32_t align, uint32_t rows)
+    {
+        std::string expected = text;
+        uint32_t expected_count = 0;
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            uint8_t c = (uint8_t)expected[i];
+            expected_count += table.map[c] != c;
+            expected[i] = (char)table.map[c];
+        }
+
+        std::vector<char> buffer(align + text.size() + 64, '#');
+        std::copy(text.begin(), text.end(), buffer.begin() + align);
+        char *data = buffer.data() + align;
+        uint32_t length = (uint32_t)text.size();
+        uint32_t count = sstr_core_translate(data, length, &table);
+        TEST_CHECK(count == expected_count && std::equal(expected.begin(), expected.end(), data), "%u rows: length %u align %u", rows,
+                   length, align);
+        TEST_CHECK(std::count(buffer.begin(), buffer.begin() + align, '#') == align &&
+                       std::count(buffer.begin() + align + length, buffer.end(), '#') == 64,
+                   "%u rows: length %u align %u wrote outside the string", rows, length, align);
+    }
+
+    void check_lengths(std::mt19937 &rng)
+    {
+        const uint32_t row_counts[] = {0, 1, 2, 8, 9, 15, 16};
+        for (uint32_t r = 0; r < sizeof(row_counts) / sizeof(row_counts[0]); r++)
+        {
+            uint32_t rows = row_counts[r];
+            for (uint32_t round = 0; round < 4; round++)
+            {
+                StaticStringTranslation table = random_table(rng, rows);
+                TEST_CHECK(sstr_popcount64(table.active_rows) == rows, "%u rows: active_rows 0x%04X", rows, table.active_rows);
+                for (size_t l = 0; l < sizeof(kTestLengths) / sizeof(kTestLengths[0]); l++)
+                {
+                    for (uint32_t align = 0; align < 64; align += 1 + round)
+                    {
+                        check_text(table, random_bytes(rng, kTestLengths[l], table), align, rows);
+                    }
+                }
+            }
+        }
+    }
+
+    // Tables built through the API, the StaticString function, and which kernel the CPUID dispatch picked
+    void check_api(std::mt19937 &rng)
+    {
+        static StaticString sstr;
+        StaticStringTranslation table = sstr_translation_make(",;", "|");
+        sstr_translation_uppercase(&table);
+        sstr_from_cstr(&sstr, "a,b;c|d");
+        TEST_CHECK(sstr_translate(&sstr, &table) == 6 && strcmp(sstr.static_string, "A|B|C|D") == 0, "separators and uppercase");
+        TEST_CHECK(sstr_translate(&sstr, NULL) == 0 && sstr_translate(NULL, &table) == 0, "NULL pointers");
+
+        StaticStringTranslation identity;
+        sstr_translation_init(&identity);
+        TEST_CHECK(sstr_translate(&sstr, &identity) == 0 && strcmp(sstr.static_string, "A|B|C|D") == 0, "identity table");
+
+        // Every byte mapped to its successor: all 16 rows change
+        StaticStringTranslation shift;
+        sstr_translation_init(&shift);
+        for (uint32_t c = 0; c < 256; c++)
+        {
+            shift.map[c] = (uint8_t)(c + 1);
+        }
+        sstr_translation_update_rows(&shift);
+        TEST_CHECK(shift.active_rows == 0xFFFF, "shift table rows 0x%04X", shift.active_rows);
+        for (uint32_t length = 0; length <= 200; length += 1 + length / 8)
+        {
+            check_text(shift, test_random_text(rng, length, "\x7F\x80\xFF\x00z", 5), length % 7, 16);
+        }
+
+#if SSTR_HAS_X86_KERNELS && !defined(SSTR_SIMD_LEVEL)
+        const SStrKernels *kernels = sstr_kernels();
+        if (kernels->level == SSTR_SIMD_AVX512BW && sstr_cpu_has_avx512vbmi())
+        {
+            TEST_CHECK(kernels->translate == sstr_kernel_translate_avx512vbmi, "CPUID dispatch picks the VBMI translate kernel");
+            std::printf("translate: avx512vbmi kernel\n");
+        }
+#endif
+    }
+}
+
+int main()
+{
+    if (!test_level_supported("translate"))
+    {
+        return TEST_SKIPPED;
+    }
+    std::mt19937 rng(24);
+    check_api(rng);
+    check_lengths(rng);
+    return test_finish("translate");
+}